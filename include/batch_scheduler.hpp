@@ -0,0 +1,273 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <opencv2/opencv.hpp>
+#include "inference_backend.hpp"
+#include "latency_histogram.hpp"
+#include "thread_topology.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Batch scheduler configuration
+ */
+struct BatchSchedulerConfig {
+    size_t max_batch_size = 1;      // 1 = no batching (scheduler not created)
+    double max_delay_ms = 2.0;      // Longest a request waits for the batch to fill
+};
+
+/**
+ * @brief Dynamic Batch Scheduler - Header-only implementation
+ *
+ * Collects inference requests from any thread and runs them through the
+ * backend as one batched call, either when max_batch_size requests are
+ * waiting or when the oldest has waited max_delay_ms, whichever comes
+ * first. Each caller gets its own result through a future.
+ *
+ * One dispatcher thread runs the batches; the backend parallelizes inside
+ * a batch. Submitted images must stay valid until their future is ready.
+ *
+ * setBackend() swaps the model between batches: each batch holds its own
+ * reference, so a batch already running finishes on the old model.
+ */
+class BatchScheduler {
+public:
+    BatchScheduler(std::shared_ptr<InferenceBackend> backend, const BatchSchedulerConfig& config)
+        : backend_(std::move(backend)), config_(config), batch_sizes_(std::max<size_t>(1, config.max_batch_size) + 1),
+          logger_("BATCH") {
+        config_.max_batch_size = std::max<size_t>(1, config_.max_batch_size);
+        dispatcher_ = std::thread(&BatchScheduler::dispatchLoop, this);
+        logger_.info("Batch scheduler started (max batch " + std::to_string(config_.max_batch_size) +
+                     ", max delay " + formatMs(config_.max_delay_ms) + ")");
+    }
+
+    ~BatchScheduler() {
+        shutdown();
+    }
+
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    /**
+     * @brief Queue one BGR image; the future throws if the batch fails
+     */
+    std::future<InferenceResult> submit(const cv::Mat& image) {
+        Request request;
+        request.image = image;
+        request.enqueue_time = std::chrono::steady_clock::now();
+        std::future<InferenceResult> result = request.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                throw std::runtime_error("BatchScheduler is shut down");
+            }
+            queue_.push_back(std::move(request));
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Use another backend from the next batch on
+     */
+    void setBackend(std::shared_ptr<InferenceBackend> backend) {
+        std::atomic_store(&backend_, std::move(backend));
+    }
+
+    /**
+     * @brief Run the queued requests and join the dispatcher
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        if (dispatcher_.joinable()) {
+            dispatcher_.join();
+        }
+        logger_.info("Batch scheduler stopped");
+    }
+
+    const BatchSchedulerConfig& getConfig() const {
+        return config_;
+    }
+
+    size_t pendingRequests() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    uint64_t getBatchCount() const { return batches_; }
+    uint64_t getRequestCount() const { return requests_; }
+
+    double getAverageBatchSize() const {
+        uint64_t batches = batches_;
+        return batches ? static_cast<double>(requests_) / batches : 0.0;
+    }
+
+    const LatencyHistogram& getQueueDelay() const { return queue_delay_; }
+    const LatencyHistogram& getBatchLatency() const { return batch_latency_; }
+
+    void resetStats() {
+        batches_ = 0;
+        requests_ = 0;
+        failed_batches_ = 0;
+        for (auto& count : batch_sizes_) {
+            count = 0;
+        }
+        queue_delay_.reset();
+        batch_latency_.reset();
+    }
+
+    /**
+     * @brief Batch size distribution, queue delay and batch run time as a JSON object
+     */
+    std::string getStatsJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(2);
+        json << "{";
+        json << "\"max_batch_size\":" << config_.max_batch_size << ",";
+        json << "\"max_delay_ms\":" << config_.max_delay_ms << ",";
+        json << "\"batches\":" << batches_ << ",";
+        json << "\"requests\":" << requests_ << ",";
+        json << "\"failed_batches\":" << failed_batches_ << ",";
+        json << "\"pending\":" << pendingRequests() << ",";
+        json << "\"batch_size\":{";
+        json << "\"mean\":" << getAverageBatchSize() << ",";
+        json << "\"distribution\":{";
+        bool first = true;
+        for (size_t size = 1; size < batch_sizes_.size(); ++size) {
+            uint64_t count = batch_sizes_[size];
+            if (count == 0) continue;
+            if (!first) json << ",";
+            json << "\"" << size << "\":" << count;
+            first = false;
+        }
+        json << "}";
+        json << "},";
+        json << "\"queue_delay\":" << queue_delay_.toJson() << ",";
+        json << "\"batch_latency\":" << batch_latency_.toJson();
+        json << "}";
+        return json.str();
+    }
+
+private:
+    struct Request {
+        cv::Mat image;
+        std::promise<InferenceResult> promise;
+        std::chrono::steady_clock::time_point enqueue_time;
+    };
+
+    std::shared_ptr<InferenceBackend> backend_;  // Access with std::atomic_load/atomic_store
+    BatchSchedulerConfig config_;
+    std::deque<Request> queue_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_ = false;
+    std::thread dispatcher_;
+
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> failed_batches_{0};
+    std::vector<std::atomic<uint64_t>> batch_sizes_;  // Index = batch size
+    LatencyHistogram queue_delay_;                    // Enqueue to batch start
+    LatencyHistogram batch_latency_;                  // runBatch + decode
+    ModuleLogger logger_;
+
+    void dispatchLoop() {
+        ScopedThreadRole role(ThreadRole::INFERENCE);
+        auto max_delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(std::max(config_.max_delay_ms, 0.0)));
+
+        // Reused across batches
+        std::vector<Request> batch;
+        std::vector<cv::Mat> images;
+        std::vector<cv::Mat> outputs;
+        batch.reserve(config_.max_batch_size);
+        images.reserve(config_.max_batch_size);
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+                if (stopping_ && queue_.empty()) {
+                    return;
+                }
+                // Full batch or the oldest request's deadline, whichever comes first
+                auto deadline = queue_.front().enqueue_time + max_delay;
+                condition_.wait_until(lock, deadline, [this] {
+                    return stopping_ || queue_.size() >= config_.max_batch_size;
+                });
+
+                size_t count = std::min(queue_.size(), config_.max_batch_size);
+                for (size_t i = 0; i < count; ++i) {
+                    batch.push_back(std::move(queue_.front()));
+                    queue_.pop_front();
+                }
+            }
+
+            runBatch(batch, images, outputs);
+            batch.clear();
+            images.clear();
+        }
+    }
+
+    void runBatch(std::vector<Request>& batch, std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto& request : batch) {
+            queue_delay_.record(std::chrono::duration<double, std::milli>(start - request.enqueue_time).count());
+            images.push_back(request.image);
+        }
+
+        bool ok = false;
+        std::vector<InferenceResult> results;
+        std::shared_ptr<InferenceBackend> backend = std::atomic_load(&backend_);
+        try {
+            ok = backend && backend->runBatch(images, outputs);
+            if (ok) {
+                results = backend->decode(outputs, batch.size());
+            }
+        } catch (const std::exception& e) {
+            logger_.error("Batch of " + std::to_string(batch.size()) + " failed: " + e.what());
+            ok = false;
+        }
+        batch_latency_.record(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+        batches_++;
+        requests_ += batch.size();
+        batch_sizes_[std::min(batch.size(), batch_sizes_.size() - 1)]++;
+
+        if (!ok || results.size() != batch.size()) {
+            failed_batches_++;
+            for (auto& request : batch) {
+                request.promise.set_exception(std::make_exception_ptr(std::runtime_error("Batch inference failed")));
+            }
+            return;
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i].promise.set_value(results[i]);
+        }
+    }
+
+    static std::string formatMs(double ms) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << ms << "ms";
+        return out.str();
+    }
+};
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <opencv2/opencv.hpp>
+#include "frame_ring.hpp"
+#include "frame_pool.hpp"
+#include "frame_source.hpp"
+#include "frame_metadata.hpp"
+#include "rate_controller.hpp"
+#include "thread_topology.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Capture configuration
+ */
+struct CaptureConfig {
+    int width = 640;
+    int height = 480;
+    double fps = 30.0;
+    size_t ring_capacity = 4;
+    OverflowPolicy overflow_policy = OverflowPolicy::DROP_OLDEST;
+    int max_consecutive_failures = 100;  // Give up on the device after this many failed reads
+    PacingMode pacing = PacingMode::REAL_TIME;  // File, directory and synthetic sources only
+    bool loop = false;                   // Restart finite sources at the end
+    uint64_t max_frames = 0;             // Stop after this many frames (0 = unlimited)
+    size_t prefetch_depth = 4;           // Image directory read-ahead
+
+    FrameSourceOptions toSourceOptions() const {
+        FrameSourceOptions options;
+        options.width = width;
+        options.height = height;
+        options.fps = fps;
+        options.pacing = pacing;
+        options.loop = loop;
+        options.max_frames = max_frames;
+        options.prefetch_depth = prefetch_depth;
+        return options;
+    }
+};
+
+/**
+ * @brief A pooled frame plus the metadata that travels with it
+ */
+struct CapturedFrame {
+    PooledFrame frame;
+    FrameMetadata metadata;
+};
+
+/**
+ * @brief Capture Thread Class - Header-only implementation
+ *
+ * Owns a FrameSource (camera, file, image directory or synthetic) and
+ * feeds frames into a bounded FrameRing, so capture latency never
+ * serializes with processing or display.
+ * Frames are decoded straight into FramePool buffers, so steady-state
+ * capture does not allocate. Every frame is grabbed, but only frames the
+ * decode policy admits are retrieved (decoded).
+ */
+class CaptureThread {
+public:
+    explicit CaptureThread(const CaptureConfig& config = CaptureConfig())
+        : config_(config), ring_(config.ring_capacity, config.overflow_policy) {}
+
+    ~CaptureThread() {
+        stop();
+    }
+
+    CaptureThread(const CaptureThread&) = delete;
+    CaptureThread& operator=(const CaptureThread&) = delete;
+
+    /**
+     * @brief Set a callback invoked after each frame lands in the ring
+     *
+     * Runs on the capture thread; keep it short (e.g. notify a condition variable).
+     */
+    void setFrameCallback(std::function<void()> callback) {
+        frame_callback_ = std::move(callback);
+    }
+
+    /**
+     * @brief Set the skip policy applied before decoding (call before start)
+     *
+     * Frames it rejects are grabbed, keeping the driver queue drained, but
+     * never decoded. The age budget is ignored here; frames are fresh at grab.
+     */
+    void setDecodePolicy(const RateControlConfig& policy) {
+        RateControlConfig decode_policy = policy;
+        decode_policy.max_frame_age_ms = 0;
+        decode_controller_ = RateController(decode_policy);
+    }
+
+    /**
+     * @brief Open a camera device and start the capture thread
+     */
+    bool start(int camera_id) {
+        return start("camera:" + std::to_string(camera_id));
+    }
+
+    /**
+     * @brief Open a frame source by URI and start the capture thread
+     *
+     * See FrameSource::create for the URI forms.
+     */
+    bool start(const std::string& source_uri) {
+        if (running_) {
+            logger_.warn("Capture thread is already running");
+            return true;
+        }
+
+        std::unique_ptr<FrameSource> source = FrameSource::create(source_uri, config_.toSourceOptions());
+        if (!source) {
+            logger_.error("Invalid frame source: " + source_uri);
+            return false;
+        }
+        return start(std::move(source));
+    }
+
+    /**
+     * @brief Open a caller-built frame source and start the capture thread
+     */
+    bool start(std::unique_ptr<FrameSource> source) {
+        if (running_) {
+            logger_.warn("Capture thread is already running");
+            return true;
+        }
+        if (!source) {
+            return false;
+        }
+
+        source_ = std::move(source);
+        if (!source_->open()) {
+            logger_.error("Failed to open frame source " + source_->describe());
+            source_.reset();
+            return false;
+        }
+
+        logger_.debug("Frame source opened successfully: " + source_->describe());
+
+        cv::Size frame_size = source_->getFrameSize();
+        actual_width_ = frame_size.width;
+        actual_height_ = frame_size.height;
+        actual_fps_ = source_->getNativeFps();
+
+        logger_.info("Source properties - Resolution: " +
+                     std::to_string(actual_width_) + "x" + std::to_string(actual_height_) +
+                     ", FPS: " + std::to_string(actual_fps_) +
+                     (source_->isLive() ? "" : ", pacing: " + pacingModeToString(config_.pacing)));
+
+        // Enough buffers for a full ring, the frame being captured and the frames held downstream
+        pool_ = std::make_unique<FramePool>(frame_size, CV_8UC3, ring_.capacity() + POOL_HEADROOM);
+
+        ring_.reset();
+        decode_controller_.reset();
+        running_ = true;
+        thread_ = std::thread(&CaptureThread::captureLoop, this);
+
+        logger_.info("Capture thread started (ring capacity: " + std::to_string(ring_.capacity()) +
+                     ", overflow policy: " + overflowPolicyToString(ring_.getPolicy()) + ")");
+        return true;
+    }
+
+    /**
+     * @brief Stop the capture thread and release the source
+     */
+    void stop() {
+        running_ = false;
+        ring_.close(); // Wakes a producer blocked on a full ring
+
+        if (thread_.joinable()) {
+            thread_.join();
+            logger_.info("Capture thread stopped (captured: " + std::to_string(captured_frames_) +
+                         ", dropped: " + std::to_string(ring_.getDroppedCount()) +
+                         ", failed reads: " + std::to_string(failed_reads_) + ")");
+        }
+
+        if (source_) {
+            source_->close();
+        }
+    }
+
+    /**
+     * @brief Get the freshest captured frame, waiting up to timeout if none is queued
+     *
+     * Closes the frame's "queue" stage.
+     */
+    bool getLatestFrame(CapturedFrame& captured, std::chrono::milliseconds timeout) {
+        if (!ring_.popLatest(captured, timeout)) {
+            return false;
+        }
+        captured.metadata.leaveStage("queue");
+        return true;
+    }
+
+    /**
+     * @brief Get the oldest captured frame, waiting up to timeout if none is queued
+     *
+     * For consumers that must see every frame (benchmarks, offline files).
+     * Closes the frame's "queue" stage.
+     */
+    bool getNextFrame(CapturedFrame& captured, std::chrono::milliseconds timeout) {
+        if (!ring_.pop(captured, timeout)) {
+            return false;
+        }
+        captured.metadata.leaveStage("queue");
+        return true;
+    }
+
+    /**
+     * @brief True while the capture thread is producing frames
+     */
+    bool isRunning() const {
+        return running_;
+    }
+
+    /**
+     * @brief True once capture has ended and every queued frame was consumed
+     */
+    bool isFinished() const {
+        return ring_.isFinished();
+    }
+
+    const FrameRing<CapturedFrame>& getRing() const { return ring_; }
+    int getWidth() const { return actual_width_; }
+    int getHeight() const { return actual_height_; }
+    double getFps() const { return actual_fps_; }
+    uint64_t getCapturedFrames() const { return captured_frames_; }
+    uint64_t getGrabbedFrames() const { return grabbed_frames_; }
+    uint64_t getSkippedFrames() const { return skipped_frames_; }
+    uint64_t getFailedReads() const { return failed_reads_; }
+
+    /**
+     * @brief Source description, e.g. "camera:0" (empty until started)
+     */
+    std::string getSourceDescription() const {
+        return source_ ? source_->describe() : "";
+    }
+
+    /**
+     * @brief Frame pool statistics (empty until the source is started)
+     */
+    FramePoolStats getPoolStats() const {
+        return pool_ ? pool_->getStats() : FramePoolStats();
+    }
+
+private:
+    static constexpr size_t POOL_HEADROOM = 3;
+
+    CaptureConfig config_;
+    std::unique_ptr<FrameSource> source_;
+    std::unique_ptr<FramePool> pool_;
+    FrameRing<CapturedFrame> ring_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    int actual_width_ = 0;
+    int actual_height_ = 0;
+    double actual_fps_ = 0.0;
+    std::atomic<uint64_t> captured_frames_{0};   // Grabbed and decoded
+    std::atomic<uint64_t> grabbed_frames_{0};
+    std::atomic<uint64_t> skipped_frames_{0};    // Grabbed but never decoded
+    RateController decode_controller_;
+    std::atomic<uint64_t> failed_reads_{0};
+    uint64_t next_sequence_ = 1;
+    std::function<void()> frame_callback_;
+
+    ModuleLogger logger_{"CAPTURE"};
+
+    /**
+     * @brief Count a failed grab or decode; false once the source should be given up
+     */
+    bool handleFailedRead(int& consecutive_failures) {
+        failed_reads_++;
+        if (++consecutive_failures >= config_.max_consecutive_failures) {
+            logger_.error("Source stopped delivering frames after " +
+                          std::to_string(consecutive_failures) + " failed reads");
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return true;
+    }
+
+    void captureLoop() {
+        ScopedThreadRole role(ThreadRole::CAPTURE);
+        logger_.debug("Capture loop started");
+        int consecutive_failures = 0;
+
+        while (running_) {
+            // Grab every frame so the driver queue stays drained
+            auto grab_start = FrameMetadata::Clock::now();
+            if (!source_->grab()) {
+                if (source_->isExhausted()) {
+                    logger_.info("Frame source " + source_->describe() + " reached its end after " +
+                                 std::to_string(source_->getFramesGrabbed()) + " frames");
+                    break;
+                }
+                if (!handleFailedRead(consecutive_failures)) {
+                    break;
+                }
+                continue;
+            }
+
+            // Capture timestamp is when the frame arrived; the "capture" stage
+            // covers the driver wait and the decode
+            CapturedFrame captured;
+            captured.metadata.sequence = next_sequence_++;
+            captured.metadata.capture_time = FrameMetadata::Clock::now();
+            grabbed_frames_++;
+            consecutive_failures = 0;
+
+            // Decode only what the skip policy will let through to processing
+            if (decode_controller_.admit(captured.metadata, captured.metadata.capture_time) !=
+                RateController::Decision::ADMIT) {
+                skipped_frames_++;
+                continue;
+            }
+
+            // Recycled buffer per frame: the consumer may still hold the previous one
+            captured.frame = pool_->acquire();
+            if (!source_->retrieve(captured.frame.mat()) || captured.frame.empty()) {
+                if (!handleFailedRead(consecutive_failures)) {
+                    break;
+                }
+                continue;
+            }
+
+            if (!captured.frame.isPooled()) {
+                // The source delivers a different geometry than it reported; follow it
+                const cv::Mat& mat = captured.frame.mat();
+                logger_.warn("Frame geometry differs from pool, resizing pool to " +
+                             std::to_string(mat.cols) + "x" + std::to_string(mat.rows));
+                pool_->reconfigure(cv::Size(mat.cols, mat.rows), mat.type());
+            }
+
+            auto decoded_time = FrameMetadata::Clock::now();
+            captured.metadata.enterStage("capture", grab_start);
+            captured.metadata.leaveStage("capture", decoded_time);
+            captured.metadata.enterStage("queue", decoded_time);
+
+            captured_frames_++;
+            if (ring_.push(std::move(captured)) && frame_callback_) {
+                frame_callback_();
+            }
+        }
+
+        running_ = false;
+        ring_.close(); // Lets the consumer drain what is left and then see end of stream
+        if (frame_callback_) {
+            frame_callback_(); // Wake the consumer so it notices end of stream
+        }
+        logger_.debug("Capture loop ended");
+    }
+};
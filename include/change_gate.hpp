@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+
+/**
+ * @brief Change gate configuration
+ */
+struct ChangeGateConfig {
+    bool enabled = false;
+    double threshold = 2.0;          // Mean absolute luma difference (0-255) below which a frame counts as unchanged
+    int analysis_width = 160;        // Width of the downsampled luma plane (height keeps aspect ratio)
+    uint32_t max_reuse_frames = 30;  // Force a full pass after this many reused results (0 = never)
+};
+
+/**
+ * @brief Change gate statistics snapshot
+ */
+struct ChangeGateStats {
+    uint64_t evaluated = 0;
+    uint64_t processed = 0;
+    uint64_t reused = 0;
+    double last_score = 0.0;
+
+    double skipRatio() const {
+        return evaluated ? static_cast<double>(reused) / evaluated : 0.0;
+    }
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        json << "\"evaluated\":" << evaluated << ",";
+        json << "\"processed\":" << processed << ",";
+        json << "\"reused\":" << reused << ",";
+        json << "\"skip_ratio\":" << skipRatio() << ",";
+        json << "\"last_score\":" << last_score;
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Change Gate Class - Header-only implementation
+ *
+ * Cheap static-scene detector run before inference. The frame is reduced
+ * to a small luma plane and compared with the plane of the last frame that
+ * was fully processed, using a sum of absolute differences (cv::norm with
+ * NORM_L1, which OpenCV vectorizes). Below the threshold, the caller reuses
+ * its previous result. The reference only moves on processed frames, so
+ * slow drift still accumulates until it crosses the threshold.
+ *
+ * One gate per stream; shouldProcess() is not reentrant.
+ */
+class ChangeGate {
+public:
+    explicit ChangeGate(const ChangeGateConfig& config = ChangeGateConfig()) : config_(config) {}
+
+    ChangeGate(const ChangeGate&) = delete;
+    ChangeGate& operator=(const ChangeGate&) = delete;
+
+    /**
+     * @brief Decide whether a BGR frame needs a full pass
+     *
+     * @return true to run inference, false to reuse the last result
+     */
+    bool shouldProcess(const cv::Mat& frame) {
+        if (!config_.enabled || frame.empty()) {
+            return true;
+        }
+
+        // Area-downsample first, then convert: both steps touch only the small plane after the first
+        int width = std::min(config_.analysis_width > 0 ? config_.analysis_width : 160, frame.cols);
+        int height = std::max(1, frame.rows * width / frame.cols);
+        cv::resize(frame, small_, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+        if (small_.channels() == 3) {
+            cv::cvtColor(small_, luma_, cv::COLOR_BGR2GRAY);
+        } else {
+            small_.copyTo(luma_);
+        }
+
+        evaluated_++;
+        bool process = true;
+        if (!reference_.empty() && reference_.size() == luma_.size()) {
+            double score = cv::norm(luma_, reference_, cv::NORM_L1) / static_cast<double>(luma_.total());
+            last_score_.store(score, std::memory_order_relaxed);
+            bool forced = config_.max_reuse_frames > 0 && consecutive_reuse_ >= config_.max_reuse_frames;
+            process = score >= config_.threshold || forced;
+        }
+
+        if (process) {
+            cv::swap(reference_, luma_); // luma_ storage is reused on the next call
+            consecutive_reuse_ = 0;
+            processed_++;
+        } else {
+            consecutive_reuse_++;
+            reused_++;
+        }
+        return process;
+    }
+
+    /**
+     * @brief Forget the reference so the next frame is always processed
+     */
+    void invalidate() {
+        reference_.release();
+        consecutive_reuse_ = 0;
+    }
+
+    const ChangeGateConfig& getConfig() const {
+        return config_;
+    }
+
+    ChangeGateStats getStats() const {
+        ChangeGateStats stats;
+        stats.evaluated = evaluated_;
+        stats.processed = processed_;
+        stats.reused = reused_;
+        stats.last_score = last_score_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void resetStats() {
+        evaluated_ = 0;
+        processed_ = 0;
+        reused_ = 0;
+    }
+
+private:
+    ChangeGateConfig config_;
+    cv::Mat small_, luma_, reference_;
+    uint32_t consecutive_reuse_ = 0;
+
+    std::atomic<uint64_t> evaluated_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> reused_{0};
+    std::atomic<double> last_score_{0.0};
+};
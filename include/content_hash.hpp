@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include "mapped_file.hpp"
+
+/**
+ * @brief 128-bit content hash
+ */
+struct Hash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128& other) const {
+        return low == other.low && high == other.high;
+    }
+
+    /**
+     * @brief 32 lowercase hex digits, high half first
+     */
+    std::string toHex() const {
+        char text[33];
+        std::snprintf(text, sizeof(text), "%016llx%016llx", static_cast<unsigned long long>(high),
+                      static_cast<unsigned long long>(low));
+        return text;
+    }
+};
+
+/**
+ * @brief MurmurHash3 x64 128-bit (non-cryptographic, about 5 GB/s per core)
+ */
+inline Hash128 hash128(const void* key, size_t length, uint64_t seed = 0) {
+    auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    auto fmix = [](uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    };
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    const uint8_t* data = static_cast<const uint8_t*>(key);
+    const size_t blocks = length / 16;
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    for (size_t i = 0; i < blocks; ++i) {
+        uint64_t k1, k2;
+        std::memcpy(&k1, data + i * 16, 8);   // Unaligned-safe; compiles to plain loads
+        std::memcpy(&k2, data + i * 16 + 8, 8);
+
+        k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = rotl(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+        k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = rotl(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const uint8_t* tail = data + blocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    switch (length & 15) {
+        case 15: k2 ^= static_cast<uint64_t>(tail[14]) << 48; // fallthrough
+        case 14: k2 ^= static_cast<uint64_t>(tail[13]) << 40; // fallthrough
+        case 13: k2 ^= static_cast<uint64_t>(tail[12]) << 32; // fallthrough
+        case 12: k2 ^= static_cast<uint64_t>(tail[11]) << 24; // fallthrough
+        case 11: k2 ^= static_cast<uint64_t>(tail[10]) << 16; // fallthrough
+        case 10: k2 ^= static_cast<uint64_t>(tail[9]) << 8;   // fallthrough
+        case 9:  k2 ^= static_cast<uint64_t>(tail[8]);
+                 k2 *= c2; k2 = rotl(k2, 33); k2 *= c1; h2 ^= k2; // fallthrough
+        case 8:  k1 ^= static_cast<uint64_t>(tail[7]) << 56; // fallthrough
+        case 7:  k1 ^= static_cast<uint64_t>(tail[6]) << 48; // fallthrough
+        case 6:  k1 ^= static_cast<uint64_t>(tail[5]) << 40; // fallthrough
+        case 5:  k1 ^= static_cast<uint64_t>(tail[4]) << 32; // fallthrough
+        case 4:  k1 ^= static_cast<uint64_t>(tail[3]) << 24; // fallthrough
+        case 3:  k1 ^= static_cast<uint64_t>(tail[2]) << 16; // fallthrough
+        case 2:  k1 ^= static_cast<uint64_t>(tail[1]) << 8;  // fallthrough
+        case 1:  k1 ^= static_cast<uint64_t>(tail[0]);
+                 k1 *= c1; k1 = rotl(k1, 31); k1 *= c2; h1 ^= k1;
+                 break;
+        default: break;
+    }
+
+    h1 ^= length;
+    h2 ^= length;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix(h1);
+    h2 = fmix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    Hash128 result;
+    result.low = h1;
+    result.high = h2;
+    return result;
+}
+
+/**
+ * @brief Hash of a whole file, read through a shared mapping
+ */
+inline bool hashFile(const std::string& path, Hash128& hash) {
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    hash = hash128(file.data(), file.size());
+    return true;
+}
@@ -0,0 +1,553 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <bitset>
+#include <string>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "simd_dispatch.hpp"
+#include "letterbox.hpp"
+#include "model_pipeline.hpp"
+
+/**
+ * @brief Detector postprocessing configuration
+ */
+struct PostprocessConfig {
+    float score_threshold = 0.25f;
+    float nms_iou = 0.45f;
+    size_t pre_nms_top_k = 4096;        // Best candidates kept for NMS (0 = all above the threshold)
+    size_t max_detections = 300;
+    bool class_aware = true;            // false = boxes of different classes suppress each other too
+    cv::Size input_size{640, 640};      // Network input the raw box coordinates refer to
+};
+
+/**
+ * @brief Candidate boxes as structure of arrays, corners in image coordinates
+ */
+struct DetectionBoxes {
+    std::vector<float> x1, y1, x2, y2, area, score;
+    std::vector<int32_t> class_id;
+
+    size_t size() const {
+        return score.size();
+    }
+
+    void clear() {
+        x1.clear(); y1.clear(); x2.clear(); y2.clear(); area.clear(); score.clear(); class_id.clear();
+    }
+
+    void reserve(size_t count) {
+        x1.reserve(count); y1.reserve(count); x2.reserve(count); y2.reserve(count);
+        area.reserve(count); score.reserve(count); class_id.reserve(count);
+    }
+
+    void push(float left, float top, float right, float bottom, float box_score, int32_t box_class) {
+        x1.push_back(left);
+        y1.push_back(top);
+        x2.push_back(right);
+        y2.push_back(bottom);
+        area.push_back(std::max(0.0f, right - left) * std::max(0.0f, bottom - top));
+        score.push_back(box_score);
+        class_id.push_back(box_class);
+    }
+};
+
+/**
+ * @brief Detection Decoder and NMS - Header-only implementation
+ *
+ * Turns raw detector output into final boxes in four stages, each sized
+ * for thousands of candidates per frame:
+ *
+ * 1. bestClass(): per candidate, the best class score and its index. The
+ *    scores are class-major (one contiguous row per class), so this is a
+ *    running vector max over rows, done in L1-sized column blocks.
+ * 2. compactAbove(): indices of candidates above the score threshold,
+ *    compacted with a shuffle table (AVX2), compress-store (AVX-512) or a
+ *    branchless store (NEON, scalar).
+ * 3. selectTopK(): nth_element + sort of the k best only, instead of
+ *    sorting every survivor.
+ * 4. nms(): greedy NMS over DetectionBoxes (structure of arrays). Each
+ *    kept box tests all later boxes a vector at a time, with IoU > t
+ *    evaluated as inter > t * union (no division). Class-aware NMS first
+ *    regroups the boxes by class (score order kept within a class), so
+ *    each class is a contiguous range and the quadratic loop never looks
+ *    at boxes of other classes.
+ *
+ * SIMD paths are picked at run time like FusedPreprocessor's. Scratch
+ * buffers are members and only grow, so a steady stream of frames does
+ * not allocate. Not thread-safe: one instance per thread (yoloDecoder()
+ * keeps one per calling thread).
+ */
+class DetectionPostprocessor {
+public:
+    DetectionPostprocessor() {
+        setPath(bestSimdPath());
+    }
+
+    /**
+     * @brief Force a path (benchmarks, tests); false if this CPU cannot run it
+     */
+    bool setPath(SimdPath path) {
+        if (!isSimdPathAvailable(path)) {
+            return false;
+        }
+        path_ = path;
+        return true;
+    }
+
+    SimdPath getPath() const {
+        return path_;
+    }
+
+    /**
+     * @brief Best score and class per candidate from class-major scores (classes rows x count)
+     */
+    void bestClass(const float* class_scores, size_t classes, size_t count, float* best, int32_t* best_class) const {
+        if (classes == 0) {
+            std::fill(best, best + count, 0.0f);
+            std::fill(best_class, best_class + count, -1);
+            return;
+        }
+        // Column blocks keep best/best_class in L1 while all class rows stream past
+        const size_t block = 512;
+        for (size_t begin = 0; begin < count; begin += block) {
+            size_t n = std::min(block, count - begin);
+            std::copy(class_scores + begin, class_scores + begin + n, best + begin);
+            std::fill(best_class + begin, best_class + begin + n, 0);
+            for (size_t c = 1; c < classes; ++c) {
+                const float* row = class_scores + c * count + begin;
+                switch (path_) {
+#if defined(SIMD_DISPATCH_X86)
+                    case SimdPath::AVX2:
+                        maxRowAvx2(row, static_cast<int32_t>(c), best + begin, best_class + begin, n);
+                        break;
+                    case SimdPath::AVX512:
+                        maxRowAvx512(row, static_cast<int32_t>(c), best + begin, best_class + begin, n);
+                        break;
+#elif defined(SIMD_DISPATCH_NEON)
+                    case SimdPath::NEON:
+                        maxRowNeon(row, static_cast<int32_t>(c), best + begin, best_class + begin, n);
+                        break;
+#endif
+                    default:
+                        maxRowScalar(row, static_cast<int32_t>(c), best + begin, best_class + begin, n);
+                        break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Write the indices of scores > threshold to indices (room for count), return how many
+     */
+    size_t compactAbove(const float* scores, size_t count, float threshold, uint32_t* indices) const {
+        switch (path_) {
+#if defined(SIMD_DISPATCH_X86)
+            case SimdPath::AVX2: return compactAvx2(scores, count, threshold, indices);
+            case SimdPath::AVX512: return compactAvx512(scores, count, threshold, indices);
+#elif defined(SIMD_DISPATCH_NEON)
+            case SimdPath::NEON: return compactNeon(scores, count, threshold, indices);
+#endif
+            default: return compactScalar(scores, count, threshold, indices, 0, 0);
+        }
+    }
+
+    /**
+     * @brief Keep the k best indices (k = 0: all), ordered by score then index
+     */
+    static void selectTopK(std::vector<uint32_t>& indices, const float* scores, size_t k) {
+        auto better = [scores](uint32_t a, uint32_t b) {
+            return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+        };
+        if (k > 0 && indices.size() > k) {
+            std::nth_element(indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(k), indices.end(), better);
+            indices.resize(k);
+        }
+        std::sort(indices.begin(), indices.end(), better);
+    }
+
+    /**
+     * @brief Greedy NMS over boxes already ordered by descending score
+     *
+     * keep receives positions in boxes, best first, at most max_detections.
+     */
+    void nms(const DetectionBoxes& boxes, float iou_threshold, size_t max_detections, bool class_aware,
+             std::vector<uint32_t>& keep) {
+        const size_t n = boxes.size();
+        keep.clear();
+        removed_.assign(n, 0);
+        if (!class_aware) {
+            greedy(boxes, 0, n, iou_threshold, max_detections, keep);
+            return;
+        }
+
+        // Regroup by class; the position in the low bits keeps score order inside a class
+        group_keys_.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            group_keys_[i] = (static_cast<uint64_t>(static_cast<uint32_t>(boxes.class_id[i])) << 32) | i;
+        }
+        std::sort(group_keys_.begin(), group_keys_.end());
+        grouped_.clear();
+        grouped_.reserve(n);
+        for (uint64_t key : group_keys_) {
+            size_t i = static_cast<uint32_t>(key);
+            grouped_.push(boxes.x1[i], boxes.y1[i], boxes.x2[i], boxes.y2[i], boxes.score[i], boxes.class_id[i]);
+        }
+
+        for (size_t begin = 0; begin < n;) {
+            size_t end = begin + 1;
+            while (end < n && grouped_.class_id[end] == grouped_.class_id[begin]) {
+                ++end;
+            }
+            // No class contributes more than max_detections to the final list
+            size_t first = grouped_keep_.size();
+            greedy(grouped_, begin, end, iou_threshold, max_detections, grouped_keep_);
+            for (size_t k = first; k < grouped_keep_.size(); ++k) {
+                keep.push_back(static_cast<uint32_t>(group_keys_[grouped_keep_[k]]));
+            }
+            begin = end;
+        }
+        grouped_keep_.clear();
+        std::sort(keep.begin(), keep.end());
+        if (keep.size() > max_detections) {
+            keep.resize(max_detections);
+        }
+    }
+
+    /**
+     * @brief Decode one image of a YOLOv8-style output [batch, 4 + classes, candidates]
+     *
+     * Rows 0-3 are cx, cy, w, h in network input pixels, the remaining rows
+     * class scores. The input was image_size stretched to config.input_size;
+     * boxes are scaled back and clipped.
+     */
+    bool decodeYolo(const cv::Mat& output, size_t index, const PostprocessConfig& config, const cv::Size& image_size,
+                    std::vector<PipelineRegion>& detections) {
+        return decodeYolo(output, index, config, LetterboxTransform::stretch(image_size, config.input_size), detections);
+    }
+
+    /**
+     * @brief Decode with the transform the input tensor was written with (letterboxed or not)
+     *
+     * Boxes are mapped back to the transform's source frame and clipped to
+     * it; config.input_size is not used.
+     */
+    bool decodeYolo(const cv::Mat& output, size_t index, const PostprocessConfig& config,
+                    const LetterboxTransform& transform, std::vector<PipelineRegion>& detections) {
+        detections.clear();
+        if (output.dims != 3 || output.type() != CV_32F || !output.isContinuous() || output.size[1] < 5 ||
+            index >= static_cast<size_t>(output.size[0]) || !transform.valid()) {
+            return false;
+        }
+        const size_t rows = static_cast<size_t>(output.size[1]);
+        const size_t count = static_cast<size_t>(output.size[2]);
+        const float* data = output.ptr<float>() + index * rows * count;
+
+        best_.resize(count);
+        best_class_.resize(count);
+        bestClass(data + 4 * count, rows - 4, count, best_.data(), best_class_.data());
+        indices_.resize(count);
+        indices_.resize(compactAbove(best_.data(), count, config.score_threshold, indices_.data()));
+        selectTopK(indices_, best_.data(), config.pre_nms_top_k);
+
+        // NMS runs in frame coordinates, so letterboxed and stretched inputs suppress alike
+        boxes_.clear();
+        boxes_.reserve(indices_.size());
+        for (uint32_t i : indices_) {
+            float half_w = data[2 * count + i] * 0.5f;
+            float half_h = data[3 * count + i] * 0.5f;
+            cv::Point2f top_left = transform.toSource(cv::Point2f(data[i] - half_w, data[count + i] - half_h));
+            cv::Point2f bottom_right = transform.toSource(cv::Point2f(data[i] + half_w, data[count + i] + half_h));
+            boxes_.push(top_left.x, top_left.y, bottom_right.x, bottom_right.y, best_[i], best_class_[i]);
+        }
+        nms(boxes_, config.nms_iou, config.max_detections, config.class_aware, keep_);
+
+        const cv::Rect frame(cv::Point(), transform.source);
+        detections.reserve(keep_.size());
+        for (uint32_t k : keep_) {
+            PipelineRegion region;
+            region.box = cv::Rect(cv::Point(cvRound(boxes_.x1[k]), cvRound(boxes_.y1[k])),
+                                  cv::Point(cvRound(boxes_.x2[k]), cvRound(boxes_.y2[k]))) & frame;
+            region.class_id = boxes_.class_id[k];
+            region.score = boxes_.score[k];
+            if (!region.box.empty()) {
+                detections.push_back(region);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Pipeline decoder for YOLOv8-style detectors (first output, one batch slot per image)
+     */
+    static RegionDecoder yoloDecoder(const PostprocessConfig& config) {
+        return [config](const std::vector<cv::Mat>& outputs, size_t index, const cv::Size& image_size) {
+            thread_local DetectionPostprocessor postprocessor;
+            std::vector<PipelineRegion> regions;
+            if (!outputs.empty()) {
+                postprocessor.decodeYolo(outputs[0], index, config, image_size, regions);
+            }
+            return regions;
+        };
+    }
+
+private:
+    SimdPath path_ = SimdPath::SCALAR;
+    std::vector<float> best_;
+    std::vector<int32_t> best_class_;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> keep_;
+    std::vector<int32_t> removed_;   // int32 so the vector paths can OR masks in place
+    DetectionBoxes boxes_;
+    std::vector<uint64_t> group_keys_;
+    DetectionBoxes grouped_;
+    std::vector<uint32_t> grouped_keep_;
+
+    /**
+     * @brief Greedy NMS within boxes[begin, end), appending kept positions (at most limit)
+     */
+    void greedy(const DetectionBoxes& boxes, size_t begin, size_t end, float iou_threshold, size_t limit,
+                std::vector<uint32_t>& keep) {
+        size_t kept = 0;
+        for (size_t i = begin; i < end && kept < limit; ++i) {
+            if (removed_[i]) {
+                continue;
+            }
+            keep.push_back(static_cast<uint32_t>(i));
+            kept++;
+            switch (path_) {
+#if defined(SIMD_DISPATCH_X86)
+                case SimdPath::AVX2: suppressAvx2(boxes, i, end, iou_threshold); break;
+                case SimdPath::AVX512: suppressAvx512(boxes, i, end, iou_threshold); break;
+#elif defined(SIMD_DISPATCH_NEON)
+                case SimdPath::NEON: suppressNeon(boxes, i, end, iou_threshold); break;
+#endif
+                default: suppressScalar(boxes, i, i + 1, end, iou_threshold); break;
+            }
+        }
+    }
+
+    static void maxRowScalar(const float* row, int32_t c, float* best, int32_t* best_class, size_t n) {
+        for (size_t x = 0; x < n; ++x) {
+            if (row[x] > best[x]) {
+                best[x] = row[x];
+                best_class[x] = c;
+            }
+        }
+    }
+
+    static size_t compactScalar(const float* scores, size_t count, float threshold, uint32_t* indices,
+                                size_t from, size_t written) {
+        for (size_t i = from; i < count; ++i) {
+            indices[written] = static_cast<uint32_t>(i);
+            written += scores[i] > threshold ? 1 : 0;
+        }
+        return written;
+    }
+
+    // Marks boxes in [from, end) that overlap box i
+    void suppressScalar(const DetectionBoxes& boxes, size_t i, size_t from, size_t end, float iou_threshold) {
+        for (size_t j = from; j < end; ++j) {
+            float w = std::max(0.0f, std::min(boxes.x2[i], boxes.x2[j]) - std::max(boxes.x1[i], boxes.x1[j]));
+            float h = std::max(0.0f, std::min(boxes.y2[i], boxes.y2[j]) - std::max(boxes.y1[i], boxes.y1[j]));
+            float inter = w * h;
+            if (inter > iou_threshold * (boxes.area[i] + boxes.area[j] - inter)) {
+                removed_[j] = -1;
+            }
+        }
+    }
+
+#if defined(SIMD_DISPATCH_X86)
+    SIMD_TARGET("avx2,fma")
+    static void maxRowAvx2(const float* row, int32_t c, float* best, int32_t* best_class, size_t n) {
+        const __m256i vc = _mm256_set1_epi32(c);
+        size_t x = 0;
+        for (; x + 8 <= n; x += 8) {
+            __m256 v = _mm256_loadu_ps(row + x);
+            __m256 b = _mm256_loadu_ps(best + x);
+            __m256 greater = _mm256_cmp_ps(v, b, _CMP_GT_OQ);
+            _mm256_storeu_ps(best + x, _mm256_blendv_ps(b, v, greater));
+            __m256i cls = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(best_class + x));
+            cls = _mm256_blendv_epi8(cls, vc, _mm256_castps_si256(greater));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(best_class + x), cls);
+        }
+        maxRowScalar(row + x, c, best + x, best_class + x, n - x);
+    }
+
+    /**
+     * @brief For each 8-bit mask, the lanes to move to the front (3 bits each) and how many
+     */
+    static const std::array<uint32_t, 256>& compactTable() {
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> entries{};
+            for (uint32_t mask = 0; mask < 256; ++mask) {
+                uint32_t packed = 0, lanes = 0;
+                for (uint32_t lane = 0; lane < 8; ++lane) {
+                    if (mask & (1u << lane)) {
+                        packed |= lane << (3 * lanes++);
+                    }
+                }
+                entries[mask] = packed | (lanes << 24);
+            }
+            return entries;
+        }();
+        return table;
+    }
+
+    SIMD_TARGET("avx2,fma")
+    static size_t compactAvx2(const float* scores, size_t count, float threshold, uint32_t* indices) {
+        const std::array<uint32_t, 256>& table = compactTable();
+        const __m256 vthreshold = _mm256_set1_ps(threshold);
+        const __m256i lane_shifts = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        const __m256i lane_mask = _mm256_set1_epi32(7);
+        size_t written = 0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(scores + i), vthreshold, _CMP_GT_OQ));
+            if (mask == 0) {
+                continue;
+            }
+            uint32_t entry = table[static_cast<size_t>(mask)];
+            __m256i lanes = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(entry)), lane_shifts), lane_mask);
+            __m256i values = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), lanes);
+            // Writes 8 lanes; written <= i keeps them inside indices[0, count)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices + written), values);
+            written += entry >> 24;
+        }
+        return compactScalar(scores, count, threshold, indices, i, written);
+    }
+
+    SIMD_TARGET("avx2,fma")
+    void suppressAvx2(const DetectionBoxes& boxes, size_t i, size_t end, float iou_threshold) {
+        const __m256 bx1 = _mm256_set1_ps(boxes.x1[i]), by1 = _mm256_set1_ps(boxes.y1[i]);
+        const __m256 bx2 = _mm256_set1_ps(boxes.x2[i]), by2 = _mm256_set1_ps(boxes.y2[i]);
+        const __m256 barea = _mm256_set1_ps(boxes.area[i]), threshold = _mm256_set1_ps(iou_threshold);
+        const __m256 zero = _mm256_setzero_ps();
+        size_t j = i + 1;
+        for (; j + 8 <= end; j += 8) {
+            __m256 w = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(bx2, _mm256_loadu_ps(&boxes.x2[j])),
+                                                         _mm256_max_ps(bx1, _mm256_loadu_ps(&boxes.x1[j]))));
+            __m256 h = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(by2, _mm256_loadu_ps(&boxes.y2[j])),
+                                                         _mm256_max_ps(by1, _mm256_loadu_ps(&boxes.y1[j]))));
+            __m256 inter = _mm256_mul_ps(w, h);
+            __m256 uni = _mm256_sub_ps(_mm256_add_ps(barea, _mm256_loadu_ps(&boxes.area[j])), inter);
+            __m256i overlaps = _mm256_castps_si256(_mm256_cmp_ps(inter, _mm256_mul_ps(threshold, uni), _CMP_GT_OQ));
+            __m256i* removed = reinterpret_cast<__m256i*>(&removed_[j]);
+            _mm256_storeu_si256(removed, _mm256_or_si256(_mm256_loadu_si256(removed), overlaps));
+        }
+        suppressScalar(boxes, i, j, end, iou_threshold);
+    }
+
+// GCC's AVX-512 min/max intrinsics pass an undefined register through and trip -Wmaybe-uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    SIMD_TARGET("avx512f")
+    static void maxRowAvx512(const float* row, int32_t c, float* best, int32_t* best_class, size_t n) {
+        const __m512i vc = _mm512_set1_epi32(c);
+        size_t x = 0;
+        for (; x + 16 <= n; x += 16) {
+            __m512 v = _mm512_loadu_ps(row + x);
+            __mmask16 greater = _mm512_cmp_ps_mask(v, _mm512_loadu_ps(best + x), _CMP_GT_OQ);
+            _mm512_mask_storeu_ps(best + x, greater, v);
+            _mm512_mask_storeu_epi32(best_class + x, greater, vc);
+        }
+        maxRowScalar(row + x, c, best + x, best_class + x, n - x);
+    }
+
+    SIMD_TARGET("avx512f")
+    static size_t compactAvx512(const float* scores, size_t count, float threshold, uint32_t* indices) {
+        const __m512 vthreshold = _mm512_set1_ps(threshold);
+        const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        size_t written = 0;
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __mmask16 mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(scores + i), vthreshold, _CMP_GT_OQ);
+            _mm512_mask_compressstoreu_epi32(indices + written, mask,
+                                             _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(i)), lanes));
+            written += std::bitset<16>(mask).count();
+        }
+        return compactScalar(scores, count, threshold, indices, i, written);
+    }
+
+    SIMD_TARGET("avx512f")
+    void suppressAvx512(const DetectionBoxes& boxes, size_t i, size_t end, float iou_threshold) {
+        const __m512 bx1 = _mm512_set1_ps(boxes.x1[i]), by1 = _mm512_set1_ps(boxes.y1[i]);
+        const __m512 bx2 = _mm512_set1_ps(boxes.x2[i]), by2 = _mm512_set1_ps(boxes.y2[i]);
+        const __m512 barea = _mm512_set1_ps(boxes.area[i]), threshold = _mm512_set1_ps(iou_threshold);
+        const __m512 zero = _mm512_setzero_ps();
+        const __m512i removed_value = _mm512_set1_epi32(-1);
+        size_t j = i + 1;
+        for (; j + 16 <= end; j += 16) {
+            __m512 w = _mm512_max_ps(zero, _mm512_sub_ps(_mm512_min_ps(bx2, _mm512_loadu_ps(&boxes.x2[j])),
+                                                         _mm512_max_ps(bx1, _mm512_loadu_ps(&boxes.x1[j]))));
+            __m512 h = _mm512_max_ps(zero, _mm512_sub_ps(_mm512_min_ps(by2, _mm512_loadu_ps(&boxes.y2[j])),
+                                                         _mm512_max_ps(by1, _mm512_loadu_ps(&boxes.y1[j]))));
+            __m512 inter = _mm512_mul_ps(w, h);
+            __m512 uni = _mm512_sub_ps(_mm512_add_ps(barea, _mm512_loadu_ps(&boxes.area[j])), inter);
+            __mmask16 overlaps = _mm512_cmp_ps_mask(inter, _mm512_mul_ps(threshold, uni), _CMP_GT_OQ);
+            _mm512_mask_storeu_epi32(&removed_[j], overlaps, removed_value);
+        }
+        suppressScalar(boxes, i, j, end, iou_threshold);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#if defined(SIMD_DISPATCH_NEON)
+    static void maxRowNeon(const float* row, int32_t c, float* best, int32_t* best_class, size_t n) {
+        const int32x4_t vc = vdupq_n_s32(c);
+        size_t x = 0;
+        for (; x + 4 <= n; x += 4) {
+            float32x4_t v = vld1q_f32(row + x);
+            float32x4_t b = vld1q_f32(best + x);
+            uint32x4_t greater = vcgtq_f32(v, b);
+            vst1q_f32(best + x, vbslq_f32(greater, v, b));
+            vst1q_s32(best_class + x, vbslq_s32(greater, vc, vld1q_s32(best_class + x)));
+        }
+        maxRowScalar(row + x, c, best + x, best_class + x, n - x);
+    }
+
+    static size_t compactNeon(const float* scores, size_t count, float threshold, uint32_t* indices) {
+        const float32x4_t vthreshold = vdupq_n_f32(threshold);
+        const uint32x4_t lane_bits = {1, 2, 4, 8};
+        size_t written = 0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            uint32_t mask = vaddvq_u32(vandq_u32(vcgtq_f32(vld1q_f32(scores + i), vthreshold), lane_bits));
+            if (mask == 0) {
+                continue;
+            }
+            // No compress instruction: branchless stores driven by the mask bits
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                indices[written] = static_cast<uint32_t>(i + lane);
+                written += (mask >> lane) & 1u;
+            }
+        }
+        return compactScalar(scores, count, threshold, indices, i, written);
+    }
+
+    void suppressNeon(const DetectionBoxes& boxes, size_t i, size_t end, float iou_threshold) {
+        const float32x4_t bx1 = vdupq_n_f32(boxes.x1[i]), by1 = vdupq_n_f32(boxes.y1[i]);
+        const float32x4_t bx2 = vdupq_n_f32(boxes.x2[i]), by2 = vdupq_n_f32(boxes.y2[i]);
+        const float32x4_t barea = vdupq_n_f32(boxes.area[i]), threshold = vdupq_n_f32(iou_threshold);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        size_t j = i + 1;
+        for (; j + 4 <= end; j += 4) {
+            float32x4_t w = vmaxq_f32(zero, vsubq_f32(vminq_f32(bx2, vld1q_f32(&boxes.x2[j])), vmaxq_f32(bx1, vld1q_f32(&boxes.x1[j]))));
+            float32x4_t h = vmaxq_f32(zero, vsubq_f32(vminq_f32(by2, vld1q_f32(&boxes.y2[j])), vmaxq_f32(by1, vld1q_f32(&boxes.y1[j]))));
+            float32x4_t inter = vmulq_f32(w, h);
+            float32x4_t uni = vsubq_f32(vaddq_f32(barea, vld1q_f32(&boxes.area[j])), inter);
+            uint32x4_t overlaps = vcgtq_f32(inter, vmulq_f32(threshold, uni));
+            int32x4_t removed = vld1q_s32(&removed_[j]);
+            vst1q_s32(&removed_[j], vorrq_s32(removed, vreinterpretq_s32_u32(overlaps)));
+        }
+        suppressScalar(boxes, i, j, end, iou_threshold);
+    }
+#endif
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <opencv2/opencv.hpp>
+#include "frame_pool.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Display configuration
+ */
+struct DisplayConfig {
+    bool headless = false;   // No windows and no HighGUI calls at all
+    double max_fps = 10.0;   // Preview refresh cap
+};
+
+/**
+ * @brief Display Sink Class - Header-only implementation
+ *
+ * Owns every HighGUI call. The processing path only hands over the latest
+ * frame per window (a refcount bump); a separate thread shows whatever is
+ * newest at a capped rate, so display never adds jitter to processing.
+ */
+class DisplaySink {
+public:
+    explicit DisplaySink(double max_fps = 10.0) : max_fps_(max_fps > 0.0 ? max_fps : 10.0) {}
+
+    ~DisplaySink() {
+        stop();
+    }
+
+    DisplaySink(const DisplaySink&) = delete;
+    DisplaySink& operator=(const DisplaySink&) = delete;
+
+    /**
+     * @brief Set callback invoked when ESC is pressed in a preview window
+     *
+     * Runs on the display thread.
+     */
+    void setExitCallback(std::function<void()> callback) {
+        exit_callback_ = std::move(callback);
+    }
+
+    void start() {
+        if (running_) {
+            return;
+        }
+        running_ = true;
+        thread_ = std::thread(&DisplaySink::displayLoop, this);
+        logger_.info("Display sink started (max " + std::to_string(max_fps_) + " fps)");
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+        }
+        condition_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            latest_.clear();
+        }
+        logger_.info("Display sink stopped (shown: " + std::to_string(shown_frames_) +
+                     ", skipped: " + std::to_string(skipped_frames_) + ")");
+    }
+
+    /**
+     * @brief Offer a frame for display; replaces any frame not yet shown
+     */
+    void submit(const std::string& window_name, const PooledFrame& frame) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PooledFrame& slot = latest_[window_name];
+        if (slot) {
+            skipped_frames_++;
+        }
+        slot = frame;
+    }
+
+    /**
+     * @brief Close a window (e.g. when its stream stops)
+     */
+    void remove(const std::string& window_name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latest_.erase(window_name);
+        closing_.push_back(window_name);
+    }
+
+    bool isRunning() const {
+        return running_;
+    }
+
+    uint64_t getShownFrames() const { return shown_frames_; }
+    uint64_t getSkippedFrames() const { return skipped_frames_; }
+
+private:
+    double max_fps_;
+    std::map<std::string, PooledFrame> latest_;   // Frame waiting to be shown per window
+    std::vector<std::string> closing_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> shown_frames_{0};
+    std::atomic<uint64_t> skipped_frames_{0};
+    std::function<void()> exit_callback_;
+    ModuleLogger logger_{"DISPLAY"};
+
+    void displayLoop() {
+        const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / max_fps_));
+        auto next_refresh = std::chrono::steady_clock::now();
+        std::vector<std::pair<std::string, PooledFrame>> to_show;
+        std::vector<std::string> to_close;
+
+        while (running_) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait_until(lock, next_refresh, [this] { return !running_; });
+                if (!running_) {
+                    break;
+                }
+                for (auto& entry : latest_) {
+                    if (entry.second) {
+                        to_show.emplace_back(entry.first, std::move(entry.second));
+                        entry.second.reset();
+                    }
+                }
+                to_close.swap(closing_);
+            }
+            next_refresh += interval;
+            auto now = std::chrono::steady_clock::now();
+            if (next_refresh < now) {
+                next_refresh = now; // Fell behind (slow window system); don't try to catch up
+            }
+
+            for (const auto& name : to_close) {
+                cv::destroyWindow(name);
+            }
+            to_close.clear();
+
+            for (const auto& entry : to_show) {
+                cv::imshow(entry.first, entry.second.mat());
+                shown_frames_++;
+            }
+            to_show.clear(); // Buffers go back to their pools
+
+            // Also pumps the HighGUI event loop
+            int key = cv::waitKey(1) & 0xFF;
+            if (key == 27 && exit_callback_) { // ESC key
+                logger_.info("ESC pressed in preview window");
+                exit_callback_();
+            }
+        }
+
+        cv::destroyAllWindows();
+    }
+};
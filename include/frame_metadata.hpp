@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Per-frame metadata carried from capture to result
+ *
+ * Holds the capture timestamp, a per-stream sequence number and the time
+ * each pipeline stage was entered and left. Fixed-size storage, so moving
+ * a frame through the pipeline never allocates.
+ */
+struct FrameMetadata {
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    static constexpr size_t MAX_STAGES = 8;
+
+    struct Stage {
+        const char* name = nullptr;   // String literal, e.g. "capture"
+        TimePoint enter{};
+        TimePoint leave{};
+    };
+
+    uint64_t sequence = 0;            // Per-stream, starts at 1
+    TimePoint capture_time{};         // When the frame left the source
+    std::array<Stage, MAX_STAGES> stages{};
+    size_t stage_count = 0;
+
+    /**
+     * @brief Mark entry into a stage (name must outlive the frame; use a literal)
+     */
+    void enterStage(const char* name, TimePoint now = Clock::now()) {
+        if (stage_count < MAX_STAGES) {
+            stages[stage_count].name = name;
+            stages[stage_count].enter = now;
+            stages[stage_count].leave = TimePoint{};
+            stage_count++;
+        }
+    }
+
+    /**
+     * @brief Mark exit from the named stage
+     */
+    void leaveStage(const char* name, TimePoint now = Clock::now()) {
+        if (Stage* stage = findStage(name)) {
+            stage->leave = now;
+        }
+    }
+
+    /**
+     * @brief Time spent in a stage in ms (0 if it was never entered or left)
+     */
+    double stageMs(const char* name) const {
+        const Stage* stage = findStage(name);
+        if (!stage || stage->leave == TimePoint{}) {
+            return 0.0;
+        }
+        return std::chrono::duration<double, std::milli>(stage->leave - stage->enter).count();
+    }
+
+    /**
+     * @brief Time from capture to the given instant in ms
+     */
+    double ageMs(TimePoint now = Clock::now()) const {
+        return std::chrono::duration<double, std::milli>(now - capture_time).count();
+    }
+
+    bool hasStage(const char* name) const {
+        return findStage(name) != nullptr;
+    }
+
+private:
+    // Latest stage with this name (a stage may be re-entered)
+    Stage* findStage(const char* name) {
+        for (size_t i = stage_count; i-- > 0;) {
+            if (std::strcmp(stages[i].name, name) == 0) {
+                return &stages[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const Stage* findStage(const char* name) const {
+        return const_cast<FrameMetadata*>(this)->findStage(name);
+    }
+};
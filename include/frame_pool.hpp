@@ -0,0 +1,329 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <new>
+#include <opencv2/opencv.hpp>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+/**
+ * @brief Frame pool statistics snapshot
+ */
+struct FramePoolStats {
+    uint64_t hits = 0;           // Acquires served from a recycled buffer
+    uint64_t misses = 0;         // Acquires that had to allocate a new buffer
+    size_t buffers = 0;          // Buffers currently owned by the pool
+    size_t in_use = 0;           // Buffers currently held by callers
+    size_t bytes_resident = 0;   // Memory held by all buffers
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"hits\":" << hits << ",";
+        json << "\"misses\":" << misses << ",";
+        json << "\"buffers\":" << buffers << ",";
+        json << "\"in_use\":" << in_use << ",";
+        json << "\"bytes_resident\":" << bytes_resident;
+        json << "}";
+        return json.str();
+    }
+};
+
+namespace frame_pool_detail {
+
+constexpr size_t BUFFER_ALIGNMENT = 64; // Cache line / AVX-512 register width
+
+inline void* alignedAlloc(size_t bytes) {
+    // Round up so the size is a multiple of the alignment (required by aligned_alloc-style APIs)
+    bytes = (bytes + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, BUFFER_ALIGNMENT);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, BUFFER_ALIGNMENT, bytes) != 0) {
+        return nullptr;
+    }
+    return ptr;
+#endif
+}
+
+inline void alignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+struct Slot {
+    uchar* data = nullptr;
+    size_t bytes = 0;
+    uint64_t generation = 0;   // Geometry generation this buffer was allocated for
+    cv::Mat mat;               // Header over `data`; never owns memory
+    std::atomic<int> refs{0};
+};
+
+struct State {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<Slot*> free_list;
+    cv::Size size;
+    int type = CV_8UC3;
+    uint64_t generation = 0;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<size_t> in_use{0};
+    size_t bytes_resident = 0;
+
+    ~State() {
+        for (auto& slot : slots) {
+            slot->mat.release();
+            alignedFree(slot->data);
+        }
+    }
+
+    size_t frameBytes() const {
+        return static_cast<size_t>(size.area()) * CV_ELEM_SIZE(type);
+    }
+
+    // Caller holds mutex
+    Slot* allocateSlot() {
+        auto slot = std::make_unique<Slot>();
+        slot->bytes = frameBytes();
+        slot->data = static_cast<uchar*>(alignedAlloc(slot->bytes));
+        if (!slot->data) {
+            throw std::bad_alloc();
+        }
+        slot->generation = generation;
+        bytes_resident += slot->bytes;
+        slots.push_back(std::move(slot));
+        return slots.back().get();
+    }
+
+    // Caller holds mutex
+    void freeSlot(Slot* slot) {
+        auto it = std::find_if(slots.begin(), slots.end(),
+                               [slot](const std::unique_ptr<Slot>& s) { return s.get() == slot; });
+        if (it != slots.end()) {
+            bytes_resident -= slot->bytes;
+            slot->mat.release();
+            alignedFree(slot->data);
+            slots.erase(it);
+        }
+    }
+
+    void release(Slot* slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_use--;
+        if (slot->generation == generation) {
+            free_list.push_back(slot);
+        } else {
+            // Allocated for an old geometry; drop it instead of recycling
+            freeSlot(slot);
+        }
+    }
+};
+
+} // namespace frame_pool_detail
+
+/**
+ * @brief Refcounted handle to a pooled frame buffer
+ *
+ * Copies share the same buffer. The buffer goes back to its pool when the
+ * last handle is destroyed. Copying never touches the heap.
+ */
+class PooledFrame {
+public:
+    PooledFrame() = default;
+
+    PooledFrame(const PooledFrame& other) : state_(other.state_), slot_(other.slot_) {
+        if (slot_) {
+            slot_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    PooledFrame(PooledFrame&& other) noexcept
+        : state_(std::move(other.state_)), slot_(other.slot_) {
+        other.slot_ = nullptr;
+    }
+
+    PooledFrame& operator=(PooledFrame other) noexcept {
+        std::swap(state_, other.state_);
+        std::swap(slot_, other.slot_);
+        return *this;
+    }
+
+    ~PooledFrame() {
+        reset();
+    }
+
+    /**
+     * @brief Drop this reference (returns the buffer if it was the last one)
+     */
+    void reset() {
+        if (slot_ && slot_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            state_->release(slot_);
+        }
+        slot_ = nullptr;
+        state_.reset();
+    }
+
+    cv::Mat& mat() { return slot_->mat; }
+    const cv::Mat& mat() const { return slot_->mat; }
+
+    bool empty() const {
+        return slot_ == nullptr || slot_->mat.empty();
+    }
+
+    explicit operator bool() const {
+        return slot_ != nullptr;
+    }
+
+    /**
+     * @brief True if the Mat header still points at the pooled buffer
+     *
+     * OpenCV reallocates a Mat whose size or type does not match on write,
+     * which silently detaches it from the pool.
+     */
+    bool isPooled() const {
+        return slot_ != nullptr && slot_->mat.data == slot_->data;
+    }
+
+    int useCount() const {
+        return slot_ ? slot_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+    friend class FramePool;
+
+    PooledFrame(std::shared_ptr<frame_pool_detail::State> state, frame_pool_detail::Slot* slot)
+        : state_(std::move(state)), slot_(slot) {
+        slot_->refs.store(1, std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<frame_pool_detail::State> state_;
+    frame_pool_detail::Slot* slot_ = nullptr;
+};
+
+/**
+ * @brief Frame Pool Class - Header-only implementation
+ *
+ * Hands out 64-byte-aligned frame buffers of a fixed geometry and recycles
+ * them when the last holder releases, so steady-state frame handling makes
+ * no heap allocations. The pool grows on demand; each growth is a miss.
+ */
+class FramePool {
+public:
+    FramePool(cv::Size size, int type, size_t preallocate = 0)
+        : state_(std::make_shared<frame_pool_detail::State>()) {
+        state_->size = size;
+        state_->type = type;
+        reserve(preallocate);
+    }
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * @brief Get a buffer, recycling a released one when available
+     */
+    PooledFrame acquire() {
+        frame_pool_detail::Slot* slot = nullptr;
+        cv::Size size;
+        int type = 0;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            size = state_->size;
+            type = state_->type;
+            if (!state_->free_list.empty()) {
+                slot = state_->free_list.back();
+                state_->free_list.pop_back();
+                state_->hits++;
+            } else {
+                slot = state_->allocateSlot();
+                state_->misses++;
+            }
+            state_->in_use++;
+        }
+
+        // Rebuild the header in case a previous holder reassigned it
+        if (slot->mat.data != slot->data || slot->mat.size() != size || slot->mat.type() != type) {
+            slot->mat = cv::Mat(size, type, slot->data);
+        }
+        return PooledFrame(state_, slot);
+    }
+
+    /**
+     * @brief Preallocate buffers so the first frames are hits as well
+     */
+    void reserve(size_t count) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        while (state_->slots.size() < count) {
+            frame_pool_detail::Slot* slot = state_->allocateSlot();
+            slot->mat = cv::Mat(state_->size, state_->type, slot->data);
+            state_->free_list.push_back(slot);
+        }
+    }
+
+    /**
+     * @brief Change the buffer geometry
+     *
+     * Free buffers are dropped immediately; buffers still held are dropped
+     * when released.
+     */
+    void reconfigure(cv::Size size, int type) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (size == state_->size && type == state_->type) {
+            return;
+        }
+        state_->size = size;
+        state_->type = type;
+        state_->generation++;
+
+        size_t preallocated = state_->free_list.size();
+        for (auto* slot : state_->free_list) {
+            state_->freeSlot(slot);
+        }
+        state_->free_list.clear();
+        while (state_->free_list.size() < preallocated) {
+            frame_pool_detail::Slot* slot = state_->allocateSlot();
+            slot->mat = cv::Mat(state_->size, state_->type, slot->data);
+            state_->free_list.push_back(slot);
+        }
+    }
+
+    cv::Size getSize() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->size;
+    }
+
+    int getType() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->type;
+    }
+
+    FramePoolStats getStats() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        FramePoolStats stats;
+        stats.hits = state_->hits;
+        stats.misses = state_->misses;
+        stats.buffers = state_->slots.size();
+        stats.in_use = state_->in_use;
+        stats.bytes_resident = state_->bytes_resident;
+        return stats;
+    }
+
+private:
+    std::shared_ptr<frame_pool_detail::State> state_;
+};
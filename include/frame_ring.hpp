@@ -0,0 +1,207 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Behaviour of a full FrameRing when the producer pushes another item
+ */
+enum class OverflowPolicy {
+    DROP_OLDEST,  // Overwrite the oldest queued item (keeps the stream fresh)
+    DROP_NEWEST,  // Discard the incoming item
+    BLOCK         // Wait until the consumer frees a slot
+};
+
+inline std::string overflowPolicyToString(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DROP_OLDEST: return "drop_oldest";
+        case OverflowPolicy::DROP_NEWEST: return "drop_newest";
+        case OverflowPolicy::BLOCK: return "block";
+        default: return "unknown";
+    }
+}
+
+inline OverflowPolicy stringToOverflowPolicy(const std::string& policy_str) {
+    if (policy_str == "drop_newest") return OverflowPolicy::DROP_NEWEST;
+    if (policy_str == "block") return OverflowPolicy::BLOCK;
+    return OverflowPolicy::DROP_OLDEST; // default
+}
+
+/**
+ * @brief Bounded single-producer/single-consumer frame ring - Header-only implementation
+ *
+ * Fixed number of preallocated slots between the capture thread and the
+ * processing thread. Slots are reused in place, so a full ring never grows.
+ * The lock is only held for index updates and a move, which is negligible
+ * at camera rates compared to capture or processing time.
+ */
+template<typename T>
+class FrameRing {
+public:
+    explicit FrameRing(size_t capacity = 4, OverflowPolicy policy = OverflowPolicy::DROP_OLDEST)
+        : slots_(capacity > 0 ? capacity : 1), policy_(policy) {}
+
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+
+    /**
+     * @brief Push an item (producer side)
+     * @return false if the item was discarded or the ring is closed
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_) {
+            return false;
+        }
+
+        if (count_ == slots_.size()) {
+            switch (policy_) {
+                case OverflowPolicy::DROP_NEWEST:
+                    dropped_++;
+                    return false;
+                case OverflowPolicy::BLOCK:
+                    not_full_.wait(lock, [this] { return count_ < slots_.size() || closed_; });
+                    if (closed_) {
+                        return false;
+                    }
+                    break;
+                case OverflowPolicy::DROP_OLDEST:
+                default:
+                    // Free the oldest slot; its storage is reused below
+                    head_ = (head_ + 1) % slots_.size();
+                    count_--;
+                    dropped_++;
+                    break;
+            }
+        }
+
+        slots_[(head_ + count_) % slots_.size()] = std::move(item);
+        count_++;
+        pushed_++;
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Pop the oldest item, waiting up to timeout (consumer side)
+     */
+    bool pop(T& out, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!not_empty_.wait_for(lock, timeout, [this] { return count_ > 0 || closed_; }) || count_ == 0) {
+            return false;
+        }
+
+        takeFront(out);
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Pop the freshest item, discarding everything older (consumer side)
+     *
+     * Waits up to timeout only when the ring is empty.
+     */
+    bool popLatest(T& out, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!not_empty_.wait_for(lock, timeout, [this] { return count_ > 0 || closed_; }) || count_ == 0) {
+            return false;
+        }
+
+        // Skip stale items; they count as dropped
+        size_t stale = count_ - 1;
+        head_ = (head_ + stale) % slots_.size();
+        count_ -= stale;
+        dropped_ += stale;
+
+        takeFront(out);
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Close the ring and wake any waiting producer or consumer
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+    /**
+     * @brief Reopen a closed ring and discard any queued items
+     */
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& slot : slots_) {
+            slot = T();
+        }
+        head_ = 0;
+        count_ = 0;
+        closed_ = false;
+    }
+
+    bool isClosed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+    /**
+     * @brief True once the ring is closed and fully drained
+     */
+    bool isFinished() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_ && count_ == 0;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    size_t capacity() const {
+        return slots_.size();
+    }
+
+    OverflowPolicy getPolicy() const {
+        return policy_;
+    }
+
+    uint64_t getPushedCount() const {
+        return pushed_;
+    }
+
+    uint64_t getDroppedCount() const {
+        return dropped_;
+    }
+
+private:
+    std::vector<T> slots_;
+    OverflowPolicy policy_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool closed_ = false;
+    std::atomic<uint64_t> pushed_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+
+    void takeFront(T& out) {
+        out = std::move(slots_[head_]);
+        slots_[head_] = T();
+        head_ = (head_ + 1) % slots_.size();
+        count_--;
+    }
+};
@@ -0,0 +1,589 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <cctype>
+#include <opencv2/opencv.hpp>
+#include "frame_ring.hpp"
+#include "thread_topology.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief How a non-live source releases frames
+ */
+enum class PacingMode {
+    REAL_TIME,            // One frame per 1/native_fps, like a camera would deliver
+    AS_FAST_AS_POSSIBLE   // No waiting; throughput is bounded by the consumer
+};
+
+inline std::string pacingModeToString(PacingMode mode) {
+    return mode == PacingMode::AS_FAST_AS_POSSIBLE ? "fast" : "realtime";
+}
+
+inline PacingMode stringToPacingMode(const std::string& mode_str) {
+    if (mode_str == "fast") return PacingMode::AS_FAST_AS_POSSIBLE;
+    return PacingMode::REAL_TIME; // default
+}
+
+/**
+ * @brief Frame source options
+ */
+struct FrameSourceOptions {
+    int width = 640;                           // Requested size (camera, synthetic)
+    int height = 480;
+    double fps = 30.0;                         // Requested/native rate where the source has none
+    PacingMode pacing = PacingMode::REAL_TIME;
+    bool loop = false;                         // Restart finite sources at the end
+    uint64_t max_frames = 0;                   // Stop after this many frames (0 = unlimited)
+    size_t prefetch_depth = 4;                 // Image directory read-ahead
+};
+
+/**
+ * @brief Frame Source Interface
+ *
+ * Anything that produces BGR8 frames: live cameras, video files, image
+ * directories or a synthetic generator. grab() advances to the next frame
+ * and applies the pacing mode to non-live sources (live sources are paced
+ * by the device); retrieve() decodes the grabbed frame. Callers that skip
+ * frames grab every frame but retrieve only the ones they keep.
+ */
+class FrameSource {
+public:
+    explicit FrameSource(const FrameSourceOptions& options) : options_(options) {}
+    virtual ~FrameSource() = default;
+
+    FrameSource(const FrameSource&) = delete;
+    FrameSource& operator=(const FrameSource&) = delete;
+
+    /**
+     * @brief Open the underlying device or file
+     */
+    virtual bool open() = 0;
+
+    /**
+     * @brief Release the underlying device or file
+     */
+    virtual void close() = 0;
+
+    virtual bool isOpened() const = 0;
+
+    /**
+     * @brief Frame geometry (valid after open)
+     */
+    virtual cv::Size getFrameSize() const = 0;
+
+    /**
+     * @brief Native frame rate (valid after open)
+     */
+    virtual double getNativeFps() const = 0;
+
+    /**
+     * @brief Human-readable source description
+     */
+    virtual std::string describe() const = 0;
+
+    /**
+     * @brief Live sources are paced by hardware and never exhausted
+     */
+    virtual bool isLive() const {
+        return false;
+    }
+
+    /**
+     * @brief True once a finite source has delivered its last frame
+     */
+    bool isExhausted() const {
+        return exhausted_;
+    }
+
+    /**
+     * @brief Advance to the next frame without decoding it, waiting per the pacing mode
+     */
+    bool grab() {
+        if (exhausted_) {
+            return false;
+        }
+        if (options_.max_frames > 0 && frames_grabbed_ >= options_.max_frames) {
+            exhausted_ = true;
+            return false;
+        }
+
+        pace();
+        if (!grabFrame()) {
+            return false;
+        }
+        frames_grabbed_++;
+        return true;
+    }
+
+    /**
+     * @brief Decode the most recently grabbed frame
+     *
+     * Writes into frame's existing storage when geometry matches.
+     */
+    bool retrieve(cv::Mat& frame) {
+        return retrieveFrame(frame);
+    }
+
+    /**
+     * @brief Grab and decode the next frame
+     */
+    bool read(cv::Mat& frame) {
+        return grab() && retrieve(frame);
+    }
+
+    uint64_t getFramesGrabbed() const {
+        return frames_grabbed_;
+    }
+
+    const FrameSourceOptions& getOptions() const {
+        return options_;
+    }
+
+    /**
+     * @brief Create a source from a URI
+     *
+     * camera:<id> (or a bare number), file:<path>, dir:<path>,
+     * synthetic:<width>x<height>[@<fps>]. A bare path is a directory or
+     * video file depending on what exists on disk.
+     */
+    static std::unique_ptr<FrameSource> create(const std::string& uri, const FrameSourceOptions& options);
+
+protected:
+    FrameSourceOptions options_;
+    std::atomic<bool> exhausted_{false};
+
+    /**
+     * @brief Advance to the next frame (no pacing); keep decoding for retrieveFrame
+     */
+    virtual bool grabFrame() = 0;
+
+    /**
+     * @brief Decode the frame taken by the last successful grabFrame
+     */
+    virtual bool retrieveFrame(cv::Mat& frame) = 0;
+
+    void markExhausted() {
+        exhausted_ = true;
+    }
+
+private:
+    uint64_t frames_grabbed_ = 0;
+    std::chrono::steady_clock::time_point next_frame_time_{};
+
+    void pace() {
+        if (isLive() || options_.pacing == PacingMode::AS_FAST_AS_POSSIBLE) {
+            return;
+        }
+
+        double fps = getNativeFps() > 0.0 ? getNativeFps() : options_.fps;
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(fps, 1.0)));
+        auto now = std::chrono::steady_clock::now();
+
+        if (next_frame_time_ == std::chrono::steady_clock::time_point{} || now - next_frame_time_ > interval * 4) {
+            // First frame, or we fell far behind: restart the schedule instead of bursting
+            next_frame_time_ = now;
+        } else if (next_frame_time_ > now) {
+            std::this_thread::sleep_until(next_frame_time_);
+        }
+        next_frame_time_ += interval;
+    }
+};
+
+/**
+ * @brief Live camera through cv::VideoCapture
+ */
+class CameraSource : public FrameSource {
+public:
+    CameraSource(int camera_id, const FrameSourceOptions& options)
+        : FrameSource(options), camera_id_(camera_id) {}
+
+    bool open() override {
+        camera_.open(camera_id_);
+        if (!camera_.isOpened()) {
+            return false;
+        }
+
+        camera_.set(cv::CAP_PROP_FRAME_WIDTH, options_.width);
+        camera_.set(cv::CAP_PROP_FRAME_HEIGHT, options_.height);
+        camera_.set(cv::CAP_PROP_FPS, options_.fps);
+        // Frames are drained continuously; a deep driver queue would only add latency
+        // (honoured by some backends, e.g. V4L2 and DirectShow)
+        camera_.set(cv::CAP_PROP_BUFFERSIZE, 1);
+
+        // Cache actual properties; the device is owned by the capture thread from here on
+        size_ = cv::Size(static_cast<int>(camera_.get(cv::CAP_PROP_FRAME_WIDTH)),
+                         static_cast<int>(camera_.get(cv::CAP_PROP_FRAME_HEIGHT)));
+        fps_ = camera_.get(cv::CAP_PROP_FPS);
+        return true;
+    }
+
+    void close() override {
+        if (camera_.isOpened()) {
+            camera_.release();
+        }
+    }
+
+    bool isOpened() const override { return camera_.isOpened(); }
+    cv::Size getFrameSize() const override { return size_; }
+    double getNativeFps() const override { return fps_; }
+    bool isLive() const override { return true; }
+
+    std::string describe() const override {
+        return "camera:" + std::to_string(camera_id_);
+    }
+
+protected:
+    bool grabFrame() override {
+        return camera_.grab();
+    }
+
+    bool retrieveFrame(cv::Mat& frame) override {
+        return camera_.retrieve(frame) && !frame.empty();
+    }
+
+private:
+    int camera_id_;
+    cv::VideoCapture camera_;
+    cv::Size size_;
+    double fps_ = 0.0;
+};
+
+/**
+ * @brief Video file through cv::VideoCapture
+ */
+class VideoFileSource : public FrameSource {
+public:
+    VideoFileSource(const std::string& path, const FrameSourceOptions& options)
+        : FrameSource(options), path_(path) {}
+
+    bool open() override {
+        video_.open(path_);
+        if (!video_.isOpened()) {
+            return false;
+        }
+        size_ = cv::Size(static_cast<int>(video_.get(cv::CAP_PROP_FRAME_WIDTH)),
+                         static_cast<int>(video_.get(cv::CAP_PROP_FRAME_HEIGHT)));
+        fps_ = video_.get(cv::CAP_PROP_FPS);
+        return true;
+    }
+
+    void close() override {
+        if (video_.isOpened()) {
+            video_.release();
+        }
+    }
+
+    bool isOpened() const override { return video_.isOpened(); }
+    cv::Size getFrameSize() const override { return size_; }
+    double getNativeFps() const override { return fps_ > 0.0 ? fps_ : options_.fps; }
+
+    std::string describe() const override {
+        return "file:" + path_;
+    }
+
+protected:
+    bool grabFrame() override {
+        if (video_.grab()) {
+            return true;
+        }
+        if (options_.loop) {
+            video_.set(cv::CAP_PROP_POS_FRAMES, 0);
+            if (video_.grab()) {
+                return true;
+            }
+        }
+        markExhausted();
+        return false;
+    }
+
+    bool retrieveFrame(cv::Mat& frame) override {
+        return video_.retrieve(frame) && !frame.empty();
+    }
+
+private:
+    std::string path_;
+    cv::VideoCapture video_;
+    cv::Size size_;
+    double fps_ = 0.0;
+};
+
+/**
+ * @brief Directory of still images, decoded ahead on a prefetch thread
+ */
+class ImageDirectorySource : public FrameSource {
+public:
+    ImageDirectorySource(const std::string& directory, const FrameSourceOptions& options)
+        : FrameSource(options), directory_(directory),
+          prefetched_(std::max<size_t>(1, options.prefetch_depth), OverflowPolicy::BLOCK) {}
+
+    ~ImageDirectorySource() override {
+        close();
+    }
+
+    bool open() override {
+        files_.clear();
+        try {
+            for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+                if (entry.is_regular_file() && isImageFile(entry.path())) {
+                    files_.push_back(entry.path().string());
+                }
+            }
+        } catch (const std::exception& e) {
+            logger_.error("Cannot list image directory " + directory_ + ": " + e.what());
+            return false;
+        }
+
+        if (files_.empty()) {
+            logger_.error("No images found in " + directory_);
+            return false;
+        }
+        std::sort(files_.begin(), files_.end());
+
+        // Geometry comes from the first image
+        cv::Mat first = cv::imread(files_.front(), cv::IMREAD_COLOR);
+        if (first.empty()) {
+            logger_.error("Cannot decode " + files_.front());
+            return false;
+        }
+        size_ = cv::Size(first.cols, first.rows);
+
+        prefetched_.reset();
+        prefetching_ = true;
+        prefetch_thread_ = std::thread(&ImageDirectorySource::prefetchLoop, this);
+        logger_.info("Image directory " + directory_ + ": " + std::to_string(files_.size()) +
+                     " images, prefetch depth " + std::to_string(prefetched_.capacity()));
+        return true;
+    }
+
+    void close() override {
+        prefetching_ = false;
+        prefetched_.close();
+        if (prefetch_thread_.joinable()) {
+            prefetch_thread_.join();
+        }
+    }
+
+    bool isOpened() const override { return prefetch_thread_.joinable(); }
+    cv::Size getFrameSize() const override { return size_; }
+    double getNativeFps() const override { return options_.fps; }
+
+    std::string describe() const override {
+        return "dir:" + directory_;
+    }
+
+protected:
+    // Images are decoded ahead on the prefetch thread, so grabbing a skipped
+    // frame costs its decode there but never on the capture thread
+    bool grabFrame() override {
+        // Waits only if decoding falls behind the consumer
+        while (!prefetched_.pop(grabbed_, std::chrono::milliseconds(100))) {
+            if (prefetched_.isFinished()) {
+                markExhausted();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool retrieveFrame(cv::Mat& frame) override {
+        if (grabbed_.empty()) {
+            return false;
+        }
+        grabbed_.copyTo(frame);
+        return true;
+    }
+
+private:
+    std::string directory_;
+    std::vector<std::string> files_;
+    cv::Size size_;
+    FrameRing<cv::Mat> prefetched_;
+    cv::Mat grabbed_;
+    std::thread prefetch_thread_;
+    std::atomic<bool> prefetching_{false};
+    ModuleLogger logger_{"IMAGE_DIR"};
+
+    static bool isImageFile(const std::filesystem::path& path) {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp" ||
+               ext == ".tif" || ext == ".tiff" || ext == ".webp" || ext == ".ppm" || ext == ".pgm";
+    }
+
+    void prefetchLoop() {
+        ScopedThreadRole role(ThreadRole::CAPTURE);
+        size_t index = 0;
+        while (prefetching_) {
+            if (index == files_.size()) {
+                if (!options_.loop) {
+                    break;
+                }
+                index = 0;
+            }
+
+            cv::Mat image = cv::imread(files_[index++], cv::IMREAD_COLOR);
+            if (image.empty()) {
+                logger_.warn("Skipping undecodable image " + files_[index - 1]);
+                continue;
+            }
+            if (image.cols != size_.width || image.rows != size_.height) {
+                cv::resize(image, image, size_);
+            }
+            if (!prefetched_.push(std::move(image))) {
+                break; // Closed
+            }
+        }
+        prefetched_.close(); // Consumer drains the rest, then sees end of stream
+    }
+};
+
+/**
+ * @brief Synthetic moving-pattern generator
+ *
+ * The gradient background is rendered once; each frame is a single copy
+ * plus a small moving block, so generation cost stays far below the cost
+ * of the processing being measured.
+ */
+class SyntheticSource : public FrameSource {
+public:
+    explicit SyntheticSource(const FrameSourceOptions& options) : FrameSource(options) {}
+
+    bool open() override {
+        size_ = cv::Size(options_.width, options_.height);
+        if (size_.width <= 0 || size_.height <= 0) {
+            return false;
+        }
+
+        // Same pattern the performance tests used: B ramps with x, G with y, R with x+y
+        background_.create(size_, CV_8UC3);
+        std::vector<uchar> blue(size_.width), red_offset(size_.width);
+        for (int x = 0; x < size_.width; ++x) {
+            blue[x] = static_cast<uchar>((x * 255) / size_.width);
+        }
+        for (int y = 0; y < size_.height; ++y) {
+            uchar green = static_cast<uchar>((y * 255) / size_.height);
+            uchar* row = background_.ptr<uchar>(y);
+            for (int x = 0; x < size_.width; ++x) {
+                row[3 * x + 0] = blue[x];
+                row[3 * x + 1] = green;
+                row[3 * x + 2] = static_cast<uchar>(((x + y) * 255) / (size_.width + size_.height));
+            }
+        }
+        opened_ = true;
+        return true;
+    }
+
+    void close() override {
+        opened_ = false;
+        background_.release();
+    }
+
+    bool isOpened() const override { return opened_; }
+    cv::Size getFrameSize() const override { return size_; }
+    double getNativeFps() const override { return options_.fps; }
+
+    std::string describe() const override {
+        return "synthetic:" + std::to_string(size_.width) + "x" + std::to_string(size_.height);
+    }
+
+protected:
+    bool grabFrame() override {
+        frame_index_++;
+        return true;
+    }
+
+    bool retrieveFrame(cv::Mat& frame) override {
+        background_.copyTo(frame);
+
+        // Moving block so consecutive frames differ
+        uint64_t index = frame_index_ - 1;
+        int block = std::max(8, std::min(size_.width, size_.height) / 8);
+        int span_x = std::max(1, size_.width - block);
+        int span_y = std::max(1, size_.height - block);
+        int x = static_cast<int>((index * 7) % span_x);
+        int y = static_cast<int>((index * 3) % span_y);
+        cv::rectangle(frame, cv::Rect(x, y, std::min(block, size_.width), std::min(block, size_.height)),
+                      cv::Scalar(255, 255, 255), -1);
+        return true;
+    }
+
+private:
+    cv::Mat background_;
+    cv::Size size_;
+    bool opened_ = false;
+    uint64_t frame_index_ = 0;
+};
+
+inline std::unique_ptr<FrameSource> FrameSource::create(const std::string& uri, const FrameSourceOptions& options) {
+    size_t colon = uri.find(':');
+    std::string scheme = colon == std::string::npos ? "" : uri.substr(0, colon);
+    std::string target = colon == std::string::npos ? uri : uri.substr(colon + 1);
+
+    // Windows drive letters ("C:\...") are paths, not schemes
+    if (scheme.size() == 1) {
+        scheme.clear();
+        target = uri;
+    }
+
+    if (scheme.empty()) {
+        if (!target.empty() &&
+            std::all_of(target.begin(), target.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+            scheme = "camera";
+        } else if (std::filesystem::is_directory(target)) {
+            scheme = "dir";
+        } else {
+            scheme = "file";
+        }
+    }
+
+    if (scheme == "camera") {
+        try {
+            return std::make_unique<CameraSource>(std::stoi(target), options);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+    if (scheme == "file") {
+        return std::make_unique<VideoFileSource>(target, options);
+    }
+    if (scheme == "dir") {
+        return std::make_unique<ImageDirectorySource>(target, options);
+    }
+    if (scheme == "synthetic") {
+        // synthetic:<width>x<height>[@<fps>]
+        FrameSourceOptions synthetic_options = options;
+        int width = 0, height = 0;
+        double fps = 0.0;
+        size_t x_pos = target.find('x');
+        size_t at_pos = target.find('@');
+        try {
+            if (x_pos != std::string::npos) {
+                width = std::stoi(target.substr(0, x_pos));
+                height = std::stoi(target.substr(x_pos + 1, at_pos == std::string::npos ? std::string::npos : at_pos - x_pos - 1));
+            }
+            if (at_pos != std::string::npos) {
+                fps = std::stod(target.substr(at_pos + 1));
+            }
+        } catch (...) {
+            return nullptr;
+        }
+        if (width > 0 && height > 0) {
+            synthetic_options.width = width;
+            synthetic_options.height = height;
+        }
+        if (fps > 0.0) {
+            synthetic_options.fps = fps;
+        }
+        return std::make_unique<SyntheticSource>(synthetic_options);
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,446 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "simd_dispatch.hpp"
+
+/**
+ * @brief Affine int8 quantization of the normalized input: q = round(value / scale) + zero_point
+ */
+struct Int8Quantization {
+    float scale = 1.0f / 128.0f;
+    int zero_point = 0;
+};
+
+/**
+ * @brief Fused Input Preprocessing - Header-only implementation
+ *
+ * Produces the same tensor as cv::dnn::blobFromImages(images, scale, size,
+ * mean, swap_rb) for BGR8 frames: bilinear resize, optional B/R swap,
+ * (pixel - mean) * scale, planar NCHW. Instead of four full-frame passes
+ * with temporaries it makes one pass over the source rows it needs:
+ *
+ * - Each source row is interpolated horizontally once, straight into
+ *   three planar float rows in output channel order (the swap is free).
+ *   The two most recent rows are kept, so every source row is read once.
+ * - Each output row is the vertical blend of two such rows with scale and
+ *   mean folded into the weights, one FMA per value, written directly into
+ *   the tensor (float) or rounded and saturated to int8.
+ *
+ * The working set is a few rows, so it stays in L1/L2 at any resolution.
+ * The vertical pass has AVX2, AVX-512 and NEON versions chosen at run time
+ * (scalar fallback). The horizontal pass uses AVX2 gathers on both x86
+ * paths (a 16-wide gather is no faster) and is scalar on NEON, which has
+ * no gather. Results match OpenCV's resize within one pixel level (OpenCV
+ * interpolates 8-bit images in fixed point, this kernel in float).
+ *
+ * The resized image can also fill just a rectangle of the tensor (letterbox
+ * content area); only the border around it is then written with the pad
+ * value, the tensor is never cleared as a whole.
+ *
+ * Interpolation tables are rebuilt only when the source or target size
+ * changes, so steady-state frames allocate nothing. Not thread-safe: one instance per
+ * thread.
+ */
+class FusedPreprocessor {
+public:
+    explicit FusedPreprocessor(const cv::Size& input_size, double scale = 1.0 / 255.0,
+                               const cv::Scalar& mean = cv::Scalar(), bool swap_rb = true)
+        : input_size_(input_size), scale_(static_cast<float>(scale)), swap_rb_(swap_rb) {
+        for (int c = 0; c < 3; ++c) {
+            mean_[c] = static_cast<float>(mean[c]);
+        }
+        setPath(bestPath());
+    }
+
+    static std::vector<SimdPath> availablePaths() {
+        return availableSimdPaths();
+    }
+
+    static SimdPath bestPath() {
+        return bestSimdPath();
+    }
+
+    /**
+     * @brief Force a path (benchmarks, tests); false if this CPU cannot run it
+     */
+    bool setPath(SimdPath path) {
+        if (!isSimdPathAvailable(path)) {
+            return false;
+        }
+        path_ = path;
+        switch (path) {
+#if defined(SIMD_DISPATCH_NEON)
+            case SimdPath::NEON:
+                interpolate_ = nullptr;
+                blend_ = blendRowNeon;
+                quantize_ = blendQuantizeRowNeon;
+                break;
+#elif defined(SIMD_DISPATCH_X86)
+            case SimdPath::AVX2:
+                interpolate_ = interpolateRowAvx2;
+                blend_ = blendRowAvx2;
+                quantize_ = blendQuantizeRowAvx2;
+                break;
+            case SimdPath::AVX512:
+                interpolate_ = interpolateRowAvx2;
+                blend_ = blendRowAvx512;
+                quantize_ = blendQuantizeRowAvx512;
+                break;
+#endif
+            default:
+                interpolate_ = nullptr;
+                blend_ = blendRowScalar;
+                quantize_ = blendQuantizeRowScalar;
+                break;
+        }
+        return true;
+    }
+
+    SimdPath getPath() const {
+        return path_;
+    }
+
+    const cv::Size& getInputSize() const {
+        return input_size_;
+    }
+
+    /**
+     * @brief One BGR8 image into a planar float tensor of 3 x height x width values
+     */
+    bool run(const cv::Mat& image, float* tensor) {
+        return run(image, tensor, cv::Rect(cv::Point(), input_size_), cv::Scalar());
+    }
+
+    /**
+     * @brief Resize into the content rectangle of a planar float tensor, padding the border around it
+     *
+     * pad_value is a pixel value in network channel order (like mean) and is
+     * normalized the same way as the image.
+     */
+    bool run(const cv::Mat& image, float* tensor, const cv::Rect& content, const cv::Scalar& pad_value) {
+        const size_t plane = static_cast<size_t>(input_size_.area());
+        const bool done = process(image, content, [&](int c, int y, const float* h0, const float* h1, float w0, float w1) {
+            blend_(h0, h1, w0 * scale_, w1 * scale_, -mean_[c] * scale_,
+                   tensor + c * plane + static_cast<size_t>(content.y + y) * input_size_.width + content.x, content.width);
+        });
+        if (done) {
+            for (int c = 0; c < 3; ++c) {
+                fillBorder(tensor + c * plane, content, static_cast<float>((pad_value[c] - mean_[c]) * scale_));
+            }
+        }
+        return done;
+    }
+
+    /**
+     * @brief One BGR8 image into a planar int8 tensor, quantized as it is written
+     */
+    bool run(const cv::Mat& image, int8_t* tensor, const Int8Quantization& quantization) {
+        return run(image, tensor, quantization, cv::Rect(cv::Point(), input_size_), cv::Scalar());
+    }
+
+    /**
+     * @brief Int8 version of the content-rectangle run(); the pad value is quantized like the image
+     */
+    bool run(const cv::Mat& image, int8_t* tensor, const Int8Quantization& quantization, const cv::Rect& content,
+             const cv::Scalar& pad_value) {
+        const size_t plane = static_cast<size_t>(input_size_.area());
+        const float to_q = scale_ / quantization.scale;
+        const bool done = process(image, content, [&](int c, int y, const float* h0, const float* h1, float w0, float w1) {
+            quantize_(h0, h1, w0 * to_q, w1 * to_q, -mean_[c] * to_q + static_cast<float>(quantization.zero_point),
+                      tensor + c * plane + static_cast<size_t>(content.y + y) * input_size_.width + content.x, content.width);
+        });
+        if (done) {
+            for (int c = 0; c < 3; ++c) {
+                long q = std::lrint((pad_value[c] - mean_[c]) * to_q) + quantization.zero_point;
+                fillBorder(tensor + c * plane, content, static_cast<int8_t>(std::max(-128L, std::min(127L, q))));
+            }
+        }
+        return done;
+    }
+
+    /**
+     * @brief Batch into an N x 3 x height x width CV_32F blob, reusing the blob's storage
+     */
+    bool runBatch(const std::vector<cv::Mat>& images, cv::Mat& blob) {
+        if (images.empty()) {
+            return false;
+        }
+        int sizes[4] = {static_cast<int>(images.size()), 3, input_size_.height, input_size_.width};
+        blob.create(4, sizes, CV_32F);
+        const size_t image_values = 3 * static_cast<size_t>(input_size_.area());
+        float* data = blob.ptr<float>();
+        for (size_t i = 0; i < images.size(); ++i) {
+            if (!run(images[i], data + i * image_values)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // Returns the number of leading columns done; the rest are left to the scalar loop
+    using InterpolateFn = int (*)(const uchar*, const int*, const int*, const float*, int, int, int, float* const*);
+    using BlendFn = void (*)(const float*, const float*, float, float, float, float*, int);
+    using QuantizeFn = void (*)(const float*, const float*, float, float, float, int8_t*, int);
+
+    cv::Size input_size_;
+    float scale_;
+    float mean_[3] = {0.0f, 0.0f, 0.0f};
+    bool swap_rb_;
+    SimdPath path_ = SimdPath::SCALAR;
+    InterpolateFn interpolate_ = nullptr;
+    BlendFn blend_ = blendRowScalar;
+    QuantizeFn quantize_ = blendQuantizeRowScalar;
+
+    // Interpolation tables for the current source and target size
+    cv::Size source_size_;
+    cv::Size target_size_;
+    std::vector<int> x0_offset_;   // Byte offset of the left and right source pixel
+    std::vector<int> x1_offset_;
+    std::vector<float> x_alpha_;
+    int gather_width_ = 0;         // Leading columns whose 4-byte loads stay inside the row
+    std::vector<int> y0_;
+    std::vector<int> y1_;
+    std::vector<float> y_alpha_;
+
+    // Two horizontally interpolated source rows, 3 planes each
+    std::vector<float> rows_[2];
+    int row_tag_[2] = {-1, -1};
+
+    // Resizes image to content.size(); write_row gets rows relative to the content rectangle
+    template <typename RowWriter>
+    bool process(const cv::Mat& image, const cv::Rect& content, RowWriter write_row) {
+        if (image.empty() || image.type() != CV_8UC3 || content.empty() ||
+            (content & cv::Rect(cv::Point(), input_size_)) != content) {
+            return false;
+        }
+        prepareTables(image.size(), content.size());
+        row_tag_[0] = row_tag_[1] = -1;
+
+        for (int y = 0; y < content.height; ++y) {
+            int s0 = findRow(y0_[y]);
+            int s1 = findRow(y1_[y]);
+            if (s0 < 0) {
+                s0 = (s1 == 0) ? 1 : 0;
+                interpolateRow(image, y0_[y], s0);
+                if (y1_[y] == y0_[y]) s1 = s0;
+            }
+            if (s1 < 0) {
+                s1 = 1 - s0;
+                interpolateRow(image, y1_[y], s1);
+            }
+            const float beta = y_alpha_[y];
+            for (int c = 0; c < 3; ++c) {
+                const size_t offset = static_cast<size_t>(c) * content.width;
+                write_row(c, y, rows_[s0].data() + offset, rows_[s1].data() + offset, 1.0f - beta, beta);
+            }
+        }
+        return true;
+    }
+
+    int findRow(int source_y) const {
+        return row_tag_[0] == source_y ? 0 : (row_tag_[1] == source_y ? 1 : -1);
+    }
+
+    void interpolateRow(const cv::Mat& image, int source_y, int slot) {
+        const uchar* row = image.ptr<uchar>(source_y);
+        const int width = target_size_.width;
+        float* out[3];
+        for (int c = 0; c < 3; ++c) {
+            out[c] = rows_[slot].data() + static_cast<size_t>(c) * width;
+        }
+        const int red = swap_rb_ ? 2 : 0;
+        const int blue = swap_rb_ ? 0 : 2;
+        int x = 0;
+        if (interpolate_) {
+            x = interpolate_(row, x0_offset_.data(), x1_offset_.data(), x_alpha_.data(), gather_width_, red, blue, out);
+        }
+        for (; x < width; ++x) {
+            const uchar* p0 = row + x0_offset_[x];
+            const uchar* p1 = row + x1_offset_[x];
+            const float a = x_alpha_[x];
+            out[0][x] = p0[red] + a * (p1[red] - p0[red]);
+            out[1][x] = p0[1] + a * (p1[1] - p0[1]);
+            out[2][x] = p0[blue] + a * (p1[blue] - p0[blue]);
+        }
+        row_tag_[slot] = source_y;
+    }
+
+    /**
+     * @brief Source coordinates for every output column and row (pixel centres aligned, like cv::resize)
+     */
+    void prepareTables(const cv::Size& source_size, const cv::Size& target_size) {
+        if (source_size == source_size_ && target_size == target_size_) {
+            return;
+        }
+        source_size_ = source_size;
+        target_size_ = target_size;
+        auto axis = [](int source, int target, int stride, std::vector<int>& first, std::vector<int>& second,
+                       std::vector<float>& alpha) {
+            first.resize(target);
+            second.resize(target);
+            alpha.resize(target);
+            const double ratio = static_cast<double>(source) / target;
+            for (int i = 0; i < target; ++i) {
+                double position = (i + 0.5) * ratio - 0.5;
+                int index = static_cast<int>(std::floor(position));
+                float weight = static_cast<float>(position - index);
+                if (index < 0) {
+                    index = 0;
+                    weight = 0.0f;
+                }
+                if (index >= source - 1) {
+                    index = source - 1;
+                    weight = 0.0f;
+                }
+                first[i] = index * stride;
+                second[i] = std::min(index + 1, source - 1) * stride;
+                alpha[i] = weight;
+            }
+        };
+        axis(source_size.width, target_size.width, 3, x0_offset_, x1_offset_, x_alpha_);
+        axis(source_size.height, target_size.height, 1, y0_, y1_, y_alpha_);
+        gather_width_ = 0;
+        while (gather_width_ < target_size.width && x1_offset_[gather_width_] + 4 <= source_size.width * 3) {
+            gather_width_++;
+        }
+        for (auto& row : rows_) {
+            row.resize(3 * static_cast<size_t>(target_size.width));
+        }
+    }
+
+    /**
+     * @brief Set the part of one tensor plane outside content to value
+     */
+    template <typename T>
+    void fillBorder(T* plane, const cv::Rect& content, T value) const {
+        const int width = input_size_.width;
+        const auto rows = [&](int first, int last) {
+            std::fill(plane + static_cast<size_t>(first) * width, plane + static_cast<size_t>(last) * width, value);
+        };
+        rows(0, content.y);
+        if (content.x > 0 || content.width < width) {
+            for (int y = content.y; y < content.y + content.height; ++y) {
+                T* row = plane + static_cast<size_t>(y) * width;
+                std::fill(row, row + content.x, value);
+                std::fill(row + content.x + content.width, row + width, value);
+            }
+        }
+        rows(content.y + content.height, input_size_.height);
+    }
+
+    // out = h0 * w0 + h1 * w1 + bias
+
+    static void blendRowScalar(const float* h0, const float* h1, float w0, float w1, float bias, float* out, int n) {
+        for (int x = 0; x < n; ++x) {
+            out[x] = h0[x] * w0 + h1[x] * w1 + bias;
+        }
+    }
+
+    static void blendQuantizeRowScalar(const float* h0, const float* h1, float w0, float w1, float bias, int8_t* out, int n) {
+        for (int x = 0; x < n; ++x) {
+            long q = std::lrint(h0[x] * w0 + h1[x] * w1 + bias);
+            out[x] = static_cast<int8_t>(std::max(-128L, std::min(127L, q)));
+        }
+    }
+
+#if defined(SIMD_DISPATCH_X86)
+    SIMD_TARGET("avx2,fma")
+    static int interpolateRowAvx2(const uchar* row, const int* x0, const int* x1, const float* alpha, int n,
+                                  int red, int blue, float* const* out) {
+        const int* base = reinterpret_cast<const int*>(row);
+        const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+        const __m128i shifts[3] = {_mm_cvtsi32_si128(8 * red), _mm_cvtsi32_si128(8), _mm_cvtsi32_si128(8 * blue)};
+        int x = 0;
+        for (; x + 8 <= n; x += 8) {
+            // One 32-bit load per pixel picks up its three channels (and a byte of the next pixel)
+            __m256i left = _mm256_i32gather_epi32(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x0 + x)), 1);
+            __m256i right = _mm256_i32gather_epi32(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x1 + x)), 1);
+            __m256 a = _mm256_loadu_ps(alpha + x);
+            for (int c = 0; c < 3; ++c) {
+                __m256 p0 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(left, shifts[c]), byte_mask));
+                __m256 p1 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srl_epi32(right, shifts[c]), byte_mask));
+                _mm256_storeu_ps(out[c] + x, _mm256_fmadd_ps(a, _mm256_sub_ps(p1, p0), p0));
+            }
+        }
+        return x;
+    }
+
+    SIMD_TARGET("avx2,fma")
+    static void blendRowAvx2(const float* h0, const float* h1, float w0, float w1, float bias, float* out, int n) {
+        const __m256 vw0 = _mm256_set1_ps(w0), vw1 = _mm256_set1_ps(w1), vbias = _mm256_set1_ps(bias);
+        int x = 0;
+        for (; x + 8 <= n; x += 8) {
+            __m256 v = _mm256_fmadd_ps(_mm256_loadu_ps(h1 + x), vw1, vbias);
+            _mm256_storeu_ps(out + x, _mm256_fmadd_ps(_mm256_loadu_ps(h0 + x), vw0, v));
+        }
+        blendRowScalar(h0 + x, h1 + x, w0, w1, bias, out + x, n - x);
+    }
+
+    SIMD_TARGET("avx2,fma")
+    static void blendQuantizeRowAvx2(const float* h0, const float* h1, float w0, float w1, float bias, int8_t* out, int n) {
+        const __m256 vw0 = _mm256_set1_ps(w0), vw1 = _mm256_set1_ps(w1), vbias = _mm256_set1_ps(bias);
+        int x = 0;
+        for (; x + 8 <= n; x += 8) {
+            __m256 v = _mm256_fmadd_ps(_mm256_loadu_ps(h1 + x), vw1, vbias);
+            __m256i q = _mm256_cvtps_epi32(_mm256_fmadd_ps(_mm256_loadu_ps(h0 + x), vw0, v));
+            __m128i q16 = _mm_packs_epi32(_mm256_castsi256_si128(q), _mm256_extracti128_si256(q, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + x), _mm_packs_epi16(q16, q16));
+        }
+        blendQuantizeRowScalar(h0 + x, h1 + x, w0, w1, bias, out + x, n - x);
+    }
+
+    SIMD_TARGET("avx512f")
+    static void blendRowAvx512(const float* h0, const float* h1, float w0, float w1, float bias, float* out, int n) {
+        const __m512 vw0 = _mm512_set1_ps(w0), vw1 = _mm512_set1_ps(w1), vbias = _mm512_set1_ps(bias);
+        int x = 0;
+        for (; x + 16 <= n; x += 16) {
+            __m512 v = _mm512_fmadd_ps(_mm512_loadu_ps(h1 + x), vw1, vbias);
+            _mm512_storeu_ps(out + x, _mm512_fmadd_ps(_mm512_loadu_ps(h0 + x), vw0, v));
+        }
+        blendRowScalar(h0 + x, h1 + x, w0, w1, bias, out + x, n - x);
+    }
+
+    SIMD_TARGET("avx512f")
+    static void blendQuantizeRowAvx512(const float* h0, const float* h1, float w0, float w1, float bias, int8_t* out, int n) {
+        const __m512 vw0 = _mm512_set1_ps(w0), vw1 = _mm512_set1_ps(w1), vbias = _mm512_set1_ps(bias);
+        int x = 0;
+        for (; x + 16 <= n; x += 16) {
+            __m512 v = _mm512_fmadd_ps(_mm512_loadu_ps(h1 + x), vw1, vbias);
+            // Masked forms: the unmasked ones trip GCC's -Wmaybe-uninitialized on their undefined pass-through
+            __m512i q = _mm512_maskz_cvtps_epi32(0xFFFF, _mm512_fmadd_ps(_mm512_loadu_ps(h0 + x), vw0, v));
+            _mm512_mask_cvtsepi32_storeu_epi8(out + x, 0xFFFF, q);
+        }
+        blendQuantizeRowScalar(h0 + x, h1 + x, w0, w1, bias, out + x, n - x);
+    }
+#endif
+
+#if defined(SIMD_DISPATCH_NEON)
+    static void blendRowNeon(const float* h0, const float* h1, float w0, float w1, float bias, float* out, int n) {
+        const float32x4_t vw0 = vdupq_n_f32(w0), vw1 = vdupq_n_f32(w1), vbias = vdupq_n_f32(bias);
+        int x = 0;
+        for (; x + 4 <= n; x += 4) {
+            float32x4_t v = vfmaq_f32(vbias, vld1q_f32(h1 + x), vw1);
+            vst1q_f32(out + x, vfmaq_f32(v, vld1q_f32(h0 + x), vw0));
+        }
+        blendRowScalar(h0 + x, h1 + x, w0, w1, bias, out + x, n - x);
+    }
+
+    static void blendQuantizeRowNeon(const float* h0, const float* h1, float w0, float w1, float bias, int8_t* out, int n) {
+        const float32x4_t vw0 = vdupq_n_f32(w0), vw1 = vdupq_n_f32(w1), vbias = vdupq_n_f32(bias);
+        int x = 0;
+        for (; x + 8 <= n; x += 8) {
+            float32x4_t lo = vfmaq_f32(vfmaq_f32(vbias, vld1q_f32(h1 + x), vw1), vld1q_f32(h0 + x), vw0);
+            float32x4_t hi = vfmaq_f32(vfmaq_f32(vbias, vld1q_f32(h1 + x + 4), vw1), vld1q_f32(h0 + x + 4), vw0);
+            int16x8_t q16 = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(lo)), vqmovn_s32(vcvtnq_s32_f32(hi)));
+            vst1_s8(out + x, vqmovn_s16(q16));
+        }
+        blendQuantizeRowScalar(h0 + x, h1 + x, w0, w1, bias, out + x, n - x);
+    }
+#endif
+};
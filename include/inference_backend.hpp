@@ -0,0 +1,555 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "logger.hpp"
+#include "mapped_file.hpp"
+#include "fused_preprocess.hpp"
+#include "json_escape.hpp"
+
+/**
+ * @brief Model configuration
+ */
+struct ModelConfig {
+    std::string backend = "opencv_dnn"; // Registered backend name
+    std::string model_path;             // Model file; empty = no model
+    int input_width = 224;              // Network input size
+    int input_height = 224;
+    double scale = 1.0 / 255.0;         // Pixel scale applied before mean subtraction
+    cv::Scalar mean = cv::Scalar();     // Per-channel mean (after scaling)
+    bool swap_rb = true;                // BGR frames -> RGB network input
+    bool fused_preprocess = true;       // BGR8 frames through FusedPreprocessor instead of blobFromImages
+    int warmup_runs = 3;                // Forward passes after setup, before serving
+    bool map_weights = true;            // Read the model file through a shared read-only mapping
+    std::string cache_dir;              // Optimized-network cache directory; empty = no cache
+};
+
+/**
+ * @brief How the model weights were read
+ */
+struct ModelWeightsInfo {
+    size_t file_bytes = 0;
+    bool mapped = false;       // Parsed straight from a MAP_SHARED mapping instead of a heap copy
+    bool zero_copy = false;    // Tensors still reference the mapping after load
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"file_bytes\":" << file_bytes << ",";
+        json << "\"mapped\":" << (mapped ? "true" : "false") << ",";
+        json << "\"zero_copy\":" << (zero_copy ? "true" : "false");
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Outcome of the optimized-network cache for the last load
+ */
+struct NetworkCacheStatus {
+    bool enabled = false;
+    std::string key;               // Backend name + hash of model, runtime, CPU features, input size
+    std::string state = "disabled"; // disabled, hit, stored, unsupported, error
+    size_t artifact_bytes = 0;
+    double key_ms = 0.0;           // Hashing the model file
+    double io_ms = 0.0;            // Reading or writing the artifact
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(2);
+        json << "{";
+        json << "\"enabled\":" << (enabled ? "true" : "false") << ",";
+        json << "\"state\":\"" << state << "\",";
+        json << "\"key\":\"" << key << "\",";
+        json << "\"artifact_bytes\":" << artifact_bytes << ",";
+        json << "\"key_ms\":" << key_ms << ",";
+        json << "\"io_ms\":" << io_ms;
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Model load timings in milliseconds
+ */
+struct ModelLoadTimings {
+    double parse_ms = 0.0;     // Reading and parsing the model file
+    double setup_ms = 0.0;     // Backend selection and first forward (graph init, buffer allocation)
+    double warmup_ms = 0.0;    // Remaining warm-up passes
+    int warmup_runs = 0;
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(2);
+        json << "{";
+        json << "\"parse_ms\":" << parse_ms << ",";
+        json << "\"setup_ms\":" << setup_ms << ",";
+        json << "\"warmup_ms\":" << warmup_ms << ",";
+        json << "\"warmup_runs\":" << warmup_runs << ",";
+        json << "\"total_ms\":" << (parse_ms + setup_ms + warmup_ms);
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Decoded result for one image
+ */
+struct InferenceResult {
+    int top_index = -1;        // Highest-scoring element of the primary output
+    float top_score = 0.0f;
+    size_t num_scores = 0;     // Elements per image in the primary output
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        json << "\"top_index\":" << top_index << ",";
+        json << "\"top_score\":" << top_score << ",";
+        json << "\"num_scores\":" << num_scores;
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Inference Backend Interface
+ *
+ * One loaded model on one runtime. runBatch() takes BGR8 images of any
+ * size and returns the raw output tensors with the batch as the first
+ * dimension; decode() turns those into one InferenceResult per image.
+ * Backends are created by name through create(), so the service can switch
+ * runtimes from configuration and the same pipeline can benchmark them.
+ *
+ * Implementations must allow runBatch() from several threads at once
+ * (serializing internally if the runtime needs it).
+ */
+class InferenceBackend {
+public:
+    using Factory = std::function<std::unique_ptr<InferenceBackend>()>;
+
+    virtual ~InferenceBackend() = default;
+
+    /**
+     * @brief Registered name of this backend
+     */
+    virtual std::string getName() const = 0;
+
+    /**
+     * @brief Whether load() needs ModelConfig::model_path
+     */
+    virtual bool requiresModelFile() const {
+        return true;
+    }
+
+    /**
+     * @brief Load, set up and warm up the model
+     */
+    virtual bool load(const ModelConfig& config) = 0;
+
+    virtual bool isLoaded() const = 0;
+
+    /**
+     * @brief Input tensor shape for a batch of one (NCHW)
+     */
+    virtual std::vector<int> getInputShape() const = 0;
+
+    /**
+     * @brief Run a batch of BGR8 images
+     *
+     * @param outputs One tensor per network output, batch dimension first
+     */
+    virtual bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) = 0;
+
+    /**
+     * @brief Decode batched outputs into one result per image
+     *
+     * Default: arg-max over each image's slice of the first output.
+     */
+    virtual std::vector<InferenceResult> decode(const std::vector<cv::Mat>& outputs, size_t batch_size) const {
+        std::vector<InferenceResult> results(batch_size);
+        if (outputs.empty() || batch_size == 0 || outputs[0].depth() != CV_32F || outputs[0].total() % batch_size != 0) {
+            return results;
+        }
+
+        cv::Mat scores = outputs[0].reshape(1, static_cast<int>(batch_size));
+        for (size_t i = 0; i < batch_size; ++i) {
+            double max_value = 0.0;
+            int max_index[2] = {0, 0};
+            cv::minMaxIdx(scores.row(static_cast<int>(i)), nullptr, &max_value, nullptr, max_index);
+            results[i].top_index = max_index[1];
+            results[i].top_score = static_cast<float>(max_value);
+            results[i].num_scores = static_cast<size_t>(scores.cols);
+        }
+        return results;
+    }
+
+    virtual std::vector<std::string> getOutputNames() const {
+        return {};
+    }
+
+    /**
+     * @brief Runtime and version the optimized network depends on (part of the cache key)
+     */
+    virtual std::string getRuntimeVersion() const {
+        return "";
+    }
+
+    /**
+     * @brief Whether this backend implements exportOptimized()/loadOptimized()
+     *
+     * When false the network cache neither hashes the model file nor touches
+     * the cache directory.
+     */
+    virtual bool supportsOptimizedExport() const {
+        return false;
+    }
+
+    /**
+     * @brief Serialize the post-optimization network after load() (fused graph, packed weights, kernel choices)
+     *
+     * @return false if the runtime cannot export it; the network cache then has nothing to store
+     */
+    virtual bool exportOptimized(std::vector<uint8_t>& artifact) const {
+        (void)artifact;
+        return false;
+    }
+
+    /**
+     * @brief Load from an exportOptimized() artifact instead of parsing and optimizing, then warm up
+     *
+     * @return false to fall back to load()
+     */
+    virtual bool loadOptimized(const ModelConfig& config, const std::vector<uint8_t>& artifact) {
+        (void)config;
+        (void)artifact;
+        return false;
+    }
+
+    const ModelConfig& getConfig() const { return config_; }
+    const ModelLoadTimings& getLoadTimings() const { return timings_; }
+    const ModelWeightsInfo& getWeightsInfo() const { return weights_; }
+    const NetworkCacheStatus& getNetworkCacheStatus() const { return network_cache_; }
+
+    void setNetworkCacheStatus(const NetworkCacheStatus& status) {
+        network_cache_ = status;
+    }
+
+    /**
+     * @brief Backend, model and load timings as a JSON object
+     */
+    std::string getInfoJson() const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"loaded\":" << (isLoaded() ? "true" : "false") << ",";
+        json << "\"backend\":\"" << getName() << "\",";
+        json << "\"path\":\"" << jsonEscape(config_.model_path) << "\",";
+        json << "\"input\":[";
+        std::vector<int> shape = getInputShape();
+        for (size_t i = 0; i < shape.size(); ++i) {
+            if (i > 0) json << ",";
+            json << shape[i];
+        }
+        json << "],";
+        json << "\"outputs\":[";
+        std::vector<std::string> names = getOutputNames();
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (i > 0) json << ",";
+            json << "\"" << names[i] << "\"";
+        }
+        json << "],";
+        json << "\"weights\":" << weights_.toJson() << ",";
+        json << "\"network_cache\":" << network_cache_.toJson() << ",";
+        json << "\"load_time\":" << timings_.toJson();
+        json << "}";
+        return json.str();
+    }
+
+    /**
+     * @brief Create a backend by registered name ("opencv_dnn", "reference", ...)
+     *
+     * @return nullptr for unknown names
+     */
+    static std::unique_ptr<InferenceBackend> create(const std::string& name);
+
+    /**
+     * @brief Register an additional backend (replaces one with the same name)
+     */
+    static void registerBackend(const std::string& name, Factory factory);
+
+    static std::vector<std::string> getBackendNames();
+
+protected:
+    ModelConfig config_;
+    ModelLoadTimings timings_;
+    ModelWeightsInfo weights_;
+    NetworkCacheStatus network_cache_;
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static std::string formatMs(double ms) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << ms << "ms";
+        return out.str();
+    }
+
+private:
+    struct Registry {
+        std::mutex mutex;
+        std::map<std::string, Factory> factories;
+    };
+
+    static Registry& registry();
+};
+
+/**
+ * @brief ONNX (and other formats readNet accepts) on the OpenCV DNN CPU backend
+ *
+ * OpenCV builds the graph lazily on the first forward, so load() runs that
+ * pass itself (setup) followed by warm-up passes; the first real frame then
+ * pays nothing extra. cv::dnn::Net is not safe for concurrent forward calls,
+ * so runBatch() serializes.
+ *
+ * ONNX files are parsed straight from a shared read-only mapping, which
+ * skips the heap copy of the file and lets other processes reuse the same
+ * page-cache pages while they load. OpenCV DNN copies every initializer
+ * into its own blobs during parsing, so the mapping is released once the
+ * graph is built; the weights themselves are not shared across processes
+ * with this backend (weights.zero_copy is false).
+ */
+class OpenCvDnnBackend : public InferenceBackend {
+public:
+    std::string getName() const override {
+        return "opencv_dnn";
+    }
+
+    bool load(const ModelConfig& config) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        timings_ = ModelLoadTimings();
+        weights_ = ModelWeightsInfo();
+        loaded_ = false;
+
+        try {
+            auto parse_start = std::chrono::steady_clock::now();
+            if (config.map_weights && isOnnx(config.model_path)) {
+                MappedFile file;
+                if (!file.open(config.model_path)) {
+                    logger_.error("Model file could not be mapped: " + config.model_path);
+                    return false;
+                }
+                file.prefetch();
+                net_ = cv::dnn::readNetFromONNX(reinterpret_cast<const char*>(file.data()), file.size());
+                weights_.file_bytes = file.size();
+                weights_.mapped = true;
+            } else {
+                net_ = cv::dnn::readNet(config.model_path);
+                std::error_code size_error;
+                uintmax_t file_bytes = std::filesystem::file_size(config.model_path, size_error);
+                weights_.file_bytes = size_error ? 0 : static_cast<size_t>(file_bytes);
+            }
+            timings_.parse_ms = elapsedMs(parse_start);
+            if (net_.empty()) {
+                logger_.error("Model file could not be parsed: " + config.model_path);
+                return false;
+            }
+            output_names_ = net_.getUnconnectedOutLayersNames();
+            logger_.info("Model parsed in " + formatMs(timings_.parse_ms) + " (" + config.model_path + ")");
+
+            preprocessor_.reset();
+            if (config.fused_preprocess) {
+                preprocessor_ = std::make_unique<FusedPreprocessor>(cv::Size(config.input_width, config.input_height),
+                                                                    config.scale, config.mean, config.swap_rb);
+                logger_.info("Fused preprocessing enabled (" + simdPathToString(preprocessor_->getPath()) + ")");
+            }
+
+            auto setup_start = std::chrono::steady_clock::now();
+            net_.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+            net_.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+            std::vector<cv::Mat> dummy(1, cv::Mat(config.input_height, config.input_width, CV_8UC3, cv::Scalar(0, 0, 0)));
+            std::vector<cv::Mat> outputs;
+            forwardLocked(dummy, outputs);
+            timings_.setup_ms = elapsedMs(setup_start);
+            logger_.info("Model graph set up in " + formatMs(timings_.setup_ms));
+
+            auto warmup_start = std::chrono::steady_clock::now();
+            for (int i = 0; i < config.warmup_runs; ++i) {
+                forwardLocked(dummy, outputs);
+            }
+            timings_.warmup_runs = config.warmup_runs;
+            timings_.warmup_ms = elapsedMs(warmup_start);
+            logger_.info("Model warmed up with " + std::to_string(config.warmup_runs) + " runs in " +
+                         formatMs(timings_.warmup_ms));
+        } catch (const cv::Exception& e) {
+            logger_.error("OpenCV error while loading model: " + std::string(e.what()));
+            return false;
+        }
+
+        loaded_ = true;
+        return true;
+    }
+
+    bool isLoaded() const override {
+        return loaded_;
+    }
+
+    std::vector<int> getInputShape() const override {
+        return {1, 3, config_.input_height, config_.input_width};
+    }
+
+    bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loaded_ || images.empty()) {
+            return false;
+        }
+        try {
+            forwardLocked(images, outputs);
+            return true;
+        } catch (const cv::Exception& e) {
+            logger_.error("OpenCV error during inference: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    std::vector<std::string> getOutputNames() const override {
+        return output_names_;
+    }
+
+    std::string getRuntimeVersion() const override {
+        return std::string("OpenCV ") + CV_VERSION;
+    }
+
+    // supportsOptimizedExport()/exportOptimized()/loadOptimized() keep the
+    // defaults: cv::dnn::Net has no API to serialize its fused graph, packed
+    // weights or kernel choices, so a load always parses and re-optimizes. The
+    // network cache skips it and reports "unsupported".
+
+private:
+    cv::dnn::Net net_;
+    std::vector<std::string> output_names_;
+    cv::Mat blob_;                 // Reused input tensor
+    std::unique_ptr<FusedPreprocessor> preprocessor_;
+    std::atomic<bool> loaded_{false};
+    std::mutex mutex_;
+    ModuleLogger logger_{"MODEL"};
+
+    static bool isOnnx(const std::string& path) {
+        return path.size() >= 5 && path.compare(path.size() - 5, 5, ".onnx") == 0;
+    }
+
+    // Caller holds mutex_
+    void forwardLocked(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) {
+        bool bgr8 = std::all_of(images.begin(), images.end(), [](const cv::Mat& image) { return image.type() == CV_8UC3; });
+        if (!preprocessor_ || !bgr8 || !preprocessor_->runBatch(images, blob_)) {
+            cv::dnn::blobFromImages(images, blob_, config_.scale, cv::Size(config_.input_width, config_.input_height),
+                                    config_.mean, config_.swap_rb, false, CV_32F);
+        }
+        net_.setInput(blob_);
+        net_.forward(outputs, output_names_);
+    }
+};
+
+/**
+ * @brief Model-free backend for tests and pipeline benchmarks
+ *
+ * Outputs the mean of each colour channel in [0,1] (B, G, R order), so
+ * decode() reports the dominant channel. Cost is one pass over the image,
+ * which keeps the rest of the pipeline measurable without a model file.
+ */
+class ReferenceBackend : public InferenceBackend {
+public:
+    std::string getName() const override {
+        return "reference";
+    }
+
+    bool requiresModelFile() const override {
+        return false;
+    }
+
+    bool load(const ModelConfig& config) override {
+        config_ = config;
+        timings_ = ModelLoadTimings();
+        loaded_ = true;
+        return true;
+    }
+
+    bool isLoaded() const override {
+        return loaded_;
+    }
+
+    std::vector<int> getInputShape() const override {
+        return {1, 3, config_.input_height, config_.input_width};
+    }
+
+    bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) override {
+        if (!loaded_ || images.empty()) {
+            return false;
+        }
+        cv::Mat scores(static_cast<int>(images.size()), 3, CV_32F, cv::Scalar(0));
+        for (size_t i = 0; i < images.size(); ++i) {
+            cv::Scalar channel_mean = cv::mean(images[i]);
+            for (int c = 0; c < 3; ++c) {
+                scores.at<float>(static_cast<int>(i), c) = static_cast<float>(channel_mean[c] / 255.0);
+            }
+        }
+        outputs.assign(1, scores);
+        return true;
+    }
+
+    std::vector<std::string> getOutputNames() const override {
+        return {"channel_mean"};
+    }
+
+private:
+    std::atomic<bool> loaded_{false};
+};
+
+inline InferenceBackend::Registry& InferenceBackend::registry() {
+    static Registry instance;
+    static std::once_flag builtins;
+    std::call_once(builtins, []() {
+        instance.factories["opencv_dnn"] = []() { return std::make_unique<OpenCvDnnBackend>(); };
+        instance.factories["reference"] = []() { return std::make_unique<ReferenceBackend>(); };
+    });
+    return instance;
+}
+
+inline std::unique_ptr<InferenceBackend> InferenceBackend::create(const std::string& name) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = reg.factories.find(name);
+    if (it == reg.factories.end()) {
+        return nullptr;
+    }
+    return it->second();
+}
+
+inline void InferenceBackend::registerBackend(const std::string& name, Factory factory) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.factories[name] = std::move(factory);
+}
+
+inline std::vector<std::string> InferenceBackend::getBackendNames() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<std::string> names;
+    for (const auto& entry : reg.factories) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
@@ -6,10 +6,73 @@
 #include <iomanip>
 #include <thread>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <vector>
+#include <future>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <opencv2/opencv.hpp>
 #include "performance_monitor.hpp"
 #include "logger.hpp"
 #include "web_api_server.hpp"
+#include "video_stream.hpp"
+#include "thread_pool.hpp"
+#include "display_sink.hpp"
+#include "inference_backend.hpp"
+#include "batch_scheduler.hpp"
+#include "result_cache.hpp"
+#include "model_pipeline.hpp"
+#include "network_cache.hpp"
+#include "thread_topology.hpp"
+
+/**
+ * @brief Outcome of one inference request
+ */
+enum class InferenceStatus {
+    OK,
+    REJECTED,        // In-flight limit reached; nothing was queued
+    NO_MODEL,        // No backend loaded
+    INVALID_INPUT,   // Input is not a decodable image
+    FAILED           // Backend error
+};
+
+inline std::string inferenceStatusToString(InferenceStatus status) {
+    switch (status) {
+        case InferenceStatus::OK: return "ok";
+        case InferenceStatus::REJECTED: return "rejected";
+        case InferenceStatus::NO_MODEL: return "no_model";
+        case InferenceStatus::INVALID_INPUT: return "invalid_input";
+        case InferenceStatus::FAILED: return "failed";
+        default: return "failed";
+    }
+}
+
+/**
+ * @brief Inference request result
+ */
+struct InferenceResponse {
+    InferenceStatus status = InferenceStatus::FAILED;
+    InferenceResult result;      // Valid when status is OK
+    double inference_ms = 0.0;   // Decode + inference, excluding time queued for a worker
+    bool cached = false;         // Served from the result cache
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        json << "\"status\":\"" << inferenceStatusToString(status) << "\"";
+        if (status == InferenceStatus::OK) {
+            json << ",\"inference_ms\":" << inference_ms;
+            json << ",\"cached\":" << (cached ? "true" : "false");
+            json << ",\"result\":" << result.toJson();
+        }
+        json << "}";
+        return json.str();
+    }
+};
 
 /**
  * @brief Inference Service Class - Header-only implementation
@@ -29,7 +92,10 @@ public:
     }
 
     /**
-     * @brief Run inference service
+     * @brief Run the frame processing loop until shutdown
+     *
+     * Sleeps until a frame lands, a stream stops or shutdown is requested;
+     * returns when shutdown is requested, all streams are gone or ESC is pressed.
      */
     void run() {
         pImpl->run();
@@ -42,29 +108,239 @@ public:
         pImpl->stop();
     }
 
+    using InferenceCallback = std::function<void(const InferenceResponse&)>;
+
     /**
-     * @brief Execute inference
+     * @brief Execute inference on one encoded image (JPEG, PNG, ...) and wait
+     *
+     * Thin wrapper over inferenceAsync(); subject to the same in-flight limit.
+     *
+     * @return InferenceResponse as JSON
      */
     std::string inference(const std::string& input) {
-        return pImpl->inference(input);
+        return pImpl->inferenceAsync(input).get().toJson();
+    }
+
+    /**
+     * @brief Queue inference on one encoded image without blocking
+     *
+     * Decoding and inference run on the worker pool (and through the batch
+     * scheduler when batching is on). When the in-flight limit is reached
+     * the returned future is already ready with status REJECTED.
+     */
+    std::future<InferenceResponse> inferenceAsync(const std::string& input) {
+        return pImpl->inferenceAsync(input);
+    }
+
+    /**
+     * @brief Queue inference and call back on completion (from a worker thread)
+     *
+     * @return OK when queued, REJECTED when the in-flight limit is reached
+     *         (the callback is then not called)
+     */
+    InferenceStatus inferenceAsync(const std::string& input, InferenceCallback callback) {
+        return pImpl->submitInference(input, std::move(callback));
     }
 
     /**
-     * @brief Start camera capture
+     * @brief Limit on queued plus running inference requests (0 = unlimited)
+     */
+    void setMaxInFlight(size_t max_in_flight) {
+        pImpl->max_in_flight = max_in_flight;
+    }
+
+    size_t getInFlightRequests() const {
+        return pImpl->in_flight_requests;
+    }
+
+    /**
+     * @brief Set capture configuration (applies to streams started afterwards)
+     */
+    void setCaptureConfig(const CaptureConfig& config) {
+        pImpl->capture_config = config;
+    }
+
+    /**
+     * @brief Set rate control and frame age budget (applies to streams started afterwards)
+     */
+    void setRateControl(const RateControlConfig& config) {
+        pImpl->stream_options.rate_control = config;
+    }
+
+    /**
+     * @brief Set the static-scene change gate (applies to streams started afterwards)
+     */
+    void setChangeGate(const ChangeGateConfig& config) {
+        pImpl->stream_options.change_gate = config;
+    }
+
+    /**
+     * @brief Set model configuration (applies on initialize)
+     *
+     * ModelConfig::backend selects the runtime by registered name. A backend
+     * that needs a model file runs the pipeline without inference when the
+     * model path is empty.
+     */
+    void setModelConfig(const ModelConfig& config) {
+        pImpl->model_config = config;
+    }
+
+    /**
+     * @brief Load a model in the background and swap it in once warmed up
+     *
+     * Frames keep flowing on the current model during the load; requests in
+     * flight at the swap finish on the old model.
+     *
+     * @return false if a reload is already running or the service was stopped
+     */
+    bool reloadModel(const ModelConfig& config) {
+        return pImpl->reloadModel(config);
+    }
+
+    /**
+     * @brief Set request batching (applies on initialize)
+     *
+     * With max_batch_size above 1, frames from all streams and inference()
+     * calls are batched in front of the backend; streams started with
+     * StreamOptions::latency_critical bypass the batcher.
+     */
+    void setBatching(const BatchSchedulerConfig& config) {
+        pImpl->batch_config = config;
+    }
+
+    /**
+     * @brief Set the inference() result cache (applies on initialize)
+     *
+     * Identical encoded inputs are answered from memory until the model is
+     * reloaded. Camera frames are not cached.
+     */
+    void setResultCache(const ResultCacheConfig& config) {
+        pImpl->result_cache_config = config;
+    }
+
+    /**
+     * @brief Run a multi-model pipeline on stream frames instead of the single model
+     *
+     * inference() keeps using the single model. Pass null to go back to it.
+     * Each stream's PipelineResult is available through getStreamResult().
+     */
+    void setPipeline(std::shared_ptr<ModelPipeline> pipeline) {
+        std::atomic_store(&pImpl->pipeline, std::move(pipeline));
+    }
+
+    /**
+     * @brief Set number of shared inference worker threads (applies on initialize, 0 = auto)
+     */
+    void setInferenceWorkers(size_t count) {
+        pImpl->inference_workers = count;
+    }
+
+    /**
+     * @brief Set OpenCV's thread count and per-role CPU pinning (applies on initialize)
+     *
+     * Threads already running (e.g. the logger) are re-pinned; the applied
+     * mapping is reported under "threads" on /info.
+     */
+    void setThreadTopology(const ThreadTopologyConfig& config) {
+        pImpl->thread_topology = config;
+    }
+
+    /**
+     * @brief Set display configuration (applies on initialize)
+     *
+     * Headless mode makes no HighGUI calls at all; otherwise a preview
+     * thread shows the latest frames at a capped rate.
+     */
+    void setDisplayConfig(const DisplayConfig& config) {
+        pImpl->display_config = config;
+    }
+
+    /**
+     * @brief Ask the service to shut down (ESC in preview, POST /service/stop, signals)
+     *
+     * processFrame() returns false once this is set.
+     */
+    void requestShutdown() {
+        pImpl->requestShutdown();
+    }
+
+    /**
+     * @brief Check whether shutdown was requested
+     */
+    bool isShutdownRequested() const {
+        return pImpl->shutdown_requested;
+    }
+
+    /**
+     * @brief Start camera capture as stream "camera<id>"
      */
     bool startCamera(int camera_id = 0) {
         return pImpl->startCamera(camera_id);
     }
 
     /**
-     * @brief Stop camera capture
+     * @brief Stop all camera streams
      */
     void stopCamera() {
         pImpl->stopCamera();
     }
 
     /**
-     * @brief Process camera frame
+     * @brief Start a named camera stream
+     */
+    bool startStream(const std::string& name, int camera_id) {
+        return pImpl->startStream(name, "camera:" + std::to_string(camera_id), pImpl->stream_options);
+    }
+
+    /**
+     * @brief Start a named stream from any frame source
+     *
+     * @param source_uri camera:<id>, file:<path>, dir:<path> or synthetic:<w>x<h>[@<fps>]
+     */
+    bool startStream(const std::string& name, const std::string& source_uri) {
+        return pImpl->startStream(name, source_uri, pImpl->stream_options);
+    }
+
+    /**
+     * @brief Start a named stream with its own rate control and change gate settings
+     */
+    bool startStream(const std::string& name, const std::string& source_uri, const StreamOptions& options) {
+        return pImpl->startStream(name, source_uri, options);
+    }
+
+    /**
+     * @brief Stop a named camera stream
+     */
+    bool stopStream(const std::string& name) {
+        return pImpl->stopStream(name);
+    }
+
+    /**
+     * @brief Get names of all active streams
+     */
+    std::vector<std::string> getStreamNames() const {
+        return pImpl->getStreamNames();
+    }
+
+    /**
+     * @brief Get the latest result of a stream
+     *
+     * Frames the change gate skipped carry the last processed frame's
+     * result (reused is set). The same result is under "last_result" in
+     * the stream's /metrics entry.
+     *
+     * @return false for an unknown stream or one with no result yet
+     */
+    bool getStreamResult(const std::string& name, StreamResult& result) const {
+        std::shared_ptr<VideoStream> stream = pImpl->findStream(name);
+        return stream && stream->getLastResult(result);
+    }
+
+    /**
+     * @brief Process the freshest frame of every stream
+     *
+     * Blocks until a frame lands, a stream stops or shutdown is requested.
+     * Returns false on shutdown or when no stream can deliver frames anymore.
      */
     bool processFrame() {
         return pImpl->processFrame();
@@ -115,11 +391,88 @@ public:
 private:
     class Impl {
     public:
-        bool running = false;
-        bool camera_running = false;
-        cv::VideoCapture camera;
-        cv::Mat current_frame;
-        PerformanceMonitor performance_monitor;
+        ~Impl() {
+            // Capture threads call notifyFrameEvent(); join them before anything they touch goes away
+            stopCamera();
+            stopReloads();
+            // Queued tasks use the backend and scheduler, which are destroyed before the pool
+            if (worker_pool) {
+                worker_pool->shutdown();
+            }
+        }
+        
+        /**
+         * @brief Frame taken from a stream for one processing pass
+         */
+        struct StreamFrame {
+            std::shared_ptr<VideoStream> stream;
+            PooledFrame frame;
+            FrameMetadata metadata;
+        };
+        
+        std::atomic<bool> running{false};
+        CaptureConfig capture_config;
+        StreamOptions stream_options;  // Defaults for new streams
+        size_t inference_workers = 0;  // 0 = one per hardware thread
+        ThreadTopologyConfig thread_topology;
+        DisplayConfig display_config;
+        ModelConfig model_config;
+        BatchSchedulerConfig batch_config;
+        ResultCacheConfig result_cache_config;
+        std::atomic<size_t> max_in_flight{64};
+        std::atomic<bool> shutdown_requested{false};
+        PerformanceMonitor performance_monitor;  // Times each processing pass over all streams
+        LatencyHistogram capture_to_result_latency;  // All streams; the end-to-end SLA number
+        
+        // Frame arrival notification from capture threads
+        std::mutex frame_event_mutex;
+        std::condition_variable frame_event_cv;
+        uint64_t pending_frame_events = 0;
+        
+        // Shared by all streams
+        std::unique_ptr<ThreadPool> worker_pool;
+        
+        // Named input streams; guarded against HTTP control threads. Declared after
+        // the frame-event members and the pool so they are destroyed first
+        std::map<std::string, std::shared_ptr<VideoStream>> streams;
+        mutable std::mutex streams_mutex;
+        
+        // Selected runtime with the loaded model; null when inference is disabled
+        // Swapped by reloadModel(); read through currentBackend() (std::atomic_load)
+        std::shared_ptr<InferenceBackend> backend;
+        std::atomic<uint64_t> model_version{0};  // Incremented on every successful load
+        
+        // Background model reload
+        std::thread reload_thread;
+        std::mutex reload_thread_mutex;         // Guards reload_thread and reloads_stopped
+        bool reloads_stopped = false;           // Set by stop(); later reloads are refused
+        std::atomic<bool> reload_in_progress{false};
+        mutable std::mutex reload_mutex;        // Guards model_config and the last_reload_* fields
+        double last_reload_ms = 0.0;
+        double last_swap_us = 0.0;
+        std::string last_reload_error;
+        
+        // Batches requests in front of the backend; null when batching is off
+        std::unique_ptr<BatchScheduler> batch_scheduler;
+        
+        // Multi-model graph for stream frames; null = single model. Read with std::atomic_load
+        std::shared_ptr<ModelPipeline> pipeline;
+        
+        // inference() results by (input hash, model version); null when disabled
+        std::unique_ptr<ResultCache<InferenceResult>> result_cache;
+        
+        // Asynchronous inference requests
+        std::atomic<size_t> in_flight_requests{0};
+        std::atomic<uint64_t> completed_requests{0};
+        std::atomic<uint64_t> rejected_requests{0};
+        std::atomic<uint64_t> failed_requests{0};
+        
+        // Preview windows; null in headless mode
+        std::unique_ptr<DisplaySink> display_sink;
+        
+        // Reused across passes to avoid per-frame allocation
+        std::vector<StreamFrame> ready_frames;
+        std::vector<std::future<void>> pending_work;
         
         // Web API server
         std::unique_ptr<WebApiServer> web_api_server;
@@ -134,11 +487,48 @@ private:
             main_logger.info("Starting inference engine initialization");
             
             try {
-                // TODO: Add model loading and initialization logic here
-                main_logger.debug("Loading inference models...");
+                applyThreadTopology();
                 
-                // Simulate initialization time
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                // Shared inference worker pool for all streams
+                worker_pool = std::make_unique<ThreadPool>(inference_workers, "WORKERS");
+                main_logger.info("Inference worker pool ready with " + std::to_string(worker_pool->size()) + " threads");
+                
+                if (display_config.headless) {
+                    main_logger.info("Headless mode: preview disabled");
+                } else {
+                    display_sink = std::make_unique<DisplaySink>(display_config.max_fps);
+                    display_sink->setExitCallback([this]() { requestShutdown(); });
+                    display_sink->start();
+                }
+                
+                std::unique_ptr<InferenceBackend> probe = InferenceBackend::create(model_config.backend);
+                if (!probe) {
+                    main_logger.error("Unknown inference backend: " + model_config.backend);
+                    return false;
+                }
+                if (probe->requiresModelFile() && model_config.model_path.empty()) {
+                    main_logger.warn("No model configured, frames pass through without inference");
+                } else {
+                    std::string error;
+                    std::shared_ptr<InferenceBackend> loaded = loadBackend(model_config, error);
+                    if (!loaded) {
+                        main_logger.error(error);
+                        return false;
+                    }
+                    std::atomic_store(&backend, loaded);
+                    model_version++;
+                }
+                
+                // Created even without a model so a later reload can use it
+                if (batch_config.max_batch_size > 1) {
+                    batch_scheduler = std::make_unique<BatchScheduler>(currentBackend(), batch_config);
+                }
+                
+                if (result_cache_config.enabled) {
+                    result_cache = std::make_unique<ResultCache<InferenceResult>>(result_cache_config);
+                    main_logger.info("Result cache enabled (" + std::to_string(result_cache_config.max_bytes / (1024 * 1024)) +
+                                     "MB, " + std::to_string(result_cache_config.shards) + " shards)");
+                }
                 
                 main_logger.info("Inference engine initialized successfully");
                 PERF_LOG_END("INFERENCE", initialization);
@@ -153,61 +543,171 @@ private:
             main_logger.info("Starting inference service main loop");
             running = true;
             
-            // Simple service loop
-            while (running) {
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-                // TODO: Add service processing logic here
-                main_logger.trace("Service heartbeat - main loop iteration");
+            // Event driven: processFrame() sleeps on the frame event until there is work
+            while (running && processFrame()) {
             }
             
+            running = false;
             main_logger.info("Inference service main loop stopped");
         }
         
         void stop() {
             main_logger.info("Stopping inference service");
             running = false;
+            requestShutdown(); // Wakes run() if it is still waiting
+            stopReloads();
+            if (worker_pool) {
+                worker_pool->shutdown(); // Finish queued async requests while the backend is still alive
+            }
+            if (batch_scheduler) {
+                batch_scheduler->shutdown();
+            }
+            if (display_sink) {
+                display_sink->stop();
+                display_sink.reset();
+            }
             main_logger.info("Inference service stopped successfully");
         }
         
-        std::string inference(const std::string& input) {
-            // TODO: Add actual inference logic here
-            return "Inference result: " + input;
+        std::future<InferenceResponse> inferenceAsync(const std::string& input) {
+            auto promise = std::make_shared<std::promise<InferenceResponse>>();
+            std::future<InferenceResponse> future = promise->get_future();
+            InferenceStatus status = submitInference(input, [promise](const InferenceResponse& response) {
+                promise->set_value(response);
+            });
+            if (status == InferenceStatus::REJECTED) {
+                InferenceResponse rejected;
+                rejected.status = InferenceStatus::REJECTED;
+                promise->set_value(rejected);
+            }
+            return future;
+        }
+        
+        InferenceStatus submitInference(const std::string& input, InferenceCallback callback) {
+            // Reserve a slot first so concurrent submitters cannot overshoot the limit
+            size_t limit = max_in_flight;
+            size_t current = in_flight_requests.load();
+            do {
+                if (limit > 0 && current >= limit) {
+                    rejected_requests++;
+                    return InferenceStatus::REJECTED;
+                }
+            } while (!in_flight_requests.compare_exchange_weak(current, current + 1));
+            
+            auto task = [this, input, callback]() {
+                InferenceResponse response = runEncodedInference(input);
+                in_flight_requests--;
+                if (response.status == InferenceStatus::OK) {
+                    completed_requests++;
+                } else {
+                    failed_requests++;
+                }
+                try {
+                    callback(response);
+                } catch (const std::exception& e) {
+                    main_logger.error("Inference callback threw: " + std::string(e.what()));
+                }
+            };
+            
+            try {
+                if (!worker_pool) {
+                    throw std::runtime_error("Inference service is not initialized");
+                }
+                worker_pool->submit(task);
+            } catch (const std::exception& e) {
+                in_flight_requests--;
+                rejected_requests++;
+                main_logger.warn("Inference request rejected: " + std::string(e.what()));
+                return InferenceStatus::REJECTED;
+            }
+            return InferenceStatus::OK;
+        }
+        
+        InferenceResponse runEncodedInference(const std::string& input) {
+            InferenceResponse response;
+            if (!currentBackend()) {
+                response.status = InferenceStatus::NO_MODEL;
+                return response;
+            }
+            
+            auto start = std::chrono::steady_clock::now();
+            // Version is read before the backend: the reload swaps the backend
+            // first, so a result is never filed under a newer version than its model
+            ResultCache<InferenceResult>::Key cache_key;
+            if (result_cache) {
+                cache_key = ResultCache<InferenceResult>::makeKey(input.data(), input.size(), model_version);
+                if (result_cache->get(cache_key, response.result)) {
+                    response.status = InferenceStatus::OK;
+                    response.cached = true;
+                    response.inference_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    return response;
+                }
+            }
+            
+            try {
+                std::vector<uchar> bytes(input.begin(), input.end());
+                cv::Mat image = cv::imdecode(bytes, cv::IMREAD_COLOR);
+                if (image.empty()) {
+                    response.status = InferenceStatus::INVALID_INPUT;
+                    return response;
+                }
+                response.status = runInference(image, false, response.result) ? InferenceStatus::OK : InferenceStatus::FAILED;
+                if (result_cache && response.status == InferenceStatus::OK) {
+                    result_cache->put(cache_key, response.result);
+                }
+            } catch (const std::exception& e) {
+                main_logger.error("Inference failed: " + std::string(e.what()));
+                response.status = InferenceStatus::FAILED;
+            }
+            response.inference_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return response;
+        }
+        
+        std::string getInferenceRequestsJson() const {
+            std::ostringstream json;
+            json << "{";
+            json << "\"in_flight\":" << in_flight_requests << ",";
+            json << "\"max_in_flight\":" << max_in_flight << ",";
+            json << "\"completed\":" << completed_requests << ",";
+            json << "\"rejected\":" << rejected_requests << ",";
+            json << "\"failed\":" << failed_requests;
+            json << "}";
+            return json.str();
         }
         
         bool startCamera(int camera_id = 0) {
-            if (camera_running) {
-                camera_logger.warn("Camera is already running, ignoring start request");
-                return true;
+            return startStream("camera" + std::to_string(camera_id), "camera:" + std::to_string(camera_id), stream_options);
+        }
+        
+        bool startStream(const std::string& name, const std::string& source_uri, const StreamOptions& options) {
+            {
+                std::lock_guard<std::mutex> lock(streams_mutex);
+                if (streams.count(name)) {
+                    camera_logger.warn("Stream '" + name + "' is already running, ignoring start request");
+                    return true;
+                }
             }
             
             PERF_LOG_START("CAMERA", startup);
-            camera_logger.info("Starting camera with device ID: " + std::to_string(camera_id));
+            camera_logger.info("Starting stream '" + name + "' from source: " + source_uri);
             
             try {
-                // Open camera
-                camera.open(camera_id);
-                if (!camera.isOpened()) {
-                    camera_logger.error("Failed to open camera device " + std::to_string(camera_id));
+                auto stream = std::make_shared<VideoStream>(name, capture_config, options);
+                stream->setAggregateMonitor(&performance_monitor);
+                stream->setFrameCallback([this]() { notifyFrameEvent(); });
+                if (!stream->start(source_uri)) {
+                    camera_logger.error("Failed to open frame source " + source_uri);
                     return false;
                 }
                 
-                camera_logger.debug("Camera device opened successfully");
-                
-                // Set camera properties
-                camera.set(cv::CAP_PROP_FRAME_WIDTH, 640);
-                camera.set(cv::CAP_PROP_FRAME_HEIGHT, 480);
-                camera.set(cv::CAP_PROP_FPS, 30);
-                
-                // Log actual camera properties
-                double actual_width = camera.get(cv::CAP_PROP_FRAME_WIDTH);
-                double actual_height = camera.get(cv::CAP_PROP_FRAME_HEIGHT);
-                double actual_fps = camera.get(cv::CAP_PROP_FPS);
-                
-                camera_logger.info("Camera properties set - Resolution: " + 
-                                 std::to_string((int)actual_width) + "x" + std::to_string((int)actual_height) +
-                                 ", FPS: " + std::to_string(actual_fps));
-                
-                camera_running = true;
+                {
+                    std::lock_guard<std::mutex> lock(streams_mutex);
+                    if (!streams.emplace(name, stream).second) {
+                        camera_logger.warn("Stream '" + name + "' was started concurrently, discarding duplicate");
+                        stream->stop();
+                        return true;
+                    }
+                }
                 camera_logger.info("Camera started successfully");
                 PERF_LOG_END("CAMERA", startup);
                 return true;
@@ -219,64 +719,402 @@ private:
         }
         
         void stopCamera() {
-            if (!camera_running) {
+            std::vector<std::string> names = getStreamNames();
+            if (names.empty()) {
                 camera_logger.debug("Camera stop requested but camera is not running");
                 return;
             }
             
-            camera_logger.info("Stopping camera");
+            for (const auto& name : names) {
+                stopStream(name);
+            }
+        }
+        
+        bool stopStream(const std::string& name) {
+            std::shared_ptr<VideoStream> stream;
+            {
+                std::lock_guard<std::mutex> lock(streams_mutex);
+                auto it = streams.find(name);
+                if (it == streams.end()) {
+                    camera_logger.debug("Stop requested for unknown stream '" + name + "'");
+                    return false;
+                }
+                stream = it->second;
+                streams.erase(it);
+            }
+            
+            camera_logger.info("Stopping stream '" + name + "'");
             
             try {
-                camera.release();
-                camera_running = false;
+                stream->stop();
                 camera_logger.info("Camera stopped successfully");
             } catch (const std::exception& e) {
                 camera_logger.error("Exception during camera shutdown: " + std::string(e.what()));
             }
+            if (display_sink) {
+                display_sink->remove(stream->getWindowName());
+            }
+            notifyFrameEvent(); // Let processFrame() notice the change
+            return true;
+        }
+        
+        std::vector<std::shared_ptr<VideoStream>> getStreams() const {
+            std::lock_guard<std::mutex> lock(streams_mutex);
+            std::vector<std::shared_ptr<VideoStream>> result;
+            result.reserve(streams.size());
+            for (const auto& entry : streams) {
+                result.push_back(entry.second);
+            }
+            return result;
+        }
+        
+        std::vector<std::string> getStreamNames() const {
+            std::lock_guard<std::mutex> lock(streams_mutex);
+            std::vector<std::string> names;
+            for (const auto& entry : streams) {
+                names.push_back(entry.first);
+            }
+            return names;
+        }
+        
+        std::shared_ptr<VideoStream> findStream(const std::string& name) const {
+            std::lock_guard<std::mutex> lock(streams_mutex);
+            auto it = streams.find(name);
+            return it != streams.end() ? it->second : nullptr;
+        }
+        
+        void requestShutdown() {
+            if (!shutdown_requested.exchange(true)) {
+                main_logger.info("Shutdown requested");
+            }
+            notifyFrameEvent(); // Wake processFrame()
+        }
+        
+        void notifyFrameEvent() {
+            {
+                std::lock_guard<std::mutex> lock(frame_event_mutex);
+                pending_frame_events++;
+            }
+            frame_event_cv.notify_one();
+        }
+        
+        /**
+         * @brief Wait until any stream signals an event, then take the freshest frame of each
+         *
+         * Capture threads signal on every frame and at end of stream; stream
+         * changes and shutdown requests signal as well, so no timeout is needed.
+         */
+        void collectReadyFrames(const std::vector<std::shared_ptr<VideoStream>>& active_streams,
+                                std::vector<StreamFrame>& ready) {
+            {
+                std::unique_lock<std::mutex> lock(frame_event_mutex);
+                frame_event_cv.wait(lock, [this] { return pending_frame_events > 0; });
+                // Reset before polling: anything pushed after this point raises a new event
+                pending_frame_events = 0;
+            }
+            
+            for (const auto& stream : active_streams) {
+                CapturedFrame captured;
+                if (stream->takeAdmittedFrame(captured)) {
+                    StreamFrame item;
+                    item.stream = stream;
+                    item.frame = std::move(captured.frame);
+                    item.metadata = captured.metadata;
+                    ready.push_back(std::move(item));
+                }
+            }
         }
         
         bool processFrame() {
-            if (!camera_running || !camera.isOpened()) {
+            auto active_streams = getStreams();
+            if (active_streams.empty() || shutdown_requested) {
+                return false;
+            }
+            
+            ready_frames.clear();
+            collectReadyFrames(active_streams, ready_frames);
+            if (shutdown_requested) {
+                // Display final stats before exit
+                std::cout << "\n" << performance_monitor.getPerformanceStats() << std::endl;
+                ready_frames.clear();
                 return false;
             }
+            if (ready_frames.empty()) {
+                bool all_finished = std::all_of(active_streams.begin(), active_streams.end(),
+                                                [](const std::shared_ptr<VideoStream>& s) { return s->isFinished(); });
+                if (all_finished) {
+                    std::cerr << "Failed to capture frame" << std::endl;
+                    return false;
+                }
+                return true; // No frame ready yet
+            }
             
             // Start frame timing
             performance_monitor.startFrame();
             
-            // Capture frame
-            camera >> current_frame;
-            if (current_frame.empty()) {
-                std::cerr << "Failed to capture frame" << std::endl;
-                performance_monitor.endFrame(); // Still count failed frames
-                return false;
+            // Process each stream's frame on the shared worker pool
+            pending_work.clear();
+            for (auto& item : ready_frames) {
+                item.metadata.enterStage("process");
+                StreamFrame* work = &item;
+                if (worker_pool) {
+                    pending_work.push_back(worker_pool->submit([this, work]() { processStreamFrame(*work); }));
+                } else {
+                    processStreamFrame(*work);
+                }
+            }
+            for (auto& pending : pending_work) {
+                pending.get();
             }
             
-            // TODO: Add inference processing on the frame here
-            // Simulate some processing time for demonstration
-            // In real implementation, this would be your AI inference
+            // Hand the frames to the preview thread; no HighGUI calls on this path
+            if (display_sink) {
+                for (const auto& item : ready_frames) {
+                    display_sink->submit(item.stream->getWindowName(), item.frame);
+                }
+            }
             
-            // Display frame (optional - for testing)
-            cv::imshow("Camera Feed", current_frame);
+            // End frame timing; one processed frame per stream in this pass
+            performance_monitor.endFrame(ready_frames.size());
             
-            // End frame timing
-            performance_monitor.endFrame();
+            // Release buffers back to their pools
+            ready_frames.clear();
             
             // Display performance stats periodically
             if (performance_monitor.shouldDisplayStats(5.0)) { // Every 5 seconds
                 displayPerformanceStats();
             }
             
-            // Process ESC key to exit
-            int key = cv::waitKey(1) & 0xFF;
-            if (key == 27) { // ESC key
-                // Display final stats before exit
-                std::cout << "\n" << performance_monitor.getPerformanceStats() << std::endl;
-                return false;
+            return true;
+        }
+        
+        void processStreamFrame(StreamFrame& item) {
+            PerformanceMonitor& stream_monitor = item.stream->getPerformanceMonitor();
+            stream_monitor.startFrame();
+            
+            // Static scene: republish the previous result instead of running inference
+            item.metadata.enterStage("gate");
+            bool changed = item.stream->gateFrame(item.frame.mat(), item.metadata);
+            item.metadata.leaveStage("gate");
+            
+            std::shared_ptr<ModelPipeline> frame_pipeline = std::atomic_load(&pipeline);
+            if (changed && frame_pipeline) {
+                item.metadata.enterStage("inference");
+                auto result = std::make_shared<PipelineResult>(frame_pipeline->run(item.frame.mat()));
+                if (result->ok) {
+                    item.stream->publishResult(item.metadata, InferenceResult(), std::move(result));
+                } else {
+                    main_logger.error("Pipeline failed on stream '" + item.stream->getName() + "'");
+                    item.stream->getChangeGate().invalidate();
+                }
+                item.metadata.leaveStage("inference");
+            } else if (changed && currentBackend()) {
+                item.metadata.enterStage("inference");
+                InferenceResult result;
+                if (runInference(item.frame.mat(), item.stream->isLatencyCritical(), result)) {
+                    item.stream->publishResult(item.metadata, result);
+                } else {
+                    main_logger.error("Inference failed on stream '" + item.stream->getName() + "'");
+                    item.stream->getChangeGate().invalidate(); // Don't reuse a stale result for this scene
+                }
+                item.metadata.leaveStage("inference");
             }
+            stream_monitor.endFrame();
             
+            // Result is available: close the frame's record and aggregate its latencies
+            auto result_time = FrameMetadata::Clock::now();
+            item.metadata.leaveStage("process", result_time);
+            item.stream->recordResult(item.metadata, result_time);
+            capture_to_result_latency.record(item.metadata.ageMs(result_time));
+        }
+        
+        /**
+         * @brief Set OpenCV's pool size and pin every role before the worker threads start
+         */
+        void applyThreadTopology() {
+            if (thread_topology.opencv_threads >= 0) {
+                cv::setNumThreads(thread_topology.opencv_threads);
+            }
+            main_logger.info("OpenCV threads: " + std::to_string(cv::getNumThreads()));
+            
+            bool pinned = false;
+            for (const CpuSet& set : thread_topology.affinity) {
+                pinned = pinned || !set.empty();
+            }
+            if (!pinned) {
+                return;
+            }
+            if (!ThreadTopology::isPinningSupported()) {
+                main_logger.warn("CPU pinning is not supported on this platform, affinity ignored");
+            }
+            if (!ThreadTopology::getInstance().apply(thread_topology)) {
+                main_logger.warn("Some threads could not be pinned, see /info threads.pin_failures");
+            }
+            for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+                const CpuSet& set = thread_topology.affinity[i];
+                main_logger.info("Thread role '" + threadRoleToString(static_cast<ThreadRole>(i)) + "' on CPUs: " +
+                                 (set.empty() ? std::string("all") : set.toString()));
+            }
+        }
+        
+        std::string getThreadsJson() const {
+            std::ostringstream json;
+            json << "{";
+            json << "\"opencv_threads\":" << cv::getNumThreads() << ",";
+            json << "\"inference_workers\":" << (worker_pool ? worker_pool->size() : 0) << ",";
+            ThreadTopology::getInstance().writeInfoFields(json);
+            json << "}";
+            return json.str();
+        }
+        
+        std::shared_ptr<InferenceBackend> currentBackend() const {
+            return std::atomic_load(&backend);
+        }
+        
+        /**
+         * @brief Create, load and warm up a backend; null with error set on failure
+         */
+        std::shared_ptr<InferenceBackend> loadBackend(const ModelConfig& config, std::string& error) {
+            std::shared_ptr<InferenceBackend> loaded = InferenceBackend::create(config.backend);
+            if (!loaded) {
+                error = "Unknown inference backend: " + config.backend;
+                return nullptr;
+            }
+            main_logger.info("Loading model on backend '" + loaded->getName() + "': " + config.model_path);
+            bool use_cache = !config.cache_dir.empty() && loaded->requiresModelFile();
+            if (!(use_cache ? NetworkCache(config.cache_dir).loadBackend(*loaded, config) : loaded->load(config))) {
+                error = "Failed to load model: " + config.model_path;
+                return nullptr;
+            }
+            const ModelLoadTimings& timings = loaded->getLoadTimings();
+            std::ostringstream load_stats;
+            load_stats << std::fixed << std::setprecision(2);
+            load_stats << "Model ready - parse: " << timings.parse_ms << "ms";
+            load_stats << ", setup: " << timings.setup_ms << "ms";
+            load_stats << ", warm-up: " << timings.warmup_ms << "ms (" << timings.warmup_runs << " runs)";
+            if (use_cache) {
+                load_stats << ", network cache: " << loaded->getNetworkCacheStatus().state;
+            }
+            main_logger.info(load_stats.str());
+            return loaded;
+        }
+        
+        /**
+         * @brief Load a model on a background thread and swap it in when warmed up
+         *
+         * @return false if a reload is already running or reloads were stopped
+         */
+        bool reloadModel(const ModelConfig& config) {
+            // stop() and Web API handler threads may get here concurrently
+            std::lock_guard<std::mutex> thread_lock(reload_thread_mutex);
+            if (reloads_stopped) {
+                return false;
+            }
+            bool expected = false;
+            if (!reload_in_progress.compare_exchange_strong(expected, true)) {
+                return false;
+            }
+            if (reload_thread.joinable()) {
+                reload_thread.join(); // Previous reload has finished
+            }
+            reload_thread = std::thread([this, config]() {
+                auto reload_start = std::chrono::steady_clock::now();
+                std::string error;
+                std::shared_ptr<InferenceBackend> loaded = loadBackend(config, error);
+                if (!loaded) {
+                    main_logger.error("Model reload failed, keeping current model: " + error);
+                    std::lock_guard<std::mutex> lock(reload_mutex);
+                    last_reload_error = error;
+                    reload_in_progress = false;
+                    return;
+                }
+                double reload_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - reload_start).count();
+                
+                // The only pause: two pointer swaps. Work in flight keeps its own reference
+                // to the old model, which is freed when the last one drops.
+                auto swap_start = std::chrono::steady_clock::now();
+                if (batch_scheduler) {
+                    batch_scheduler->setBackend(loaded);
+                }
+                std::atomic_store(&backend, loaded);
+                double swap_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - swap_start).count();
+                uint64_t version = ++model_version;
+                if (result_cache) {
+                    result_cache->clear(); // Old-version entries are unreachable; free them now
+                }
+                
+                {
+                    std::lock_guard<std::mutex> lock(reload_mutex);
+                    model_config = config;
+                    last_reload_ms = reload_ms;
+                    last_swap_us = swap_us;
+                    last_reload_error.clear();
+                }
+                std::ostringstream reload_stats;
+                reload_stats << std::fixed << std::setprecision(2);
+                reload_stats << "Model reloaded (version " << version << ") - load: " << reload_ms << "ms, swap pause: " << swap_us << "us";
+                main_logger.info(reload_stats.str());
+                reload_in_progress = false;
+            });
             return true;
         }
         
+        /**
+         * @brief Refuse further reloads and wait for a running one to finish
+         */
+        void stopReloads() {
+            std::thread finishing;
+            {
+                std::lock_guard<std::mutex> thread_lock(reload_thread_mutex);
+                reloads_stopped = true;
+                finishing = std::move(reload_thread);
+            }
+            if (finishing.joinable()) {
+                finishing.join();
+            }
+        }
+        
+        bool areReloadsStopped() {
+            std::lock_guard<std::mutex> thread_lock(reload_thread_mutex);
+            return reloads_stopped;
+        }
+        
+        std::string getReloadStatusJson() const {
+            std::lock_guard<std::mutex> lock(reload_mutex);
+            std::ostringstream json;
+            json << std::fixed << std::setprecision(2);
+            json << "{";
+            json << "\"in_progress\":" << (reload_in_progress ? "true" : "false") << ",";
+            json << "\"last_reload_ms\":" << last_reload_ms << ",";
+            json << "\"last_swap_us\":" << last_swap_us << ",";
+            json << "\"last_error\":\"" << WebApiServer::escapeJsonString(last_reload_error) << "\"";
+            json << "}";
+            return json.str();
+        }
+        
+        /**
+         * @brief Run one image through the batch scheduler, or directly when bypassing it
+         */
+        bool runInference(const cv::Mat& image, bool bypass_batching, InferenceResult& result) {
+            try {
+                if (batch_scheduler && !bypass_batching) {
+                    result = batch_scheduler->submit(image).get();
+                    return true;
+                }
+                // Holding the reference keeps this model alive across a concurrent reload
+                std::shared_ptr<InferenceBackend> model = currentBackend();
+                std::vector<cv::Mat> outputs;
+                if (!model || !model->runBatch({image}, outputs)) {
+                    return false;
+                }
+                result = model->decode(outputs, 1)[0];
+                return true;
+            } catch (const std::exception& e) {
+                main_logger.error("Inference failed: " + std::string(e.what()));
+                return false;
+            }
+        }
+        
         void displayPerformanceStats() {
             // Log to both console and file
             std::stringstream stats;
@@ -303,7 +1141,8 @@ private:
         }
         
         bool isCameraRunning() const {
-            return camera_running;
+            std::lock_guard<std::mutex> lock(streams_mutex);
+            return !streams.empty();
         }
         
         bool startWebApi(int port = 8080) {
@@ -320,6 +1159,44 @@ private:
                 // Set references for API endpoints
                 web_api_server->setPerformanceMonitor(&performance_monitor);
                 web_api_server->setInferenceService(this);
+                web_api_server->addMetricsProvider("streams", [this](const std::string& path) {
+                    return getStreamsMetricsJson(WebApiServer::getQueryParameter(path, "stream"));
+                });
+                web_api_server->addMetricsProvider("change_gate", [this](const std::string& path) {
+                    (void)path;
+                    return getChangeGateTotals().toJson();
+                });
+                web_api_server->addMetricsProvider("latency", [this](const std::string& path) {
+                    (void)path;
+                    return "{\"capture_to_result\":" + capture_to_result_latency.toJson() + "}";
+                });
+                web_api_server->addMetricsProvider("batching", [this](const std::string& path) {
+                    (void)path;
+                    return batch_scheduler ? batch_scheduler->getStatsJson() : std::string(R"({"enabled":false})");
+                });
+                web_api_server->addMetricsProvider("pipeline", [this](const std::string& path) {
+                    (void)path;
+                    std::shared_ptr<ModelPipeline> current = std::atomic_load(&pipeline);
+                    return current ? current->getInfoJson() : std::string(R"({"enabled":false})");
+                });
+                web_api_server->addMetricsProvider("result_cache", [this](const std::string& path) {
+                    (void)path;
+                    return result_cache ? result_cache->getStats().toJson() : std::string(R"({"enabled":false})");
+                });
+                web_api_server->addMetricsProvider("inference_requests", [this](const std::string& path) {
+                    (void)path;
+                    return getInferenceRequestsJson();
+                });
+                web_api_server->addInfoProvider("threads", [this]() {
+                    return getThreadsJson();
+                });
+                web_api_server->addInfoProvider("model", [this]() {
+                    std::shared_ptr<InferenceBackend> model = currentBackend();
+                    std::string json = model ? model->getInfoJson() : std::string(R"({"loaded":false})");
+                    // Append reload state to the backend's object
+                    return json.substr(0, json.size() - 1) + ",\"version\":" + std::to_string(model_version) +
+                           ",\"reload\":" + getReloadStatusJson() + "}";
+                });
                 
                 // Add custom routes
                 addCustomRoutes();
@@ -352,35 +1229,86 @@ private:
             return web_api_server && web_api_server->isRunning();
         }
         
+        /**
+         * @brief Gate decisions summed over all streams
+         */
+        ChangeGateStats getChangeGateTotals() const {
+            ChangeGateStats totals;
+            for (const auto& stream : getStreams()) {
+                ChangeGateStats stats = stream->getChangeGate().getStats();
+                totals.evaluated += stats.evaluated;
+                totals.processed += stats.processed;
+                totals.reused += stats.reused;
+                totals.last_score = stats.last_score;
+            }
+            return totals;
+        }
+        
+        std::string getStreamsMetricsJson(const std::string& filter) const {
+            std::ostringstream json;
+            json << "{";
+            bool first = true;
+            for (const auto& stream : getStreams()) {
+                if (!filter.empty() && stream->getName() != filter) continue;
+                if (!first) json << ",";
+                json << "\"" << WebApiServer::escapeJsonString(stream->getName()) << "\":" << stream->getMetricsJson();
+                first = false;
+            }
+            json << "}";
+            return json.str();
+        }
+        
         void addCustomRoutes() {
             if (!web_api_server) return;
             
             // Camera control endpoints
+            // Body: {"stream":"front","camera_id":1} or {"stream":"replay","source":"file:/data/clip.mp4"}
+            // Without "stream" the name is "camera<id>", or the source URI itself
             web_api_server->addRoute("/camera/start", [this](const std::string& method, const std::string& path, const std::string& body) {
                 if (method == "POST") {
-                    int camera_id = 0; // Default camera ID
-                    
-                    // Parse camera ID from body if provided
-                    size_t pos = body.find("\"camera_id\":");
-                    if (pos != std::string::npos) {
-                        std::string id_str = body.substr(pos + 12);
-                        size_t end = id_str.find_first_not_of("0123456789");
-                        if (end != std::string::npos) {
-                            id_str = id_str.substr(0, end);
-                        }
-                        try {
-                            camera_id = std::stoi(id_str);
-                        } catch (...) {
-                            camera_id = 0;
+                    int camera_id = WebApiServer::extractJsonInt(body, "camera_id", 0);
+                    std::string source = WebApiServer::extractJsonString(body, "source");
+                    std::string name = WebApiServer::extractJsonString(body, "stream");
+                    if (source.empty()) {
+                        source = "camera:" + std::to_string(camera_id);
+                        if (name.empty()) {
+                            name = "camera" + std::to_string(camera_id);
                         }
+                    } else if (name.empty()) {
+                        name = source;
+                    }
+                    
+                    // Optional per-stream rate control: "rate_mode", "every_nth", "target_fps", "max_frame_age_ms"
+                    StreamOptions options = stream_options;
+                    RateControlConfig& stream_rate_control = options.rate_control;
+                    std::string rate_mode = WebApiServer::extractJsonString(body, "rate_mode");
+                    if (!rate_mode.empty()) {
+                        stream_rate_control.mode = stringToRateControlMode(rate_mode);
+                    }
+                    stream_rate_control.every_nth = static_cast<uint64_t>(
+                        WebApiServer::extractJsonInt(body, "every_nth", static_cast<int>(stream_rate_control.every_nth)));
+                    stream_rate_control.target_fps = WebApiServer::extractJsonNumber(body, "target_fps", stream_rate_control.target_fps);
+                    stream_rate_control.max_frame_age_ms = WebApiServer::extractJsonNumber(body, "max_frame_age_ms", stream_rate_control.max_frame_age_ms);
+                    
+                    // Optional change gate: "change_threshold" (enables the gate), "max_reuse_frames"
+                    double change_threshold = WebApiServer::extractJsonNumber(body, "change_threshold", -1.0);
+                    if (change_threshold >= 0.0) {
+                        options.change_gate.enabled = true;
+                        options.change_gate.threshold = change_threshold;
                     }
+                    options.change_gate.max_reuse_frames = static_cast<uint32_t>(
+                        WebApiServer::extractJsonInt(body, "max_reuse_frames", static_cast<int>(options.change_gate.max_reuse_frames)));
+                    
+                    // "latency_critical": true runs this stream's frames outside the batch scheduler
+                    options.latency_critical = WebApiServer::extractJsonBool(body, "latency_critical", options.latency_critical);
                     
-                    bool success = startCamera(camera_id);
+                    bool success = startStream(name, source, options);
                     std::ostringstream json;
                     json << "{";
                     json << "\"success\":" << (success ? "true" : "false") << ",";
                     json << "\"message\":\"" << (success ? "Camera started" : "Failed to start camera") << "\",";
-                    json << "\"camera_id\":" << camera_id;
+                    json << "\"stream\":\"" << WebApiServer::escapeJsonString(name) << "\",";
+                    json << "\"source\":\"" << WebApiServer::escapeJsonString(source) << "\"";
                     json << "}";
                     
                     return createJsonResponse(success ? 200 : 500, json.str());
@@ -388,26 +1316,41 @@ private:
                 return createJsonResponse(405, R"({"error":"Method not allowed"})");
             });
             
+            // Body: {"stream":"front"}; without "stream" every stream is stopped
             web_api_server->addRoute("/camera/stop", [this](const std::string& method, const std::string& path, const std::string& body) {
                 if (method == "POST") {
-                    stopCamera();
-                    return createJsonResponse(200, R"({"success":true,"message":"Camera stopped"})");
+                    std::string name = WebApiServer::extractJsonString(body, "stream");
+                    if (name.empty()) {
+                        stopCamera();
+                        return createJsonResponse(200, R"({"success":true,"message":"Camera stopped"})");
+                    }
+                    if (!stopStream(name)) {
+                        return createJsonResponse(404, R"({"success":false,"message":"Unknown stream"})");
+                    }
+                    return createJsonResponse(200, R"({"success":true,"message":"Camera stopped","stream":")" + WebApiServer::escapeJsonString(name) + R"("})");
                 }
                 return createJsonResponse(405, R"({"error":"Method not allowed"})");
             });
             
+            // Optional query: /camera/status?stream=front
             web_api_server->addRoute("/camera/status", [this](const std::string& method, const std::string& path, const std::string& body) {
+                std::string filter = WebApiServer::getQueryParameter(path, "stream");
+                auto active_streams = getStreams();
+                bool camera_running = !active_streams.empty();
+                
                 std::ostringstream json;
                 json << "{";
                 json << "\"running\":" << (camera_running ? "true" : "false") << ",";
-                json << "\"status\":\"" << (camera_running ? "active" : "inactive") << "\"";
-                if (camera_running && camera.isOpened()) {
-                    json << ",\"properties\":{";
-                    json << "\"width\":" << camera.get(cv::CAP_PROP_FRAME_WIDTH) << ",";
-                    json << "\"height\":" << camera.get(cv::CAP_PROP_FRAME_HEIGHT) << ",";
-                    json << "\"fps\":" << camera.get(cv::CAP_PROP_FPS);
-                    json << "}";
+                json << "\"status\":\"" << (camera_running ? "active" : "inactive") << "\",";
+                json << "\"streams\":[";
+                bool first = true;
+                for (const auto& stream : active_streams) {
+                    if (!filter.empty() && stream->getName() != filter) continue;
+                    if (!first) json << ",";
+                    json << stream->getStatusJson();
+                    first = false;
                 }
+                json << "]";
                 json << "}";
                 
                 return createJsonResponse(200, json.str());
@@ -417,6 +1360,19 @@ private:
             web_api_server->addRoute("/performance/reset", [this](const std::string& method, const std::string& path, const std::string& body) {
                 if (method == "POST") {
                     performance_monitor.reset();
+                    capture_to_result_latency.reset();
+                    if (batch_scheduler) {
+                        batch_scheduler->resetStats();
+                    }
+                    if (result_cache) {
+                        result_cache->resetStats();
+                    }
+                    if (std::shared_ptr<ModelPipeline> current = std::atomic_load(&pipeline)) {
+                        current->getPerformanceMonitor().reset();
+                    }
+                    for (const auto& stream : getStreams()) {
+                        stream->resetMetrics();
+                    }
                     return createJsonResponse(200, R"({"success":true,"message":"Performance statistics reset"})");
                 }
                 return createJsonResponse(405, R"({"error":"Method not allowed"})");
@@ -427,24 +1383,65 @@ private:
                 std::ostringstream json;
                 json << "{";
                 json << "\"service_running\":" << (running ? "true" : "false") << ",";
-                json << "\"camera_running\":" << (camera_running ? "true" : "false") << ",";
+                json << "\"camera_running\":" << (isCameraRunning() ? "true" : "false") << ",";
+                json << "\"streams\":" << getStreamNames().size() << ",";
                 json << "\"web_api_running\":" << (isWebApiRunning() ? "true" : "false") << ",";
+                json << "\"headless\":" << (display_sink ? "false" : "true") << ",";
                 json << "\"total_frames\":" << performance_monitor.getTotalFrames() << ",";
                 json << "\"current_fps\":" << std::fixed << std::setprecision(1) << performance_monitor.getFPS();
                 json << "}";
                 
                 return createJsonResponse(200, json.str());
             });
+            
+            // Graceful shutdown of the whole process (replaces ESC on headless machines)
+            web_api_server->addRoute("/service/stop", [this](const std::string& method, const std::string& path, const std::string& body) {
+                if (method == "POST") {
+                    requestShutdown();
+                    return createJsonResponse(200, R"({"success":true,"message":"Shutdown requested"})");
+                }
+                return createJsonResponse(405, R"({"error":"Method not allowed"})");
+            });
+            
+            // Model hot reload; body fields override the current config:
+            // {"model_path":"models/v2.onnx","backend":"opencv_dnn","warmup_runs":3}
+            // Progress and timings are on /info under model.reload
+            web_api_server->addRoute("/model/reload", [this](const std::string& method, const std::string& path, const std::string& body) {
+                if (method == "POST") {
+                    ModelConfig config;
+                    {
+                        std::lock_guard<std::mutex> lock(reload_mutex);
+                        config = model_config;
+                    }
+                    std::string model_path = WebApiServer::extractJsonString(body, "model_path");
+                    std::string backend_name = WebApiServer::extractJsonString(body, "backend");
+                    if (!model_path.empty()) config.model_path = model_path;
+                    if (!backend_name.empty()) config.backend = backend_name;
+                    config.warmup_runs = WebApiServer::extractJsonInt(body, "warmup_runs", config.warmup_runs);
+                    
+                    if (!reloadModel(config)) {
+                        if (areReloadsStopped()) {
+                            return createJsonResponse(503, R"({"success":false,"message":"Service is stopping"})");
+                        }
+                        return createJsonResponse(409, R"({"success":false,"message":"Reload already in progress"})");
+                    }
+                    return createJsonResponse(202, R"({"success":true,"message":"Reload started","model_path":")" + WebApiServer::escapeJsonString(config.model_path) + R"("})");
+                }
+                return createJsonResponse(405, R"({"error":"Method not allowed"})");
+            });
         }
         
         std::string createJsonResponse(int status_code, const std::string& json_body) {
             std::string status_text;
             switch (status_code) {
                 case 200: status_text = "OK"; break;
+                case 202: status_text = "Accepted"; break;
                 case 400: status_text = "Bad Request"; break;
                 case 404: status_text = "Not Found"; break;
                 case 405: status_text = "Method Not Allowed"; break;
+                case 409: status_text = "Conflict"; break;
                 case 500: status_text = "Internal Server Error"; break;
+                case 503: status_text = "Service Unavailable"; break;
                 default: status_text = "Unknown"; break;
             }
             
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * @brief Escape a string for use inside a JSON string literal
+ *
+ * Quotes, backslashes and control characters are escaped; other bytes
+ * (including UTF-8 sequences) pass through unchanged.
+ */
+inline std::string jsonEscape(const std::string& str) {
+    std::string escaped;
+    escaped.reserve(str.size());
+    for (char c : str) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\b': escaped += "\\b"; break;
+            case '\f': escaped += "\\f"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char code[7];
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                    escaped += code;
+                } else {
+                    escaped += c;
+                }
+                break;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Decode the escapes of a JSON string literal's contents (without the quotes)
+ *
+ * \uXXXX (including surrogate pairs) is written as UTF-8. Malformed escapes
+ * are kept as they are.
+ */
+inline std::string jsonUnescape(const std::string& str) {
+    auto hex4 = [&str](size_t pos, uint32_t& value) {
+        if (pos + 4 > str.size()) return false;
+        value = 0;
+        for (size_t i = pos; i < pos + 4; ++i) {
+            char c = str[i];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    };
+    auto appendUtf8 = [](std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    };
+
+    std::string out;
+    out.reserve(str.size());
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] != '\\' || i + 1 >= str.size()) {
+            out += str[i];
+            continue;
+        }
+        char e = str[++i];
+        switch (e) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t code = 0;
+                if (!hex4(i + 1, code)) {
+                    out += "\\u";
+                    break;
+                }
+                i += 4;
+                uint32_t low = 0;
+                if (code >= 0xD800 && code < 0xDC00 && i + 2 < str.size() && str[i + 1] == '\\' &&
+                    str[i + 2] == 'u' && hex4(i + 3, low) && low >= 0xDC00 && low < 0xE000) {
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default:
+                out += '\\';
+                out += e;
+                break;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <string>
+
+/**
+ * @brief Latency Histogram Class - Header-only implementation
+ *
+ * Log-linear buckets over microseconds (8 sub-buckets per power of two,
+ * so percentiles are within 12.5%). Recording is lock-free and safe from
+ * any number of threads; memory is fixed regardless of sample count.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() {
+        reset();
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Record one sample in milliseconds
+     */
+    void record(double latency_ms) {
+        uint64_t us = latency_ms <= 0.0 ? 0 : static_cast<uint64_t>(latency_ms * 1000.0);
+        buckets_[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_us_.fetch_add(us, std::memory_order_relaxed);
+
+        uint64_t current = min_us_.load(std::memory_order_relaxed);
+        while (us < current && !min_us_.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+        }
+        current = max_us_.load(std::memory_order_relaxed);
+        while (us > current && !max_us_.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t getCount() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    double getMean() const {
+        uint64_t count = getCount();
+        return count ? sum_us_.load(std::memory_order_relaxed) / 1000.0 / count : 0.0;
+    }
+
+    double getMin() const {
+        uint64_t min_us = min_us_.load(std::memory_order_relaxed);
+        return min_us == std::numeric_limits<uint64_t>::max() ? 0.0 : min_us / 1000.0;
+    }
+
+    double getMax() const {
+        return max_us_.load(std::memory_order_relaxed) / 1000.0;
+    }
+
+    /**
+     * @brief Latency below which the given fraction of samples fall (ms)
+     *
+     * @param quantile 0.0 - 1.0, e.g. 0.99 for P99
+     */
+    double getPercentile(double quantile) const {
+        uint64_t count = getCount();
+        if (count == 0) {
+            return 0.0;
+        }
+
+        uint64_t target = static_cast<uint64_t>(quantile * count + 0.5);
+        target = target == 0 ? 1 : (target > count ? count : target);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                // Bucket midpoint, clamped to the observed range
+                double value_us = (bucketLowerBound(i) + bucketUpperBound(i)) / 2.0;
+                double value_ms = value_us / 1000.0;
+                if (value_ms < getMin()) return getMin();
+                if (value_ms > getMax()) return getMax();
+                return value_ms;
+            }
+        }
+        return getMax();
+    }
+
+    void reset() {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_us_.store(0, std::memory_order_relaxed);
+        min_us_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        max_us_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Summary as a JSON object (all values in ms)
+     */
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(3);
+        json << "{";
+        json << "\"count\":" << getCount() << ",";
+        json << "\"mean\":" << getMean() << ",";
+        json << "\"min\":" << getMin() << ",";
+        json << "\"p50\":" << getPercentile(0.50) << ",";
+        json << "\"p90\":" << getPercentile(0.90) << ",";
+        json << "\"p99\":" << getPercentile(0.99) << ",";
+        json << "\"max\":" << getMax();
+        json << "}";
+        return json.str();
+    }
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr int MAX_SHIFT = 40;  // Values up to ~2^43 us (100 days)
+    static constexpr size_t BUCKET_COUNT = (MAX_SHIFT + 1) * SUB_BUCKETS;
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_us_{0};
+    std::atomic<uint64_t> min_us_{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max_us_{0};
+
+    static size_t bucketIndex(uint64_t us) {
+        if (us < SUB_BUCKETS) {
+            return static_cast<size_t>(us);
+        }
+        int msb = 0;
+        for (uint64_t v = us; v > 1; v >>= 1) {
+            msb++;
+        }
+        int shift = msb - SUB_BUCKET_BITS;
+        if (shift >= MAX_SHIFT) {
+            return BUCKET_COUNT - 1;
+        }
+        return static_cast<size_t>((shift + 1) * SUB_BUCKETS + ((us >> shift) - SUB_BUCKETS));
+    }
+
+    static uint64_t bucketLowerBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        return (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    }
+
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index + 1;
+        }
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        return bucketLowerBound(index) + (1ULL << shift);
+    }
+};
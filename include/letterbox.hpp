@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <opencv2/opencv.hpp>
+#include "fused_preprocess.hpp"
+#include "frame_pool.hpp"
+
+/**
+ * @brief Where a frame landed in the network input, and the way back
+ *
+ * Recorded when the input tensor is written and carried with it, so
+ * postprocessing maps boxes to frame coordinates with the exact scale the
+ * resize used (per axis, after rounding the content size) instead of
+ * recomputing it from the two sizes.
+ */
+struct LetterboxTransform {
+    cv::Size source;          // Frame size
+    cv::Size input;           // Network input size
+    cv::Rect content;         // Resized frame inside the input; the rest is padding
+    float scale_x = 1.0f;     // Frame pixels per input pixel
+    float scale_y = 1.0f;
+
+    /**
+     * @brief Aspect-preserving fit, centred (odd padding goes right / bottom)
+     */
+    static LetterboxTransform letterbox(const cv::Size& source, const cv::Size& input) {
+        LetterboxTransform transform;
+        if (source.empty() || input.empty()) {
+            return transform;
+        }
+        const double ratio = std::min(static_cast<double>(input.width) / source.width,
+                                      static_cast<double>(input.height) / source.height);
+        cv::Size size(std::max(1, std::min(input.width, static_cast<int>(std::lround(source.width * ratio)))),
+                      std::max(1, std::min(input.height, static_cast<int>(std::lround(source.height * ratio)))));
+        return make(source, input, cv::Rect(cv::Point((input.width - size.width) / 2, (input.height - size.height) / 2), size));
+    }
+
+    /**
+     * @brief Plain resize to the whole input (what blobFromImages does)
+     */
+    static LetterboxTransform stretch(const cv::Size& source, const cv::Size& input) {
+        if (source.empty() || input.empty()) {
+            return LetterboxTransform();
+        }
+        return make(source, input, cv::Rect(cv::Point(), input));
+    }
+
+    bool valid() const {
+        return !source.empty() && !content.empty();
+    }
+
+    cv::Point2f toSource(const cv::Point2f& point) const {
+        return cv::Point2f((point.x - content.x) * scale_x, (point.y - content.y) * scale_y);
+    }
+
+    cv::Point2f toInput(const cv::Point2f& point) const {
+        return cv::Point2f(point.x / scale_x + content.x, point.y / scale_y + content.y);
+    }
+
+    /**
+     * @brief Box corners in input pixels to a frame rectangle, rounded and clipped to the frame
+     */
+    cv::Rect toSource(float x1, float y1, float x2, float y2) const {
+        cv::Point2f top_left = toSource(cv::Point2f(x1, y1));
+        cv::Point2f bottom_right = toSource(cv::Point2f(x2, y2));
+        return cv::Rect(cv::Point(cvRound(top_left.x), cvRound(top_left.y)),
+                        cv::Point(cvRound(bottom_right.x), cvRound(bottom_right.y))) & cv::Rect(cv::Point(), source);
+    }
+
+private:
+    static LetterboxTransform make(const cv::Size& source, const cv::Size& input, const cv::Rect& content) {
+        LetterboxTransform transform;
+        transform.source = source;
+        transform.input = input;
+        transform.content = content;
+        // Inverse of the resize's own ratio, so mapping back is exact
+        transform.scale_x = static_cast<float>(static_cast<double>(source.width) / content.width);
+        transform.scale_y = static_cast<float>(static_cast<double>(source.height) / content.height);
+        return transform;
+    }
+};
+
+/**
+ * @brief A letterboxed input tensor and the transform it was written with
+ */
+struct LetterboxedFrame {
+    PooledFrame tensor;              // Planar 3 x H x W CV_32F, held as a (3 * H) x W Mat
+    LetterboxTransform transform;
+
+    /**
+     * @brief The NCHW data for batch size 1
+     */
+    float* data() {
+        return tensor.mat().ptr<float>();
+    }
+};
+
+/**
+ * @brief Letterbox Stage - Header-only implementation
+ *
+ * Resizes BGR8 frames with their aspect ratio kept straight into pooled
+ * input tensors (FusedPreprocessor writes the content rectangle and then
+ * only the border around it), with no padded intermediate image and no
+ * per-frame allocation once the pool and interpolation tables are warm.
+ * The transform is recomputed only when the frame size changes.
+ *
+ * Tensors return to the pool when the last LetterboxedFrame holding them
+ * is dropped, so they can wait in a queue or batch. Not thread-safe: one
+ * instance per thread (the pool itself may be shared through copies of
+ * the frames).
+ */
+class Letterboxer {
+public:
+    Letterboxer(const cv::Size& input_size, double scale = 1.0 / 255.0, const cv::Scalar& mean = cv::Scalar(),
+                bool swap_rb = true, const cv::Scalar& pad_value = cv::Scalar::all(114), size_t preallocate = 2)
+        : preprocessor_(input_size, scale, mean, swap_rb),
+          pool_(cv::Size(input_size.width, 3 * input_size.height), CV_32FC1, preallocate),
+          pad_value_(pad_value) {}
+
+    /**
+     * @brief Letterbox one frame into a pooled tensor; frame.tensor's previous buffer is released first
+     */
+    bool process(const cv::Mat& frame, LetterboxedFrame& letterboxed) {
+        letterboxed.tensor.reset();
+        if (frame.empty() || frame.type() != CV_8UC3) {
+            return false;
+        }
+        if (frame.size() != transform_.source) {
+            transform_ = LetterboxTransform::letterbox(frame.size(), preprocessor_.getInputSize());
+        }
+        letterboxed.tensor = pool_.acquire();
+        letterboxed.transform = transform_;
+        if (!preprocessor_.run(frame, letterboxed.data(), transform_.content, pad_value_)) {
+            letterboxed.tensor.reset();
+            return false;
+        }
+        return true;
+    }
+
+    FusedPreprocessor& getPreprocessor() {
+        return preprocessor_;
+    }
+
+    FramePoolStats getPoolStats() const {
+        return pool_.getStats();
+    }
+
+private:
+    FusedPreprocessor preprocessor_;
+    FramePool pool_;
+    cv::Scalar pad_value_;
+    LetterboxTransform transform_;
+};
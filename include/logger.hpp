@@ -13,6 +13,7 @@
 #include <queue>
 #include <condition_variable>
 #include <atomic>
+#include "thread_topology.hpp"
 
 /**
  * @brief Industrial Logging System
@@ -211,6 +212,7 @@ private:
         }
         
         void loggingWorker() {
+            ScopedThreadRole role(ThreadRole::LOGGER);
             while (!should_stop || !log_queue.empty()) {
                 std::unique_lock<std::mutex> lock(queue_mutex);
                 queue_condition.wait(lock, [this] { return !log_queue.empty() || should_stop; });
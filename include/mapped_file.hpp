@@ -0,0 +1,157 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Read-only Memory-mapped File - Header-only implementation
+ *
+ * Maps a whole file read-only and shared (MAP_SHARED on POSIX, a
+ * read-only file mapping on Windows). Pages fault in on first access and
+ * come from the page cache, so every process mapping the same file shares
+ * one physical copy. Move-only; the mapping lives as long as the object.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+        open(path);
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept {
+        moveFrom(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Map the file; replaces any previous mapping
+     */
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            close();
+            return false;
+        }
+        data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        if (!data_) {
+            close();
+            return false;
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        data_ = data;
+        size_ = static_cast<size_t>(info.st_size);
+#endif
+        path_ = path;
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_) munmap(data_, size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        path_.clear();
+    }
+
+    /**
+     * @brief Hint that the whole file will be read soon (sequential readahead)
+     */
+    void prefetch() const {
+#if !defined(_WIN32) && defined(MADV_WILLNEED)
+        if (data_) madvise(data_, size_, MADV_WILLNEED);
+#endif
+    }
+
+    bool isOpen() const { return data_ != nullptr; }
+    const uint8_t* data() const { return static_cast<const uint8_t*>(data_); }
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+    std::string path_;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+
+    void moveFrom(MappedFile& other) {
+        data_ = other.data_;
+        size_ = other.size_;
+        path_ = std::move(other.path_);
+#ifdef _WIN32
+        file_ = other.file_;
+        mapping_ = other.mapping_;
+        other.file_ = INVALID_HANDLE_VALUE;
+        other.mapping_ = nullptr;
+#endif
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+};
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <functional>
+#include <future>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "inference_backend.hpp"
+#include "performance_monitor.hpp"
+#include "thread_pool.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Region found by a detector node, in frame coordinates
+ */
+struct PipelineRegion {
+    cv::Rect box;
+    int class_id = -1;
+    float score = 0.0f;
+    int source = 0;        // Index of the node input it was found in
+};
+
+/**
+ * @brief Turns one image's raw outputs into regions in that image's coordinates
+ *
+ * @param outputs Raw outputs of the whole batch
+ * @param index Position of the image in the batch
+ * @param image_size Size of the image the regions refer to
+ */
+using RegionDecoder = std::function<std::vector<PipelineRegion>(const std::vector<cv::Mat>& outputs, size_t index,
+                                                                const cv::Size& image_size)>;
+
+/**
+ * @brief Selects which upstream regions a node runs on (e.g. one class only)
+ */
+using RegionFilter = std::function<bool(const PipelineRegion& region)>;
+
+/**
+ * @brief One model stage of a pipeline
+ */
+struct PipelineNode {
+    std::string name;
+    std::string input;                          // Upstream detector node; empty = the whole frame
+    std::shared_ptr<InferenceBackend> backend;  // Loaded backend, may be shared between nodes
+    RegionDecoder regions;                      // Set on detector nodes; their regions feed downstream nodes
+    RegionFilter accept;                        // Optional filter on the upstream regions
+    size_t max_batch = 16;                      // Crops of one frame per runBatch() call
+};
+
+/**
+ * @brief What one node produced for one frame
+ */
+struct PipelineNodeOutput {
+    bool ok = true;
+    std::vector<cv::Rect> boxes;              // Frame coordinates of each input
+    std::vector<int> sources;                 // Upstream region of each input (-1 = whole frame)
+    std::vector<InferenceResult> results;     // Classifier nodes: one per input
+    std::vector<PipelineRegion> regions;      // Detector nodes: all regions found
+    double latency_ms = 0.0;
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        json << "\"ok\":" << (ok ? "true" : "false") << ",";
+        json << "\"inputs\":" << boxes.size() << ",";
+        json << "\"latency_ms\":" << latency_ms;
+        if (!regions.empty()) {
+            json << ",\"regions\":[";
+            for (size_t i = 0; i < regions.size(); ++i) {
+                const PipelineRegion& region = regions[i];
+                if (i > 0) json << ",";
+                json << "{\"box\":[" << region.box.x << "," << region.box.y << "," << region.box.width << ","
+                     << region.box.height << "],\"class_id\":" << region.class_id << ",\"score\":" << region.score << "}";
+            }
+            json << "]";
+        }
+        if (!results.empty()) {
+            json << ",\"results\":[";
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (i > 0) json << ",";
+                json << "{\"source\":" << sources[i] << ",\"result\":" << results[i].toJson() << "}";
+            }
+            json << "]";
+        }
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Outputs of every node for one frame
+ */
+struct PipelineResult {
+    bool ok = true;
+    std::map<std::string, PipelineNodeOutput> nodes;
+    double latency_ms = 0.0;
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        json << "\"ok\":" << (ok ? "true" : "false") << ",";
+        json << "\"latency_ms\":" << latency_ms << ",";
+        json << "\"nodes\":{";
+        bool first = true;
+        for (const auto& node : nodes) {
+            if (!first) json << ",";
+            json << "\"" << node.first << "\":" << node.second.toJson();
+            first = false;
+        }
+        json << "}";
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Multi-model Pipeline - Header-only implementation
+ *
+ * A graph of model stages declared with addNode(): root nodes see the whole
+ * frame, every other node runs on the regions of the detector node named
+ * as its input. Crops are cv::Mat views into the frame, never copies; all
+ * crops a node gets from one frame go through its backend in batches of
+ * max_batch.
+ *
+ * Nodes are grouped by depth. Nodes of the same depth (independent
+ * branches, e.g. two classifiers on the same detections) run in parallel:
+ * one on the calling thread, the rest on the pipeline's own pool, so run()
+ * is safe to call from another pool's workers. Each node's latency is
+ * recorded in the pipeline's PerformanceMonitor as a stage of that name.
+ *
+ * Declare all nodes before the first run(); run() itself may be called
+ * from several threads at once.
+ */
+class ModelPipeline {
+public:
+    explicit ModelPipeline(size_t branch_threads = 2)
+        : branch_pool_(std::max<size_t>(1, branch_threads), "PIPELINE"), logger_("PIPELINE") {}
+
+    ModelPipeline(const ModelPipeline&) = delete;
+    ModelPipeline& operator=(const ModelPipeline&) = delete;
+
+    /**
+     * @brief Add a stage; its input must be an already added detector node
+     *
+     * "total" is reserved for the whole-run latency stage.
+     */
+    bool addNode(const PipelineNode& node) {
+        if (node.name.empty() || node.name == "total" || findNode(node.name) >= 0) {
+            logger_.error("Pipeline node needs a unique name: '" + node.name + "'");
+            return false;
+        }
+        if (!node.backend || !node.backend->isLoaded()) {
+            logger_.error("Pipeline node '" + node.name + "' has no loaded backend");
+            return false;
+        }
+        size_t depth = 0;
+        if (!node.input.empty()) {
+            int parent = findNode(node.input);
+            if (parent < 0 || !nodes_[parent].node.regions) {
+                logger_.error("Pipeline node '" + node.name + "' needs a detector node as input, got '" + node.input + "'");
+                return false;
+            }
+            depth = nodes_[parent].depth + 1;
+        }
+
+        NodeEntry entry;
+        entry.node = node;
+        entry.node.max_batch = std::max<size_t>(1, node.max_batch);
+        entry.depth = depth;
+        nodes_.push_back(std::move(entry));
+        if (levels_.size() <= depth) {
+            levels_.resize(depth + 1);
+        }
+        levels_[depth].push_back(nodes_.size() - 1);
+        logger_.info("Pipeline node '" + node.name + "' added (" + node.backend->getName() +
+                     (node.input.empty() ? ", input: frame" : ", input: " + node.input) + ")");
+        return true;
+    }
+
+    size_t size() const {
+        return nodes_.size();
+    }
+
+    /**
+     * @brief Run every node on one BGR frame
+     */
+    PipelineResult run(const cv::Mat& frame) {
+        auto start = std::chrono::steady_clock::now();
+        PipelineResult result;
+        if (frame.empty() || nodes_.empty()) {
+            result.ok = false;
+            return result;
+        }
+
+        // Inputs of every node, kept until downstream nodes have taken their crops
+        std::vector<NodeInputs> inputs(nodes_.size());
+        std::vector<PipelineNodeOutput> outputs(nodes_.size());
+        std::vector<std::future<void>> branches;
+
+        for (const auto& level : levels_) {
+            for (size_t index : level) {
+                gatherInputs(index, frame, inputs, outputs);
+            }
+            // Independent nodes of this depth: all but the last on the pool
+            for (size_t i = 0; i + 1 < level.size(); ++i) {
+                size_t index = level[i];
+                branches.push_back(branch_pool_.submit([this, index, &inputs, &outputs]() {
+                    runNode(index, inputs[index], outputs[index]);
+                }));
+            }
+            runNode(level.back(), inputs[level.back()], outputs[level.back()]);
+            for (auto& branch : branches) {
+                branch.get();
+            }
+            branches.clear();
+        }
+
+        for (size_t index = 0; index < nodes_.size(); ++index) {
+            result.ok = result.ok && outputs[index].ok;
+            result.nodes[nodes_[index].node.name] = std::move(outputs[index]);
+        }
+        result.latency_ms = elapsedMs(start);
+        performance_monitor_.recordStage("total", result.latency_ms);
+        return result;
+    }
+
+    PerformanceMonitor& getPerformanceMonitor() { return performance_monitor_; }
+    const PerformanceMonitor& getPerformanceMonitor() const { return performance_monitor_; }
+
+    /**
+     * @brief Node layout and per-node latency as a JSON object
+     */
+    std::string getInfoJson() const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"nodes\":[";
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            const PipelineNode& node = nodes_[i].node;
+            if (i > 0) json << ",";
+            json << "{\"name\":\"" << node.name << "\",\"input\":\"" << node.input << "\",\"backend\":\""
+                 << node.backend->getName() << "\",\"detector\":" << (node.regions ? "true" : "false")
+                 << ",\"depth\":" << nodes_[i].depth << ",\"max_batch\":" << node.max_batch << "}";
+        }
+        json << "],";
+        json << "\"latency\":" << performance_monitor_.getStageLatencyJson();
+        json << "}";
+        return json.str();
+    }
+
+    /**
+     * @brief Decoder for SSD-style detection outputs ([1,1,N,7]: image, class, score, x1, y1, x2, y2 normalized)
+     *
+     * This is the layout of the DetectionOutput layer OpenCV DNN produces
+     * for SSD models; with a batch, rows are matched by their image column.
+     */
+    static RegionDecoder ssdDecoder(float min_score = 0.5f) {
+        return [min_score](const std::vector<cv::Mat>& outputs, size_t index, const cv::Size& image_size) {
+            std::vector<PipelineRegion> regions;
+            if (outputs.empty() || outputs[0].total() % 7 != 0) {
+                return regions;
+            }
+            cv::Mat detections(static_cast<int>(outputs[0].total() / 7), 7, CV_32F, const_cast<float*>(outputs[0].ptr<float>()));
+            for (int row = 0; row < detections.rows; ++row) {
+                const float* det = detections.ptr<float>(row);
+                if (static_cast<size_t>(det[0]) != index || det[2] < min_score) {
+                    continue;
+                }
+                PipelineRegion region;
+                region.class_id = static_cast<int>(det[1]);
+                region.score = det[2];
+                region.box = cv::Rect(cv::Point(cvRound(det[3] * image_size.width), cvRound(det[4] * image_size.height)),
+                                      cv::Point(cvRound(det[5] * image_size.width), cvRound(det[6] * image_size.height)));
+                regions.push_back(region);
+            }
+            return regions;
+        };
+    }
+
+private:
+    struct NodeEntry {
+        PipelineNode node;
+        size_t depth = 0;
+    };
+
+    struct NodeInputs {
+        std::vector<cv::Mat> images;   // Views into the frame
+        std::vector<cv::Rect> boxes;
+        std::vector<int> sources;
+    };
+
+    std::vector<NodeEntry> nodes_;
+    std::vector<std::vector<size_t>> levels_;  // Node indices by depth
+    ThreadPool branch_pool_;
+    PerformanceMonitor performance_monitor_;
+    ModuleLogger logger_;
+
+    int findNode(const std::string& name) const {
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i].node.name == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Take the frame, or views of the upstream node's accepted regions
+     */
+    void gatherInputs(size_t index, const cv::Mat& frame, std::vector<NodeInputs>& inputs,
+                      const std::vector<PipelineNodeOutput>& outputs) const {
+        const PipelineNode& node = nodes_[index].node;
+        NodeInputs& target = inputs[index];
+        if (node.input.empty()) {
+            target.images.push_back(frame);
+            target.boxes.emplace_back(0, 0, frame.cols, frame.rows);
+            target.sources.push_back(-1);
+            return;
+        }
+
+        size_t parent = static_cast<size_t>(findNode(node.input));
+        const NodeInputs& upstream = inputs[parent];
+        const std::vector<PipelineRegion>& regions = outputs[parent].regions;
+        for (size_t i = 0; i < regions.size(); ++i) {
+            const PipelineRegion& region = regions[i];
+            if (node.accept && !node.accept(region)) {
+                continue;
+            }
+            // Region is in frame coordinates; crop its source image in local ones
+            const cv::Rect& source_box = upstream.boxes[region.source];
+            target.images.push_back(upstream.images[region.source](region.box - source_box.tl()));
+            target.boxes.push_back(region.box);
+            target.sources.push_back(static_cast<int>(i));
+        }
+    }
+
+    void runNode(size_t index, const NodeInputs& inputs, PipelineNodeOutput& output) {
+        const PipelineNode& node = nodes_[index].node;
+        auto start = std::chrono::steady_clock::now();
+        output.boxes = inputs.boxes;
+        output.sources = inputs.sources;
+
+        std::vector<cv::Mat> batch;
+        std::vector<cv::Mat> raw_outputs;
+        batch.reserve(std::min(node.max_batch, inputs.images.size()));
+        try {
+            for (size_t offset = 0; offset < inputs.images.size(); offset += node.max_batch) {
+                size_t count = std::min(node.max_batch, inputs.images.size() - offset);
+                batch.assign(inputs.images.begin() + offset, inputs.images.begin() + offset + count);
+                if (!node.backend->runBatch(batch, raw_outputs)) {
+                    output.ok = false;
+                    break;
+                }
+                if (node.regions) {
+                    for (size_t i = 0; i < count; ++i) {
+                        appendRegions(node.regions(raw_outputs, i, batch[i].size()), inputs.boxes[offset + i],
+                                      static_cast<int>(offset + i), output.regions);
+                    }
+                } else {
+                    std::vector<InferenceResult> decoded = node.backend->decode(raw_outputs, count);
+                    output.results.insert(output.results.end(), decoded.begin(), decoded.end());
+                }
+            }
+        } catch (const std::exception& e) {
+            logger_.error("Pipeline node '" + node.name + "' failed: " + e.what());
+            output.ok = false;
+        }
+        if (!output.ok) {
+            output.results.clear();
+            output.regions.clear();
+        } else if (!node.regions && output.results.size() != inputs.images.size()) {
+            output.ok = false;
+            output.results.clear();
+        }
+
+        output.latency_ms = elapsedMs(start);
+        performance_monitor_.recordStage(node.name, output.latency_ms);
+    }
+
+    /**
+     * @brief Clip decoded regions to their image and move them to frame coordinates
+     */
+    static void appendRegions(const std::vector<PipelineRegion>& decoded, const cv::Rect& source_box, int source,
+                              std::vector<PipelineRegion>& regions) {
+        cv::Rect bounds(0, 0, source_box.width, source_box.height);
+        for (PipelineRegion region : decoded) {
+            region.box &= bounds;
+            if (region.box.empty()) {
+                continue;
+            }
+            region.box += source_box.tl();
+            region.source = source;
+            regions.push_back(region);
+        }
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
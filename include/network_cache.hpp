@@ -0,0 +1,229 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <system_error>
+#include <cstdint>
+#include <ctime>
+#include <cstdio>
+#include <opencv2/opencv.hpp>
+#include "inference_backend.hpp"
+#include "content_hash.hpp"
+#include "logger.hpp"
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Optimized-network Cache - Header-only implementation
+ *
+ * Stores what a backend exports after optimizing a model (exportOptimized())
+ * under a key made of the backend name and a hash of the model file, the
+ * runtime version, the CPU features and the input size, so a later start on
+ * the same kind of machine can skip parsing and optimization. A changed
+ * model, runtime upgrade or different CPU simply misses.
+ *
+ * Each key is two files in the cache directory: <key>.bin (the artifact)
+ * and <key>.json (what it was built from). Both are written to a temporary
+ * name and renamed, so instances starting together during a rolling deploy
+ * never read a partial file.
+ */
+class NetworkCache {
+public:
+    explicit NetworkCache(const std::string& directory) : directory_(directory), logger_("NETCACHE") {}
+
+    /**
+     * @brief CPU features the optimized kernels may depend on, e.g. "sse4.2,avx,avx2,fma3"
+     */
+    static std::string cpuFeatures() {
+        static const struct {
+            int id;
+            const char* name;
+        } features[] = {
+            {CV_CPU_SSE4_2, "sse4.2"}, {CV_CPU_AVX, "avx"}, {CV_CPU_AVX2, "avx2"},
+            {CV_CPU_FMA3, "fma3"}, {CV_CPU_AVX_512F, "avx512f"}, {CV_CPU_NEON, "neon"},
+        };
+        std::string list;
+        for (const auto& feature : features) {
+            if (cv::checkHardwareSupport(feature.id)) {
+                if (!list.empty()) list += ",";
+                list += feature.name;
+            }
+        }
+        return list.empty() ? "baseline" : list;
+    }
+
+    /**
+     * @brief Cache key for a model on a backend; false if the model file cannot be read
+     */
+    static bool makeKey(const InferenceBackend& backend, const ModelConfig& config, std::string& key) {
+        Hash128 model_hash;
+        if (!hashFile(config.model_path, model_hash)) {
+            return false;
+        }
+        std::ostringstream identity;
+        identity << model_hash.toHex() << "|" << backend.getName() << "|" << backend.getRuntimeVersion() << "|"
+                 << cpuFeatures() << "|" << config.input_width << "x" << config.input_height;
+        std::string text = identity.str();
+        key = backend.getName() + "-" + hash128(text.data(), text.size()).toHex();
+        return true;
+    }
+
+    /**
+     * @brief Load the backend from the cache if possible, otherwise normally and fill the cache
+     *
+     * The outcome is recorded in the backend's NetworkCacheStatus. Backends
+     * that cannot export load directly, without hashing the model file.
+     */
+    bool loadBackend(InferenceBackend& backend, const ModelConfig& config) {
+        NetworkCacheStatus status;
+        status.enabled = true;
+
+        if (!backend.supportsOptimizedExport()) {
+            status.state = "unsupported";
+            bool loaded = backend.load(config);
+            backend.setNetworkCacheStatus(status);
+            return loaded;
+        }
+
+        auto key_start = std::chrono::steady_clock::now();
+        bool have_key = makeKey(backend, config, status.key);
+        status.key_ms = elapsedMs(key_start);
+        if (!have_key) {
+            logger_.warn("Model file could not be hashed, loading without cache: " + config.model_path);
+            status.state = "error";
+            bool loaded = backend.load(config);
+            backend.setNetworkCacheStatus(status);
+            return loaded;
+        }
+
+        std::vector<uint8_t> artifact;
+        auto read_start = std::chrono::steady_clock::now();
+        bool found = readFile(artifactPath(status.key), artifact);
+        status.io_ms = elapsedMs(read_start);
+        if (found && backend.loadOptimized(config, artifact)) {
+            status.state = "hit";
+            status.artifact_bytes = artifact.size();
+            backend.setNetworkCacheStatus(status);
+            logger_.info("Loaded optimized network from cache (" + status.key + ")");
+            return true;
+        }
+        if (found) {
+            logger_.warn("Cached network rejected by backend, rebuilding: " + status.key);
+        }
+
+        if (!backend.load(config)) {
+            backend.setNetworkCacheStatus(status);
+            return false;
+        }
+
+        artifact.clear();
+        if (!backend.exportOptimized(artifact)) {
+            status.state = "unsupported";
+            logger_.info("Backend '" + backend.getName() + "' cannot export its optimized network, nothing cached");
+        } else {
+            auto write_start = std::chrono::steady_clock::now();
+            bool stored = store(status.key, artifact, describe(backend, config));
+            status.io_ms += elapsedMs(write_start);
+            status.state = stored ? "stored" : "error";
+            status.artifact_bytes = artifact.size();
+            if (stored) {
+                logger_.info("Optimized network cached (" + status.key + ", " + std::to_string(artifact.size()) + " bytes)");
+            }
+        }
+        backend.setNetworkCacheStatus(status);
+        return true;
+    }
+
+    const std::string& getDirectory() const {
+        return directory_;
+    }
+
+    std::string artifactPath(const std::string& key) const {
+        return (std::filesystem::path(directory_) / (key + ".bin")).string();
+    }
+
+    std::string manifestPath(const std::string& key) const {
+        return (std::filesystem::path(directory_) / (key + ".json")).string();
+    }
+
+private:
+    std::string directory_;
+    ModuleLogger logger_;
+
+    bool store(const std::string& key, const std::vector<uint8_t>& artifact, const std::string& manifest) {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) {
+            logger_.error("Cannot create network cache directory " + directory_ + ": " + error.message());
+            return false;
+        }
+        // Artifact last: its presence is what makes the entry visible
+        return writeFileAtomic(manifestPath(key), manifest.data(), manifest.size()) &&
+               writeFileAtomic(artifactPath(key), artifact.data(), artifact.size());
+    }
+
+    std::string describe(const InferenceBackend& backend, const ModelConfig& config) const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"model\":\"" << config.model_path << "\",";
+        json << "\"backend\":\"" << backend.getName() << "\",";
+        json << "\"runtime\":\"" << backend.getRuntimeVersion() << "\",";
+        json << "\"cpu_features\":\"" << cpuFeatures() << "\",";
+        json << "\"input\":[" << config.input_width << "," << config.input_height << "],";
+        json << "\"created\":" << static_cast<long long>(std::time(nullptr));
+        json << "}\n";
+        return json.str();
+    }
+
+    bool writeFileAtomic(const std::string& path, const void* data, size_t size) {
+#ifdef _WIN32
+        std::string temp = path + ".tmp" + std::to_string(_getpid());
+#else
+        std::string temp = path + ".tmp" + std::to_string(getpid());
+#endif
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            if (!out) {
+                logger_.error("Cannot write network cache file " + temp);
+                std::remove(temp.c_str());
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temp, path, error);
+        if (error) {
+            logger_.error("Cannot move network cache file into place " + path + ": " + error.message());
+            std::remove(temp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    static bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            return false;
+        }
+        std::streamsize size = in.tellg();
+        if (size <= 0) {
+            return false;
+        }
+        data.resize(static_cast<size_t>(size));
+        in.seekg(0);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(data.data()), size));
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
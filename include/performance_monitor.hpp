@@ -11,6 +11,11 @@
 #include <numeric>
 #include <vector>
 #include <limits>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include "latency_histogram.hpp"
 
 /**
  * @brief Performance Monitor Class - Header-only implementation
@@ -31,9 +36,48 @@ public:
 
     /**
      * @brief End timing a frame and update metrics
+     *
+     * @param frames Frames completed by this timed span (e.g. one per stream)
      */
-    void endFrame() {
-        pImpl->endFrame();
+    void endFrame(uint64_t frames = 1) {
+        pImpl->endFrame(frames);
+    }
+
+    /**
+     * @brief Count frames lost before processing (ring overflow, older queued frames, age budget)
+     */
+    void recordDropped(uint64_t frames = 1) {
+        pImpl->recordDropped(frames);
+    }
+
+    /**
+     * @brief Count frames left out on purpose by the rate policy (every_nth, target_fps)
+     *
+     * Not part of the drop rate, so a healthy throttled stream reads 0%.
+     */
+    void recordSkipped(uint64_t frames = 1) {
+        pImpl->recordSkipped(frames);
+    }
+
+    /**
+     * @brief Count failed captures; these are never counted as processed frames
+     */
+    void recordFailed(uint64_t frames = 1) {
+        pImpl->failed_frames += frames;
+    }
+
+    /**
+     * @brief Record the latency of one named stage (e.g. a pipeline node); thread-safe
+     */
+    void recordStage(const std::string& name, double latency_ms) {
+        pImpl->recordStage(name, latency_ms);
+    }
+
+    /**
+     * @brief Latency histograms of all recorded stages as a JSON object keyed by name
+     */
+    std::string getStageLatencyJson() const {
+        return pImpl->getStageLatencyJson();
     }
 
     /**
@@ -78,6 +122,41 @@ public:
         return pImpl->getTotalFrames();
     }
 
+    /**
+     * @brief Get frames dropped before processing
+     */
+    uint64_t getDroppedFrames() const {
+        return pImpl->dropped_frames;
+    }
+
+    /**
+     * @brief Get frames skipped by the rate policy
+     */
+    uint64_t getSkippedFrames() const {
+        return pImpl->skipped_frames;
+    }
+
+    /**
+     * @brief Get failed capture count
+     */
+    uint64_t getFailedFrames() const {
+        return pImpl->failed_frames;
+    }
+
+    /**
+     * @brief Get fraction of admitted frames that were dropped (0.0 - 1.0, rate skips excluded)
+     */
+    double getDropRate() const {
+        return pImpl->getDropRate();
+    }
+
+    /**
+     * @brief Get rate at which frames were offered (processed + dropped + skipped per second)
+     */
+    double getInputFPS() const {
+        return pImpl->current_input_fps;
+    }
+
     /**
      * @brief Get performance statistics as formatted string
      */
@@ -119,15 +198,24 @@ private:
         static constexpr size_t MAX_FRAME_HISTORY = 60; // Keep 60 frames for averaging
         
         // Statistics
-        uint64_t total_frames = 0;
+        std::atomic<uint64_t> total_frames{0};
+        std::atomic<uint64_t> dropped_frames{0};
+        std::atomic<uint64_t> skipped_frames{0};
+        std::atomic<uint64_t> failed_frames{0};
         double current_frame_time = 0.0;
         double min_frame_time = std::numeric_limits<double>::max();
         double max_frame_time = 0.0;
         
         // FPS calculation
         uint64_t fps_frame_count = 0;
+        std::atomic<uint64_t> fps_unprocessed_count{0};   // Dropped + skipped in the current FPS window
         TimePoint fps_start_time;
         double current_fps = 0.0;
+        double current_input_fps = 0.0;
+        
+        // Named stage latencies; histograms are never removed, so references stay valid
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> stage_latency;
+        mutable std::mutex stage_mutex;
         
         Impl() {
             auto now = std::chrono::high_resolution_clock::now();
@@ -140,7 +228,7 @@ private:
             frame_start_time = std::chrono::high_resolution_clock::now();
         }
         
-        void endFrame() {
+        void endFrame(uint64_t frames) {
             auto frame_end_time = std::chrono::high_resolution_clock::now();
             
             // Calculate frame processing time
@@ -148,8 +236,8 @@ private:
             current_frame_time = frame_duration.count();
             
             // Update statistics
-            total_frames++;
-            fps_frame_count++;
+            total_frames += frames;
+            fps_frame_count += frames;
             
             // Update min/max times
             min_frame_time = std::min(min_frame_time, current_frame_time);
@@ -165,15 +253,59 @@ private:
             Duration fps_duration = frame_end_time - fps_start_time;
             if (fps_duration.count() >= 1000.0) { // 1 second
                 current_fps = fps_frame_count / (fps_duration.count() / 1000.0);
+                current_input_fps = (fps_frame_count + fps_unprocessed_count.exchange(0)) / (fps_duration.count() / 1000.0);
                 fps_frame_count = 0;
                 fps_start_time = frame_end_time;
             }
         }
         
+        void recordDropped(uint64_t frames) {
+            dropped_frames += frames;
+            fps_unprocessed_count += frames;
+        }
+        
+        void recordSkipped(uint64_t frames) {
+            skipped_frames += frames;
+            fps_unprocessed_count += frames;
+        }
+        
+        void recordStage(const std::string& name, double latency_ms) {
+            LatencyHistogram* histogram = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(stage_mutex);
+                auto& slot = stage_latency[name];
+                if (!slot) {
+                    slot = std::make_unique<LatencyHistogram>();
+                }
+                histogram = slot.get();
+            }
+            histogram->record(latency_ms);
+        }
+        
+        std::string getStageLatencyJson() const {
+            std::lock_guard<std::mutex> lock(stage_mutex);
+            std::ostringstream json;
+            json << "{";
+            bool first = true;
+            for (const auto& stage : stage_latency) {
+                if (!first) json << ",";
+                json << "\"" << stage.first << "\":" << stage.second->toJson();
+                first = false;
+            }
+            json << "}";
+            return json.str();
+        }
+        
         double getFPS() const {
             return current_fps;
         }
         
+        double getDropRate() const {
+            uint64_t dropped = dropped_frames;
+            uint64_t offered = dropped + total_frames;
+            return offered ? static_cast<double>(dropped) / offered : 0.0;
+        }
+        
         double getAverageFrameTime() const {
             if (frame_times.empty()) return 0.0;
             
@@ -207,6 +339,9 @@ private:
             ss << "=== Performance Statistics ===" << std::endl;
             ss << "Runtime: " << std::setprecision(1) << total_seconds << "s" << std::endl;
             ss << "Total Frames: " << total_frames << std::endl;
+            ss << "Dropped Frames: " << dropped_frames << " (" << std::setprecision(1) << (getDropRate() * 100.0) << "%)" << std::endl;
+            ss << "Skipped Frames (rate policy): " << skipped_frames << std::endl;
+            ss << "Failed Captures: " << failed_frames << std::endl;
             ss << "Current FPS: " << std::setprecision(1) << current_fps << std::endl;
             ss << "Average FPS: " << std::setprecision(1) << (total_frames / total_seconds) << std::endl;
             ss << std::setprecision(2);
@@ -227,6 +362,12 @@ private:
                 ss << "Frame Time - P99: " << sorted_times[p99_idx] << "ms" << std::endl;
             }
             
+            std::lock_guard<std::mutex> lock(stage_mutex);
+            for (const auto& stage : stage_latency) {
+                ss << "Stage " << stage.first << " - Mean: " << stage.second->getMean()
+                   << "ms, P99: " << stage.second->getPercentile(0.99) << "ms" << std::endl;
+            }
+            
             return ss.str();
         }
         
@@ -238,11 +379,21 @@ private:
             
             frame_times.clear();
             total_frames = 0;
+            dropped_frames = 0;
+            skipped_frames = 0;
+            failed_frames = 0;
             fps_frame_count = 0;
+            fps_unprocessed_count = 0;
+            current_input_fps = 0.0;
             current_frame_time = 0.0;
             min_frame_time = std::numeric_limits<double>::max();
             max_frame_time = 0.0;
             current_fps = 0.0;
+            
+            std::lock_guard<std::mutex> lock(stage_mutex);
+            for (auto& stage : stage_latency) {
+                stage.second->reset();
+            }
         }
         
         bool shouldDisplayStats(double interval_seconds) const {
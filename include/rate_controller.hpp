@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "frame_metadata.hpp"
+
+/**
+ * @brief Which captured frames are admitted to inference
+ */
+enum class RateControlMode {
+    LATEST_ONLY,   // Always the freshest frame; anything older is skipped
+    EVERY_NTH,     // One frame out of every N captured (by sequence number)
+    TARGET_FPS     // At most target_fps frames per second
+};
+
+inline std::string rateControlModeToString(RateControlMode mode) {
+    switch (mode) {
+        case RateControlMode::LATEST_ONLY: return "latest_only";
+        case RateControlMode::EVERY_NTH: return "every_nth";
+        case RateControlMode::TARGET_FPS: return "target_fps";
+        default: return "latest_only";
+    }
+}
+
+inline RateControlMode stringToRateControlMode(const std::string& mode_str) {
+    if (mode_str == "every_nth") return RateControlMode::EVERY_NTH;
+    if (mode_str == "target_fps") return RateControlMode::TARGET_FPS;
+    return RateControlMode::LATEST_ONLY; // default
+}
+
+/**
+ * @brief Rate control configuration
+ */
+struct RateControlConfig {
+    RateControlMode mode = RateControlMode::LATEST_ONLY;
+    uint64_t every_nth = 2;       // EVERY_NTH: admit one of every N frames
+    double target_fps = 10.0;     // TARGET_FPS: admission rate cap
+    double max_frame_age_ms = 0;  // Drop frames older than this before inference (0 = no budget)
+};
+
+/**
+ * @brief Rate Controller Class - Header-only implementation
+ *
+ * Decides per frame whether it goes to inference. Not thread-safe; each
+ * stream owns one and consults it from the processing thread.
+ */
+class RateController {
+public:
+    enum class Decision {
+        ADMIT,
+        SKIP_RATE,    // Not selected by the rate policy
+        DROP_STALE    // Older than the age budget
+    };
+
+    explicit RateController(const RateControlConfig& config = RateControlConfig()) : config_(config) {}
+
+    Decision admit(const FrameMetadata& metadata, FrameMetadata::TimePoint now = FrameMetadata::Clock::now()) {
+        if (config_.max_frame_age_ms > 0 && metadata.ageMs(now) > config_.max_frame_age_ms) {
+            return Decision::DROP_STALE;
+        }
+
+        switch (config_.mode) {
+            case RateControlMode::EVERY_NTH: {
+                uint64_t n = std::max<uint64_t>(1, config_.every_nth);
+                // By sequence, so frames skipped upstream still count toward N
+                if (last_admitted_sequence_ != 0 && metadata.sequence < last_admitted_sequence_ + n) {
+                    return Decision::SKIP_RATE;
+                }
+                break;
+            }
+            case RateControlMode::TARGET_FPS: {
+                auto interval = std::chrono::duration_cast<FrameMetadata::Clock::duration>(
+                    std::chrono::duration<double>(1.0 / std::max(config_.target_fps, 0.001)));
+                if (next_admit_time_ != FrameMetadata::TimePoint{} && now < next_admit_time_) {
+                    return Decision::SKIP_RATE;
+                }
+                // Keep the schedule so the average rate holds, but never bank more than one slot
+                next_admit_time_ = (next_admit_time_ == FrameMetadata::TimePoint{} || now - next_admit_time_ > interval)
+                                   ? now + interval : next_admit_time_ + interval;
+                break;
+            }
+            case RateControlMode::LATEST_ONLY:
+            default:
+                break;
+        }
+
+        last_admitted_sequence_ = metadata.sequence;
+        return Decision::ADMIT;
+    }
+
+    const RateControlConfig& getConfig() const {
+        return config_;
+    }
+
+    void reset() {
+        last_admitted_sequence_ = 0;
+        next_admit_time_ = FrameMetadata::TimePoint{};
+    }
+
+private:
+    RateControlConfig config_;
+    uint64_t last_admitted_sequence_ = 0;
+    FrameMetadata::TimePoint next_admit_time_{};
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <list>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <algorithm>
+#include "content_hash.hpp"
+
+/**
+ * @brief Result cache configuration
+ */
+struct ResultCacheConfig {
+    bool enabled = false;
+    size_t max_bytes = 64 * 1024 * 1024;  // Bound on entries including bookkeeping
+    size_t shards = 16;                   // Independent locks; keys are spread by hash
+};
+
+/**
+ * @brief Result cache statistics snapshot
+ */
+struct ResultCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;
+    uint64_t invalidations = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t capacity_bytes = 0;
+
+    double hitRatio() const {
+        uint64_t lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / lookups : 0.0;
+    }
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(4);
+        json << "{";
+        json << "\"hits\":" << hits << ",";
+        json << "\"misses\":" << misses << ",";
+        json << "\"hit_ratio\":" << hitRatio() << ",";
+        json << "\"insertions\":" << insertions << ",";
+        json << "\"evictions\":" << evictions << ",";
+        json << "\"invalidations\":" << invalidations << ",";
+        json << "\"entries\":" << entries << ",";
+        json << "\"bytes\":" << bytes << ",";
+        json << "\"capacity_bytes\":" << capacity_bytes;
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Content-addressed LRU Result Cache - Header-only implementation
+ *
+ * Maps (128-bit input hash, model version) to a result. The byte budget is
+ * split evenly across shards; each shard has its own lock, LRU list and
+ * index, so handler threads only contend when their keys land in the same
+ * shard. Bumping the model version makes every older entry unreachable;
+ * clear() frees them at once.
+ */
+template <typename Value>
+class ResultCache {
+public:
+    struct Key {
+        Hash128 hash;
+        uint64_t model_version = 0;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash && model_version == other.model_version;
+        }
+    };
+
+    explicit ResultCache(const ResultCacheConfig& config = ResultCacheConfig()) : config_(config) {
+        config_.shards = std::max<size_t>(1, config_.shards);
+        shard_capacity_ = config_.max_bytes / config_.shards;
+        shards_.reserve(config_.shards);
+        for (size_t i = 0; i < config_.shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+    }
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    static Key makeKey(const void* data, size_t length, uint64_t model_version) {
+        Key key;
+        key.hash = hash128(data, length);
+        key.model_version = model_version;
+        return key;
+    }
+
+    /**
+     * @brief Look up a result and mark it most recently used
+     */
+    bool get(const Key& key, Value& value) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        value = it->second->value;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Insert or replace a result, evicting least recently used entries over budget
+     *
+     * @param value_bytes Heap memory owned by the value beyond sizeof(Value)
+     */
+    void put(const Key& key, const Value& value, size_t value_bytes = 0) {
+        size_t entry_bytes = ENTRY_OVERHEAD + value_bytes;
+        if (entry_bytes > shard_capacity_) {
+            return; // Would evict the whole shard for one entry
+        }
+
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.bytes -= it->second->bytes;
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+
+        shard.lru.push_front(Entry{key, value, entry_bytes});
+        shard.index[key] = shard.lru.begin();
+        shard.bytes += entry_bytes;
+        insertions_.fetch_add(1, std::memory_order_relaxed);
+
+        while (shard.bytes > shard_capacity_) {
+            Entry& victim = shard.lru.back();
+            shard.bytes -= victim.bytes;
+            shard.index.erase(victim.key);
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Drop every entry (e.g. after a model reload)
+     */
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->lru.clear();
+            shard->index.clear();
+            shard->bytes = 0;
+        }
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ResultCacheStats getStats() const {
+        ResultCacheStats stats;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.insertions = insertions_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+        stats.capacity_bytes = shard_capacity_ * shards_.size();
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            stats.entries += shard->index.size();
+            stats.bytes += shard->bytes;
+        }
+        return stats;
+    }
+
+    void resetStats() {
+        hits_ = 0;
+        misses_ = 0;
+        insertions_ = 0;
+        evictions_ = 0;
+        invalidations_ = 0;
+    }
+
+    const ResultCacheConfig& getConfig() const {
+        return config_;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t bytes;
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const {
+            // Shards take the low bits; the index uses the high half
+            return static_cast<size_t>(key.hash.high ^ (key.model_version * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;  // Front = most recently used
+        std::unordered_map<Key, typename std::list<Entry>::iterator, KeyHasher> index;
+        size_t bytes = 0;
+    };
+
+    // List node, hash node and bucket slot, approximately
+    static constexpr size_t ENTRY_OVERHEAD = sizeof(Entry) + 2 * sizeof(void*) +
+                                             sizeof(Key) + 3 * sizeof(void*);
+
+    ResultCacheConfig config_;
+    size_t shard_capacity_ = 0;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> insertions_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> invalidations_{0};
+
+    Shard& shardFor(const Key& key) {
+        return *shards_[key.hash.low % shards_.size()];
+    }
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <opencv2/opencv.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_DISPATCH_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SIMD_DISPATCH_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang only emit AVX code inside functions that ask for it; MSVC accepts the intrinsics anywhere
+#if defined(SIMD_DISPATCH_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+
+/**
+ * @brief Instruction set a kernel runs with
+ *
+ * Kernels are compiled for every path the compiler can target and picked
+ * at run time, so the default build flags (no -march) still use AVX2 or
+ * AVX-512 on CPUs that have them.
+ */
+enum class SimdPath {
+    SCALAR = 0,
+    NEON = 1,
+    AVX2 = 2,     // AVX2 + FMA
+    AVX512 = 3    // AVX-512F
+};
+
+inline std::string simdPathToString(SimdPath path) {
+    switch (path) {
+        case SimdPath::SCALAR: return "scalar";
+        case SimdPath::NEON: return "neon";
+        case SimdPath::AVX2: return "avx2";
+        case SimdPath::AVX512: return "avx512";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Paths this CPU can run, scalar first and best last
+ */
+inline std::vector<SimdPath> availableSimdPaths() {
+    std::vector<SimdPath> paths{SimdPath::SCALAR};
+#if defined(SIMD_DISPATCH_NEON)
+    paths.push_back(SimdPath::NEON);
+#elif defined(SIMD_DISPATCH_X86)
+    if (cv::checkHardwareSupport(CV_CPU_AVX2) && cv::checkHardwareSupport(CV_CPU_FMA3)) {
+        paths.push_back(SimdPath::AVX2);
+    }
+    if (cv::checkHardwareSupport(CV_CPU_AVX_512F)) {
+        paths.push_back(SimdPath::AVX512);
+    }
+#endif
+    return paths;
+}
+
+inline SimdPath bestSimdPath() {
+    return availableSimdPaths().back();
+}
+
+inline bool isSimdPathAvailable(SimdPath path) {
+    for (SimdPath available : availableSimdPaths()) {
+        if (available == path) {
+            return true;
+        }
+    }
+    return false;
+}
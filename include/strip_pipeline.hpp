@@ -0,0 +1,342 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "thread_pool.hpp"
+#include "logger.hpp"
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+/**
+ * @brief One step of a StripPipeline
+ *
+ * apply(src, dst) must produce an image the size of src, as OpenCV
+ * filters do. A row stage's output row r may depend only on input rows
+ * r - halo .. r + halo (0 = per pixel, 2 for a 5x5 blur, 1 for a 3x3
+ * dilate). A whole stage (Canny: hysteresis follows edges across the frame)
+ * sees the full image and splits the chain into strip phases.
+ */
+struct StripStage {
+    using Apply = std::function<void(const cv::Mat& src, cv::Mat& dst)>;
+
+    std::string name;
+    int halo = 0;
+    bool whole_image = false;
+    int output_type = -1;     // Type apply() writes (-1 = same as its input)
+    Apply apply;
+
+    static StripStage rows(const std::string& name, int halo, int output_type, Apply apply) {
+        StripStage stage;
+        stage.name = name;
+        stage.halo = std::max(0, halo);
+        stage.output_type = output_type;
+        stage.apply = std::move(apply);
+        return stage;
+    }
+
+    static StripStage whole(const std::string& name, int output_type, Apply apply) {
+        StripStage stage;
+        stage.name = name;
+        stage.whole_image = true;
+        stage.output_type = output_type;
+        stage.apply = std::move(apply);
+        return stage;
+    }
+};
+
+/**
+ * @brief Strip pipeline configuration
+ */
+struct StripConfig {
+    size_t threads = 0;          // Strip workers including the caller (0 = one per hardware thread, 1 = caller only)
+    size_t cache_bytes = 0;      // Working set per strip, all stages (0 = half this CPU's L2)
+    int min_strip_rows = 16;     // Lower bound, so recomputed halo rows stay a small share
+};
+
+/**
+ * @brief Cache-blocked Classical CV Chain - Header-only implementation
+ *
+ * Runs a chain of full-frame operations (cvtColor -> GaussianBlur -> ...)
+ * strip by strip instead of stage by stage: each horizontal strip goes
+ * through every row stage of a phase while its rows are still in L2,
+ * rather than each stage streaming the whole frame through memory.
+ *
+ * - Strip height comes from the cache budget and the row bytes of every
+ *   stage in the phase, capped so each participant gets at least one.
+ * - Each strip recomputes the halo rows its stages need (the sum of the
+ *   phase's halos) in per-thread scratch Mats, so strips never wait for
+ *   their neighbours. The first stage of a phase reads a view of the
+ *   phase input (a private copy if it has a halo); every later stage gets
+ *   a whole Mat, which keeps OpenCV on the same code path (and border
+ *   handling at the frame edges) as the serial chain.
+ * - Whole-image stages run once between phases; everything else is
+ *   shared by the caller and a pool through a strip counter.
+ *
+ * Rows a strip keeps never depend on extrapolated rows, so the output is
+ * bit-identical to runSerial(). Scratch Mats only grow; steady-state frames
+ * allocate nothing but the per-phase task handles. Not thread-safe: one
+ * run() at a time.
+ */
+class StripPipeline {
+public:
+    explicit StripPipeline(std::vector<StripStage> stages, const StripConfig& config = StripConfig())
+        : stages_(std::move(stages)), config_(config), logger_("STRIPS") {
+        participants_ = config_.threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency()) : config_.threads;
+        if (participants_ > 1) {
+            pool_ = std::make_unique<ThreadPool>(participants_ - 1, "STRIPS");
+        }
+        cache_bytes_ = config_.cache_bytes > 0 ? config_.cache_bytes : l2CacheBytes() / 2;
+        config_.min_strip_rows = std::max(1, config_.min_strip_rows);
+
+        for (size_t i = 0; i < stages_.size();) {
+            Phase phase;
+            phase.first = i;
+            phase.whole_image = stages_[i].whole_image;
+            do {
+                phase.halo += stages_[i].halo;
+                ++i;
+            } while (!phase.whole_image && i < stages_.size() && !stages_[i].whole_image);
+            phase.last = i;
+            phases_.push_back(phase);
+        }
+        scratch_.resize(participants_, std::vector<cv::Mat>(stages_.size() + 1));
+        serial_buffers_.resize(stages_.size());
+        phase_outputs_.resize(phases_.size());
+    }
+
+    StripPipeline(const StripPipeline&) = delete;
+    StripPipeline& operator=(const StripPipeline&) = delete;
+
+    /**
+     * @brief Run the chain strip-parallel; output may be input (in place)
+     */
+    bool run(const cv::Mat& input, cv::Mat& output) {
+        if (input.empty() || stages_.empty()) {
+            return false;
+        }
+        try {
+            cv::Mat current = input;   // Holds the input even if output is the same Mat
+            int type = input.type();
+            for (size_t p = 0; p < phases_.size(); ++p) {
+                const Phase& phase = phases_[p];
+                for (size_t i = phase.first; i < phase.last; ++i) {
+                    type = outputType(stages_[i], type);
+                }
+                cv::Mat& target = (p + 1 == phases_.size()) ? output : phase_outputs_[p];
+                if (phase.whole_image) {
+                    stages_[phase.first].apply(current, target);
+                } else {
+                    // Neighbouring strips read rows this phase overwrites
+                    if (phase.halo > 0 && overlaps(current, target)) {
+                        current.copyTo(input_copy_);
+                        current = input_copy_;
+                    }
+                    target.create(current.size(), type);
+                    if (!runPhase(p, current, target)) {
+                        return false;
+                    }
+                }
+                current = target;
+            }
+            return true;
+        } catch (const std::exception& e) {
+            logger_.error("Strip pipeline failed: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    /**
+     * @brief Reference: every stage over the whole frame, one after another
+     */
+    bool runSerial(const cv::Mat& input, cv::Mat& output) {
+        if (input.empty() || stages_.empty()) {
+            return false;
+        }
+        try {
+            cv::Mat current = input;
+            for (size_t i = 0; i < stages_.size(); ++i) {
+                cv::Mat& target = (i + 1 == stages_.size()) ? output : serial_buffers_[i];
+                stages_[i].apply(current, target);
+                current = target;
+            }
+            return true;
+        } catch (const std::exception& e) {
+            logger_.error("Serial pipeline failed: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    /**
+     * @brief Strip height for a phase starting with input rows of this size and type
+     */
+    int computeStripRows(size_t phase_index, const cv::Size& size, int input_type) const {
+        const Phase& phase = phases_.at(phase_index);
+        size_t row_bytes = static_cast<size_t>(size.width) * CV_ELEM_SIZE(input_type);
+        int type = input_type;
+        for (size_t i = phase.first; i < phase.last; ++i) {
+            type = outputType(stages_[i], type);
+            row_bytes += static_cast<size_t>(size.width) * CV_ELEM_SIZE(type);
+        }
+        int rows = static_cast<int>(std::min<size_t>(cache_bytes_ / std::max<size_t>(1, row_bytes), size.height));
+        int fair = static_cast<int>((size.height + participants_ - 1) / participants_);
+        rows = std::max(std::min(rows, fair), std::max(config_.min_strip_rows, 4 * phase.halo));
+        return std::max(1, std::min(rows, size.height));
+    }
+
+    size_t getThreadCount() const {
+        return participants_;
+    }
+
+    size_t getPhaseCount() const {
+        return phases_.size();
+    }
+
+    /**
+     * @brief L2 size reported by the OS (1 MiB when unknown)
+     */
+    static size_t l2CacheBytes() {
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+        long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (bytes > 0) {
+            return static_cast<size_t>(bytes);
+        }
+#endif
+        return 1 << 20;
+    }
+
+private:
+    struct Phase {
+        size_t first = 0;     // Stages [first, last)
+        size_t last = 0;
+        int halo = 0;         // Rows recomputed above and below each strip
+        bool whole_image = false;
+    };
+
+    std::vector<StripStage> stages_;
+    StripConfig config_;
+    size_t participants_ = 1;
+    size_t cache_bytes_ = 0;
+    std::unique_ptr<ThreadPool> pool_;
+    std::vector<Phase> phases_;
+    std::vector<std::vector<cv::Mat>> scratch_;   // [participant][stage] byte storage, last slot: input copy
+    std::vector<cv::Mat> serial_buffers_;
+    std::vector<cv::Mat> phase_outputs_;
+    cv::Mat input_copy_;
+    ModuleLogger logger_;
+
+    static int outputType(const StripStage& stage, int input_type) {
+        return stage.output_type < 0 ? input_type : stage.output_type;
+    }
+
+    /**
+     * @brief A whole (non-view) Mat header over grow-only storage
+     *
+     * Strips differ in height at the frame edges; create() on a plain Mat
+     * would reallocate at every change. OpenCV treats views differently
+     * from whole Mats (GaussianBlur's bit-exact 8-bit path skips views), so
+     * the header is built over the storage rather than cut out of it.
+     */
+    static cv::Mat scratchRows(cv::Mat& storage, int rows, int cols, int type) {
+        const size_t bytes = static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type);
+        if (storage.empty() || storage.total() < bytes) {
+            storage.create(1, static_cast<int>(bytes), CV_8U);
+        }
+        return cv::Mat(rows, cols, type, storage.data);
+    }
+
+    static bool overlaps(const cv::Mat& a, const cv::Mat& b) {
+        return !a.empty() && !b.empty() && a.datastart < b.dataend && b.datastart < a.dataend;
+    }
+
+    bool runPhase(size_t index, const cv::Mat& src, cv::Mat& dst) {
+        const Phase& phase = phases_[index];
+        const int strip_rows = computeStripRows(index, src.size(), src.type());
+        const size_t strips = static_cast<size_t>((src.rows + strip_rows - 1) / strip_rows);
+        std::atomic<size_t> next{0};
+        std::atomic<bool> ok{true};
+
+        auto work = [&](size_t participant) {
+            for (size_t s = next.fetch_add(1); s < strips; s = next.fetch_add(1)) {
+                int top = static_cast<int>(s) * strip_rows;
+                if (!runStrip(phase, participant, src, dst, top, std::min(src.rows, top + strip_rows))) {
+                    ok = false;
+                }
+            }
+        };
+
+        // The caller works too; helpers only when there is more than one strip
+        std::vector<std::future<void>> pending;
+        const size_t helpers = pool_ ? std::min(participants_ - 1, strips - 1) : 0;
+        pending.reserve(helpers);
+        for (size_t h = 1; h <= helpers; ++h) {
+            pending.push_back(pool_->submit([&work, h]() { work(h); }));
+        }
+        std::exception_ptr failure;
+        try {
+            work(0);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        for (auto& helper : pending) {
+            try {
+                helper.get();
+            } catch (...) {
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        return ok;
+    }
+
+    // Output rows [top, bottom) of one phase
+    bool runStrip(const Phase& phase, size_t participant, const cv::Mat& src, cv::Mat& dst, int top, int bottom) {
+        std::vector<cv::Mat>& scratch = scratch_[participant];
+        const int first = std::max(0, top - phase.halo);
+        const int last = std::min(src.rows, bottom + phase.halo);
+
+        cv::Mat current = src.rowRange(first, last);
+        if (stages_[phase.first].halo > 0) {
+            cv::Mat copy = scratchRows(scratch.back(), last - first, src.cols, src.type());
+            current.copyTo(copy);
+            current = copy;
+        }
+        for (size_t i = phase.first; i < phase.last; ++i) {
+            if (phase.halo == 0 && i + 1 == phase.last) {
+                // Nothing to trim: write the strip straight into the output
+                cv::Mat rows = dst.rowRange(top, bottom);
+                const uchar* data = rows.data;
+                stages_[i].apply(current, rows);
+                if (rows.data != data) {
+                    logger_.error("Stage '" + stages_[i].name + "' did not write its declared output type");
+                    return false;
+                }
+                return true;
+            }
+            cv::Mat next = scratchRows(scratch[i], last - first, src.cols, outputType(stages_[i], current.type()));
+            const uchar* data = next.data;
+            stages_[i].apply(current, next);
+            if (next.data != data) {
+                logger_.error("Stage '" + stages_[i].name + "' did not write its declared output type");
+                return false;
+            }
+            current = next;
+        }
+        cv::Mat rows = dst.rowRange(top, bottom);
+        current.rowRange(top - first, bottom - first).copyTo(rows);
+        return true;
+    }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <atomic>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include "logger.hpp"
+#include "thread_topology.hpp"
+
+/**
+ * @brief Fixed-size Thread Pool - Header-only implementation
+ *
+ * Shared worker pool used for inference work across all streams.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t num_threads = 0, const std::string& name = "POOL",
+                        ThreadRole role = ThreadRole::INFERENCE)
+        : role_(role), logger_(name) {
+        if (num_threads == 0) {
+            num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        workers_.reserve(num_threads);
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this);
+        }
+        logger_.debug("Thread pool started with " + std::to_string(num_threads) + " workers");
+    }
+
+    ~ThreadPool() {
+        shutdown();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a task and get a future for its result
+     */
+    template<typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> result = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                throw std::runtime_error("ThreadPool is shut down");
+            }
+            tasks_.emplace([packaged]() { (*packaged)(); });
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+    /**
+     * @brief Finish queued tasks and join all workers
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        logger_.debug("Thread pool stopped");
+    }
+
+    size_t size() const {
+        return workers_.size();
+    }
+
+    size_t pendingTasks() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tasks_.size();
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_ = false;
+    ThreadRole role_;
+    ModuleLogger logger_;
+
+    void workerLoop() {
+        ScopedThreadRole role(role_);
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_ && tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+};
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief Kinds of long-running threads that can be pinned as a group
+ */
+enum class ThreadRole {
+    CAPTURE = 0,    // Capture threads and source prefetchers
+    INFERENCE = 1,  // Inference workers, batch dispatcher, pipeline branches
+    WEB = 2,        // HTTP accept loop and client handlers
+    LOGGER = 3      // Async log writer
+};
+
+constexpr size_t THREAD_ROLE_COUNT = 4;
+
+inline std::string threadRoleToString(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::CAPTURE: return "capture";
+        case ThreadRole::INFERENCE: return "inference";
+        case ThreadRole::WEB: return "web";
+        case ThreadRole::LOGGER: return "logger";
+        default: return "unknown";
+    }
+}
+
+inline bool threadRoleFromString(const std::string& name, ThreadRole& role) {
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        if (threadRoleToString(static_cast<ThreadRole>(i)) == name) {
+            role = static_cast<ThreadRole>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Set of CPU indices; empty means "not pinned"
+ */
+struct CpuSet {
+    std::vector<int> cpus;
+
+    bool empty() const {
+        return cpus.empty();
+    }
+
+    /**
+     * @brief Parse a list like "0-3,8,10-11"
+     */
+    static bool parse(const std::string& text, CpuSet& set) {
+        std::vector<int> cpus;
+        std::stringstream list(text);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            size_t dash = item.find('-');
+            if (item.empty() || !std::isdigit(static_cast<unsigned char>(item[0])) ||
+                (dash != std::string::npos && !std::isdigit(static_cast<unsigned char>(item[dash + 1])))) {
+                return false;
+            }
+            char* end = nullptr;
+            long first = std::strtol(item.c_str(), &end, 10);
+            long last = first;
+            if (dash != std::string::npos) {
+                if (end != item.c_str() + dash) {
+                    return false;
+                }
+                last = std::strtol(item.c_str() + dash + 1, &end, 10);
+            }
+            if (*end != '\0' || first < 0 || last < first || last > 4095) {
+                return false;
+            }
+            for (long cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+        if (cpus.empty()) {
+            return false;
+        }
+        std::sort(cpus.begin(), cpus.end());
+        cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+        set.cpus = cpus;
+        return true;
+    }
+
+    /**
+     * @brief Compact form, e.g. "0-3,8"
+     */
+    std::string toString() const {
+        std::ostringstream out;
+        for (size_t i = 0; i < cpus.size();) {
+            size_t j = i;
+            while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+                ++j;
+            }
+            if (i > 0) out << ",";
+            out << cpus[i];
+            if (j > i) out << "-" << cpus[j];
+            i = j + 1;
+        }
+        return out.str();
+    }
+};
+
+/**
+ * @brief Thread topology configuration
+ */
+struct ThreadTopologyConfig {
+    // cv::setNumThreads(): size of OpenCV's internal pool, which is also the
+    // intra-op parallelism of the OpenCV DNN backend. -1 = OpenCV default,
+    // 0 or 1 = no internal pool (each inference runs on its worker thread only)
+    int opencv_threads = -1;
+    std::array<CpuSet, THREAD_ROLE_COUNT> affinity;  // Per ThreadRole; empty = not pinned
+
+    CpuSet& cpus(ThreadRole role) { return affinity[static_cast<size_t>(role)]; }
+    const CpuSet& cpus(ThreadRole role) const { return affinity[static_cast<size_t>(role)]; }
+};
+
+/**
+ * @brief Thread Topology Registry - Header-only implementation
+ *
+ * Threads announce their role with a ScopedThreadRole at the top of their
+ * entry function. apply() pins every registered thread of a role to that
+ * role's CPU set, and threads registering later are pinned as they start,
+ * so the order of logger, service and server start-up does not matter.
+ *
+ * Pinning uses pthread_setaffinity_np and is only available on Linux;
+ * elsewhere the mapping is recorded and reported as unsupported. OpenCV's
+ * own pool threads are not registered: on Linux they inherit the mask of
+ * the thread that first starts them, normally an inference worker.
+ */
+class ThreadTopology {
+public:
+    static ThreadTopology& getInstance() {
+        // Never destroyed: threads of other singletons (the logger) unregister during exit
+        static ThreadTopology* instance = new ThreadTopology();
+        return *instance;
+    }
+
+    static bool isPinningSupported() {
+#ifdef __linux__
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Set the CPU sets and re-pin every registered thread
+     *
+     * @return false if any thread could not be pinned
+     */
+    bool apply(const ThreadTopologyConfig& config) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+        applied_ = true;
+        bool ok = true;
+        for (auto& entry : threads_) {
+            ok = pin(entry.second) && ok;
+        }
+        return ok;
+    }
+
+    ThreadTopologyConfig getConfig() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return config_;
+    }
+
+    /**
+     * @brief Register the calling thread under a role, pinning it if a set is configured
+     */
+    void registerCurrentThread(ThreadRole role) {
+        RegisteredThread entry;
+        entry.role = role;
+#ifdef __linux__
+        entry.handle = pthread_self();
+#endif
+        std::lock_guard<std::mutex> lock(mutex_);
+        pin(entry);
+        threads_[std::this_thread::get_id()] = entry;
+    }
+
+    void unregisterCurrentThread() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.erase(std::this_thread::get_id());
+    }
+
+    size_t getThreadCount(ThreadRole role) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = 0;
+        for (const auto& entry : threads_) {
+            if (entry.second.role == role) count++;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Applied mapping: per role CPU set, live threads and pinning failures
+     */
+    std::string getInfoJson() const {
+        std::ostringstream json;
+        json << "{";
+        writeInfoFields(json);
+        json << "}";
+        return json.str();
+    }
+
+    /**
+     * @brief Write the getInfoJson() fields, without the enclosing braces, into a larger object
+     */
+    void writeInfoFields(std::ostream& json) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::array<size_t, THREAD_ROLE_COUNT> counts{};
+        for (const auto& entry : threads_) {
+            counts[static_cast<size_t>(entry.second.role)]++;
+        }
+
+        json << "\"pinning_supported\":" << (isPinningSupported() ? "true" : "false") << ",";
+        json << "\"hardware_threads\":" << std::thread::hardware_concurrency() << ",";
+        json << "\"roles\":{";
+        for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+            const CpuSet& set = config_.affinity[i];
+            if (i > 0) json << ",";
+            json << "\"" << threadRoleToString(static_cast<ThreadRole>(i)) << "\":{";
+            json << "\"cpus\":\"" << (set.empty() ? "all" : set.toString()) << "\",";
+            json << "\"threads\":" << counts[i];
+            json << "}";
+        }
+        json << "},";
+        json << "\"pin_failures\":" << pin_failures_;
+    }
+
+private:
+    struct RegisteredThread {
+        ThreadRole role = ThreadRole::INFERENCE;
+#ifdef __linux__
+        pthread_t handle{};
+#endif
+    };
+
+    ThreadTopology() {
+#ifdef __linux__
+        // What "not pinned" restores: the mask the process was started with (e.g. by taskset)
+        CPU_ZERO(&default_mask_);
+        if (sched_getaffinity(0, sizeof(default_mask_), &default_mask_) != 0) {
+            for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()) && cpu < CPU_SETSIZE; ++cpu) {
+                CPU_SET(cpu, &default_mask_);
+            }
+        }
+#endif
+    }
+    ThreadTopology(const ThreadTopology&) = delete;
+    ThreadTopology& operator=(const ThreadTopology&) = delete;
+
+    mutable std::mutex mutex_;
+    ThreadTopologyConfig config_;
+    bool applied_ = false;
+    std::map<std::thread::id, RegisteredThread> threads_;
+    uint64_t pin_failures_ = 0;
+#ifdef __linux__
+    cpu_set_t default_mask_;
+#endif
+
+    // Called with mutex_ held; an empty set releases the thread to all CPUs
+    bool pin(const RegisteredThread& entry) {
+        if (!applied_) {
+            return true; // Never configured: leave the inherited mask alone
+        }
+#ifdef __linux__
+        const CpuSet& set = config_.cpus(entry.role);
+        cpu_set_t mask = default_mask_;
+        if (!set.empty()) {
+            CPU_ZERO(&mask);
+            for (int cpu : set.cpus) {
+                if (cpu < CPU_SETSIZE) CPU_SET(cpu, &mask);
+            }
+        }
+        if (pthread_setaffinity_np(entry.handle, sizeof(mask), &mask) != 0) {
+            pin_failures_++;
+            return false;
+        }
+        return true;
+#else
+        if (config_.cpus(entry.role).empty()) {
+            return true;
+        }
+        pin_failures_++;
+        return false;
+#endif
+    }
+};
+
+/**
+ * @brief Registers the calling thread under a role for its lifetime
+ */
+class ScopedThreadRole {
+public:
+    explicit ScopedThreadRole(ThreadRole role) {
+        ThreadTopology::getInstance().registerCurrentThread(role);
+    }
+
+    ~ScopedThreadRole() {
+        ThreadTopology::getInstance().unregisterCurrentThread();
+    }
+
+    ScopedThreadRole(const ScopedThreadRole&) = delete;
+    ScopedThreadRole& operator=(const ScopedThreadRole&) = delete;
+};
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <future>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <numeric>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "inference_backend.hpp"
+#include "model_pipeline.hpp"
+#include "latency_histogram.hpp"
+#include "thread_pool.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Tiling configuration
+ */
+struct TilingConfig {
+    int tile_width = 640;          // Model input size; frames no larger than this are one tile
+    int tile_height = 640;
+    int overlap = 64;              // Pixels shared by neighbouring tiles; at least the largest object to keep whole
+    float nms_iou = 0.5f;          // Same-class boxes overlapping more than this are one detection
+    float seam_containment = 0.8f; // Boxes from different tiles with this much of the smaller inside the larger
+                                   // are one object cut by a seam; the larger box is kept
+    bool batch_tiles = true;       // All tiles in batched runBatch() calls; false = one call per tile in parallel
+    size_t max_batch = 16;
+    size_t tile_threads = 0;       // Pool size when batch_tiles is false (0 = one per hardware thread)
+};
+
+/**
+ * @brief What tiling cost for one frame
+ */
+struct TiledFrameStats {
+    size_t tiles = 0;
+    size_t raw_detections = 0;     // Before merging across tiles
+    size_t detections = 0;
+    double inference_ms = 0.0;     // All tiles, including decode
+    double merge_ms = 0.0;         // Mapping to frame coordinates + NMS
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(3);
+        json << "{";
+        json << "\"tiles\":" << tiles << ",";
+        json << "\"raw_detections\":" << raw_detections << ",";
+        json << "\"detections\":" << detections << ",";
+        json << "\"inference_ms\":" << inference_ms << ",";
+        json << "\"merge_ms\":" << merge_ms;
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Tiled Detector Inference - Header-only implementation
+ *
+ * Splits a high-resolution frame into overlapping model-sized tiles (views,
+ * no copies), runs the detector on every tile at full resolution and
+ * merges the per-tile detections into frame coordinates. Small objects
+ * keep their pixels instead of being lost to a downscale.
+ *
+ * Tiles go through the backend either as batches (one call, the runtime
+ * parallelizes inside) or as one call per tile spread over a pool, which
+ * only helps backends that run concurrent calls in parallel. Objects cut
+ * by a seam show up as a partial box in one tile and a whole one in the
+ * next; the merge drops the partial one.
+ */
+class TiledInference {
+public:
+    TiledInference(std::shared_ptr<InferenceBackend> backend, RegionDecoder decoder, const TilingConfig& config)
+        : backend_(std::move(backend)), decoder_(std::move(decoder)), config_(config), logger_("TILING") {
+        config_.tile_width = std::max(1, config_.tile_width);
+        config_.tile_height = std::max(1, config_.tile_height);
+        config_.overlap = std::max(0, std::min(config_.overlap, std::min(config_.tile_width, config_.tile_height) - 1));
+        config_.max_batch = std::max<size_t>(1, config_.max_batch);
+        if (!config_.batch_tiles) {
+            tile_pool_ = std::make_unique<ThreadPool>(config_.tile_threads, "TILES");
+        }
+    }
+
+    TiledInference(const TiledInference&) = delete;
+    TiledInference& operator=(const TiledInference&) = delete;
+
+    /**
+     * @brief Tile rectangles covering a frame, last row and column flush with the edges
+     */
+    static std::vector<cv::Rect> computeTiles(const cv::Size& frame_size, const TilingConfig& config) {
+        auto starts = [](int length, int tile, int overlap) {
+            std::vector<int> positions;
+            if (length <= tile) {
+                positions.push_back(0);
+                return positions;
+            }
+            int stride = std::max(1, tile - overlap);
+            for (int position = 0;; position += stride) {
+                if (position + tile >= length) {
+                    positions.push_back(length - tile);
+                    break;
+                }
+                positions.push_back(position);
+            }
+            return positions;
+        };
+
+        std::vector<cv::Rect> tiles;
+        int width = std::min(config.tile_width, frame_size.width);
+        int height = std::min(config.tile_height, frame_size.height);
+        for (int y : starts(frame_size.height, height, config.overlap)) {
+            for (int x : starts(frame_size.width, width, config.overlap)) {
+                tiles.emplace_back(x, y, width, height);
+            }
+        }
+        return tiles;
+    }
+
+    /**
+     * @brief Detect on every tile and merge into frame coordinates
+     *
+     * PipelineRegion::source is the index of the tile a detection came from.
+     */
+    bool run(const cv::Mat& frame, std::vector<PipelineRegion>& detections, TiledFrameStats* frame_stats = nullptr) {
+        detections.clear();
+        if (frame.empty() || !backend_) {
+            return false;
+        }
+
+        TiledFrameStats stats;
+        std::vector<cv::Rect> tiles = computeTiles(frame.size(), config_);
+        stats.tiles = tiles.size();
+        std::vector<std::vector<PipelineRegion>> tile_regions(tiles.size());
+
+        auto inference_start = std::chrono::steady_clock::now();
+        bool ok = config_.batch_tiles ? runBatched(frame, tiles, tile_regions) : runParallel(frame, tiles, tile_regions);
+        stats.inference_ms = elapsedMs(inference_start);
+        if (!ok) {
+            failed_frames_++;
+            return false;
+        }
+
+        auto merge_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            stats.raw_detections += tile_regions[i].size();
+            for (PipelineRegion region : tile_regions[i]) {
+                region.box &= cv::Rect(0, 0, tiles[i].width, tiles[i].height);
+                if (region.box.empty()) {
+                    continue;
+                }
+                region.box += tiles[i].tl();
+                region.source = static_cast<int>(i);
+                detections.push_back(region);
+            }
+        }
+        mergeDetections(detections, config_.nms_iou, config_.seam_containment);
+        stats.merge_ms = elapsedMs(merge_start);
+        stats.detections = detections.size();
+
+        frames_++;
+        tiles_ += stats.tiles;
+        raw_detections_ += stats.raw_detections;
+        detections_ += stats.detections;
+        inference_latency_.record(stats.inference_ms);
+        merge_latency_.record(stats.merge_ms);
+        if (frame_stats) {
+            *frame_stats = stats;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Class-aware greedy NMS with seam merging, in place, highest score first
+     *
+     * Within one class, a box is dropped if it overlaps a kept box by more
+     * than iou_threshold, or if it came from another tile and one of the two
+     * lies at least seam_containment inside the other (a partial view cut
+     * by a seam); the kept detection then takes the larger box.
+     */
+    static void mergeDetections(std::vector<PipelineRegion>& regions, float iou_threshold, float seam_containment) {
+        std::stable_sort(regions.begin(), regions.end(),
+                         [](const PipelineRegion& a, const PipelineRegion& b) { return a.score > b.score; });
+        std::vector<PipelineRegion> kept;
+        kept.reserve(regions.size());
+        for (const PipelineRegion& candidate : regions) {
+            bool suppressed = false;
+            for (PipelineRegion& survivor : kept) {
+                if (survivor.class_id != candidate.class_id) {
+                    continue;
+                }
+                double intersection = (survivor.box & candidate.box).area();
+                if (intersection <= 0.0) {
+                    continue;
+                }
+                double smaller = std::min(survivor.box.area(), candidate.box.area());
+                double iou = intersection / (survivor.box.area() + candidate.box.area() - intersection);
+                if (iou > iou_threshold) {
+                    suppressed = true;
+                } else if (survivor.source != candidate.source && intersection / smaller >= seam_containment) {
+                    if (candidate.box.area() > survivor.box.area()) {
+                        survivor.box = candidate.box;
+                    }
+                    suppressed = true;
+                }
+                if (suppressed) {
+                    break;
+                }
+            }
+            if (!suppressed) {
+                kept.push_back(candidate);
+            }
+        }
+        regions.swap(kept);
+    }
+
+    const TilingConfig& getConfig() const {
+        return config_;
+    }
+
+    void resetStats() {
+        frames_ = 0;
+        failed_frames_ = 0;
+        tiles_ = 0;
+        raw_detections_ = 0;
+        detections_ = 0;
+        inference_latency_.reset();
+        merge_latency_.reset();
+    }
+
+    /**
+     * @brief Tile counts, detections before/after merging and per-frame latencies as a JSON object
+     */
+    std::string getStatsJson() const {
+        uint64_t frames = frames_;
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(2);
+        json << "{";
+        json << "\"tile_size\":[" << config_.tile_width << "," << config_.tile_height << "],";
+        json << "\"overlap\":" << config_.overlap << ",";
+        json << "\"mode\":\"" << (config_.batch_tiles ? "batch" : "parallel") << "\",";
+        json << "\"frames\":" << frames << ",";
+        json << "\"failed_frames\":" << failed_frames_ << ",";
+        json << "\"tiles_per_frame\":" << (frames ? static_cast<double>(tiles_) / frames : 0.0) << ",";
+        json << "\"raw_detections_per_frame\":" << (frames ? static_cast<double>(raw_detections_) / frames : 0.0) << ",";
+        json << "\"detections_per_frame\":" << (frames ? static_cast<double>(detections_) / frames : 0.0) << ",";
+        json << "\"inference_latency\":" << inference_latency_.toJson() << ",";
+        json << "\"merge_latency\":" << merge_latency_.toJson();
+        json << "}";
+        return json.str();
+    }
+
+private:
+    std::shared_ptr<InferenceBackend> backend_;
+    RegionDecoder decoder_;
+    TilingConfig config_;
+    std::unique_ptr<ThreadPool> tile_pool_;  // Only in parallel mode
+    ModuleLogger logger_;
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> failed_frames_{0};
+    std::atomic<uint64_t> tiles_{0};
+    std::atomic<uint64_t> raw_detections_{0};
+    std::atomic<uint64_t> detections_{0};
+    LatencyHistogram inference_latency_;
+    LatencyHistogram merge_latency_;
+
+    bool runBatched(const cv::Mat& frame, const std::vector<cv::Rect>& tiles,
+                    std::vector<std::vector<PipelineRegion>>& tile_regions) {
+        std::vector<cv::Mat> batch;
+        std::vector<cv::Mat> outputs;
+        batch.reserve(std::min(config_.max_batch, tiles.size()));
+        try {
+            for (size_t offset = 0; offset < tiles.size(); offset += config_.max_batch) {
+                size_t count = std::min(config_.max_batch, tiles.size() - offset);
+                batch.clear();
+                for (size_t i = 0; i < count; ++i) {
+                    batch.push_back(frame(tiles[offset + i]));
+                }
+                if (!backend_->runBatch(batch, outputs)) {
+                    return false;
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    tile_regions[offset + i] = decoder_(outputs, i, batch[i].size());
+                }
+            }
+        } catch (const std::exception& e) {
+            logger_.error("Tiled inference failed: " + std::string(e.what()));
+            return false;
+        }
+        return true;
+    }
+
+    bool runParallel(const cv::Mat& frame, const std::vector<cv::Rect>& tiles,
+                     std::vector<std::vector<PipelineRegion>>& tile_regions) {
+        auto runTile = [this, &frame, &tiles, &tile_regions](size_t index) {
+            try {
+                std::vector<cv::Mat> batch(1, frame(tiles[index]));
+                std::vector<cv::Mat> outputs;
+                if (!backend_->runBatch(batch, outputs)) {
+                    return false;
+                }
+                tile_regions[index] = decoder_(outputs, 0, batch[0].size());
+                return true;
+            } catch (const std::exception& e) {
+                logger_.error("Tile " + std::to_string(index) + " failed: " + e.what());
+                return false;
+            }
+        };
+
+        // Last tile on the calling thread, so a caller on another pool cannot starve
+        std::vector<std::future<bool>> pending;
+        pending.reserve(tiles.size());
+        for (size_t i = 0; i + 1 < tiles.size(); ++i) {
+            pending.push_back(tile_pool_->submit([runTile, i]() { return runTile(i); }));
+        }
+        bool ok = runTile(tiles.size() - 1);
+        for (auto& tile : pending) {
+            ok = tile.get() && ok;
+        }
+        return ok;
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
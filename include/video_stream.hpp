@@ -0,0 +1,417 @@
+#pragma once
+
+#include <string>
+#include <memory>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include "capture_thread.hpp"
+#include "performance_monitor.hpp"
+#include "latency_histogram.hpp"
+#include "rate_controller.hpp"
+#include "change_gate.hpp"
+#include "json_escape.hpp"
+#include "inference_backend.hpp"
+#include "model_pipeline.hpp"
+#include "logger.hpp"
+
+/**
+ * @brief Per-stream processing options
+ */
+struct StreamOptions {
+    RateControlConfig rate_control;
+    ChangeGateConfig change_gate;
+    bool latency_critical = false;  // Run inference directly instead of through the batch scheduler
+};
+
+/**
+ * @brief Latest result of a stream, as published for one frame
+ */
+struct StreamResult {
+    uint64_t sequence = 0;             // Frame the result was published for
+    uint64_t source_sequence = 0;      // Frame inference actually ran on (earlier when reused)
+    FrameMetadata::TimePoint capture_time{};
+    bool reused = false;               // Change gate skipped the frame; values are from source_sequence
+    InferenceResult inference;         // Single-model path
+    std::shared_ptr<const PipelineResult> pipeline;  // Pipeline path; null on the single-model path
+
+    std::string toJson() const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"sequence\":" << sequence << ",";
+        json << "\"source_sequence\":" << source_sequence << ",";
+        json << "\"reused\":" << (reused ? "true" : "false") << ",";
+        if (pipeline) {
+            json << "\"pipeline\":" << pipeline->toJson();
+        } else {
+            json << "\"result\":" << inference.toJson();
+        }
+        json << "}";
+        return json.str();
+    }
+};
+
+/**
+ * @brief Video Stream Class - Header-only implementation
+ *
+ * One named input stream: its own capture thread, frame ring and
+ * PerformanceMonitor. Streams share the service's model and worker pool.
+ * The stream also keeps its latest result, which the change gate reuses
+ * for frames it skips.
+ */
+class VideoStream {
+public:
+    VideoStream(const std::string& name, const CaptureConfig& config,
+                const StreamOptions& options = StreamOptions())
+        : name_(name), window_name_("Camera Feed - " + name), capture_(config),
+          rate_control_(options.rate_control), rate_controller_(processingPolicy(options.rate_control)),
+          change_gate_(options.change_gate), latency_critical_(options.latency_critical), logger_("STREAM:" + name) {
+        // Rate skipping happens at grab time so skipped frames are never decoded
+        capture_.setDecodePolicy(options.rate_control);
+    }
+
+    VideoStream(const VideoStream&) = delete;
+    VideoStream& operator=(const VideoStream&) = delete;
+
+    /**
+     * @brief Open a frame source and start capturing
+     *
+     * @param source_uri camera:<id>, file:<path>, dir:<path> or synthetic:<w>x<h>[@<fps>]
+     */
+    bool start(const std::string& source_uri) {
+        source_uri_ = source_uri;
+        logger_.info("Starting stream on source " + source_uri);
+        return capture_.start(source_uri);
+    }
+
+    /**
+     * @brief Stop capturing and release the source
+     */
+    void stop() {
+        capture_.stop();
+        logger_.info("Stream stopped");
+    }
+
+    /**
+     * @brief Set callback invoked when a new frame is available
+     */
+    void setFrameCallback(std::function<void()> callback) {
+        capture_.setFrameCallback(std::move(callback));
+    }
+
+    /**
+     * @brief Also count this stream's dropped and failed frames in a service-wide monitor
+     */
+    void setAggregateMonitor(PerformanceMonitor* monitor) {
+        aggregate_monitor_ = monitor;
+    }
+
+    /**
+     * @brief Take the freshest frame without waiting
+     */
+    bool takeLatestFrame(CapturedFrame& captured) {
+        return capture_.getLatestFrame(captured, std::chrono::milliseconds(0));
+    }
+
+    /**
+     * @brief Take the oldest queued frame, waiting up to timeout (nothing is discarded)
+     */
+    bool takeNextFrame(CapturedFrame& captured, std::chrono::milliseconds timeout) {
+        return capture_.getNextFrame(captured, timeout);
+    }
+
+    /**
+     * @brief Take the freshest frame if rate control and the age budget admit it
+     *
+     * Frames lost on the way (ring overflow, older queued frames, stale
+     * frames) are counted as dropped. Frames the capture thread skipped
+     * undecoded under the rate policy are counted as skipped, and failed
+     * captures as failed.
+     */
+    bool takeAdmittedFrame(CapturedFrame& captured) {
+        syncCaptureCounters();
+        if (!takeLatestFrame(captured)) {
+            return false;
+        }
+        syncCaptureCounters(); // popLatest may have skipped older frames
+
+        RateController::Decision decision = rate_controller_.admit(captured.metadata);
+        if (decision == RateController::Decision::ADMIT) {
+            return true;
+        }
+        if (decision == RateController::Decision::DROP_STALE) {
+            stale_frames_++;
+        }
+        recordDropped(1);
+        captured = CapturedFrame(); // Buffer goes back to the pool now
+        return false;
+    }
+
+    /**
+     * @brief Run the change gate on a frame; a skipped frame gets the last result republished
+     *
+     * Without a result to reuse (nothing processed yet, or the last pass
+     * failed) the frame always goes to inference.
+     *
+     * @return true if the frame needs a full pass
+     */
+    bool gateFrame(const cv::Mat& frame, const FrameMetadata& metadata) {
+        if (!hasResult()) {
+            change_gate_.invalidate();
+        }
+        if (change_gate_.shouldProcess(frame)) {
+            return true;
+        }
+        reuseResult(metadata);
+        return false;
+    }
+
+    /**
+     * @brief Publish the result inference produced for a frame
+     */
+    void publishResult(const FrameMetadata& metadata, const InferenceResult& inference,
+                       std::shared_ptr<const PipelineResult> pipeline = nullptr) {
+        StreamResult result;
+        result.sequence = metadata.sequence;
+        result.source_sequence = metadata.sequence;
+        result.capture_time = metadata.capture_time;
+        result.inference = inference;
+        result.pipeline = std::move(pipeline);
+
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        last_result_ = std::move(result);
+        has_result_ = true;
+    }
+
+    /**
+     * @brief Republish the last result for a frame that was not processed
+     *
+     * @return false if there is no result yet
+     */
+    bool reuseResult(const FrameMetadata& metadata) {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        if (!has_result_) {
+            return false;
+        }
+        last_result_.sequence = metadata.sequence;
+        last_result_.capture_time = metadata.capture_time;
+        last_result_.reused = true;
+        return true;
+    }
+
+    /**
+     * @brief Copy out the latest published result
+     *
+     * @return false if no frame has been processed yet
+     */
+    bool getLastResult(StreamResult& result) const {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        if (!has_result_) {
+            return false;
+        }
+        result = last_result_;
+        return true;
+    }
+
+    bool hasResult() const {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        return has_result_;
+    }
+
+    /**
+     * @brief Record a finished frame's latencies
+     *
+     * @param result_time When the frame's result became available
+     */
+    void recordResult(const FrameMetadata& metadata, FrameMetadata::TimePoint result_time) {
+        capture_to_result_.record(metadata.ageMs(result_time));
+        capture_stage_.record(metadata.stageMs("capture"));
+        queue_stage_.record(metadata.stageMs("queue"));
+        process_stage_.record(metadata.stageMs("process"));
+    }
+
+    /**
+     * @brief Reset the performance monitor and latency histograms
+     */
+    void resetMetrics() {
+        performance_monitor_.reset();
+        change_gate_.resetStats();
+        stale_frames_ = 0;
+        capture_to_result_.reset();
+        capture_stage_.reset();
+        queue_stage_.reset();
+        process_stage_.reset();
+    }
+
+    bool isRunning() const {
+        return capture_.isRunning();
+    }
+
+    /**
+     * @brief True once capture has ended and every frame was consumed
+     */
+    bool isFinished() const {
+        return capture_.isFinished();
+    }
+
+    const std::string& getName() const { return name_; }
+    const std::string& getWindowName() const { return window_name_; }
+    const std::string& getSourceUri() const { return source_uri_; }
+    bool isLatencyCritical() const { return latency_critical_; }
+    const CaptureThread& getCapture() const { return capture_; }
+    PerformanceMonitor& getPerformanceMonitor() { return performance_monitor_; }
+    const PerformanceMonitor& getPerformanceMonitor() const { return performance_monitor_; }
+    const LatencyHistogram& getCaptureToResultLatency() const { return capture_to_result_; }
+    ChangeGate& getChangeGate() { return change_gate_; }
+    const ChangeGate& getChangeGate() const { return change_gate_; }
+
+    /**
+     * @brief Stream status as a JSON object
+     */
+    std::string getStatusJson() const {
+        std::ostringstream json;
+        json << "{";
+        json << "\"name\":\"" << jsonEscape(name_) << "\",";
+        json << "\"source\":\"" << jsonEscape(source_uri_) << "\",";
+        json << "\"running\":" << (isRunning() ? "true" : "false") << ",";
+        json << "\"latency_critical\":" << (latency_critical_ ? "true" : "false") << ",";
+        json << "\"properties\":{";
+        json << "\"width\":" << capture_.getWidth() << ",";
+        json << "\"height\":" << capture_.getHeight() << ",";
+        json << "\"fps\":" << capture_.getFps();
+        json << "},";
+        json << "\"capture\":{";
+        json << "\"grabbed_frames\":" << capture_.getGrabbedFrames() << ",";
+        json << "\"captured_frames\":" << capture_.getCapturedFrames() << ",";
+        json << "\"skipped_undecoded\":" << capture_.getSkippedFrames() << ",";
+        json << "\"failed_reads\":" << capture_.getFailedReads() << ",";
+        json << "\"ring_size\":" << capture_.getRing().size() << ",";
+        json << "\"ring_capacity\":" << capture_.getRing().capacity() << ",";
+        json << "\"dropped_frames\":" << capture_.getRing().getDroppedCount() << ",";
+        json << "\"overflow_policy\":\"" << overflowPolicyToString(capture_.getRing().getPolicy()) << "\"";
+        json << "},";
+        const RateControlConfig& rate = rate_control_;
+        json << "\"rate_control\":{";
+        json << "\"mode\":\"" << rateControlModeToString(rate.mode) << "\",";
+        json << "\"every_nth\":" << rate.every_nth << ",";
+        json << "\"target_fps\":" << rate.target_fps << ",";
+        json << "\"max_frame_age_ms\":" << rate.max_frame_age_ms;
+        json << "}";
+        json << "}";
+        return json.str();
+    }
+
+    /**
+     * @brief Stream performance metrics as a JSON object
+     */
+    std::string getMetricsJson() const {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(2);
+        json << "{";
+        json << "\"fps\":" << performance_monitor_.getFPS() << ",";
+        json << "\"frame_time\":{";
+        json << "\"current\":" << performance_monitor_.getCurrentFrameTime() << ",";
+        json << "\"average\":" << performance_monitor_.getAverageFrameTime() << ",";
+        json << "\"min\":" << performance_monitor_.getMinFrameTime() << ",";
+        json << "\"max\":" << performance_monitor_.getMaxFrameTime();
+        json << "},";
+        json << "\"total_frames\":" << performance_monitor_.getTotalFrames() << ",";
+        json << "\"frames\":{";
+        json << "\"processed\":" << performance_monitor_.getTotalFrames() << ",";
+        json << "\"dropped\":" << performance_monitor_.getDroppedFrames() << ",";
+        json << "\"stale\":" << stale_frames_ << ",";
+        json << "\"skipped\":" << performance_monitor_.getSkippedFrames() << ",";
+        json << "\"failed\":" << performance_monitor_.getFailedFrames() << ",";
+        json << "\"drop_rate\":" << std::setprecision(4) << performance_monitor_.getDropRate() << std::setprecision(2) << ",";
+        json << "\"input_fps\":" << performance_monitor_.getInputFPS() << ",";
+        json << "\"effective_fps\":" << performance_monitor_.getFPS();
+        json << "},";
+        json << "\"latency\":{";
+        json << "\"capture_to_result\":" << capture_to_result_.toJson() << ",";
+        json << "\"stages\":{";
+        json << "\"capture\":" << capture_stage_.toJson() << ",";
+        json << "\"queue\":" << queue_stage_.toJson() << ",";
+        json << "\"process\":" << process_stage_.toJson();
+        json << "}";
+        json << "},";
+        json << "\"change_gate\":" << change_gate_.getStats().toJson() << ",";
+        StreamResult result;
+        json << "\"last_result\":" << (getLastResult(result) ? result.toJson() : "null") << ",";
+        json << "\"frame_pool\":" << capture_.getPoolStats().toJson();
+        json << "}";
+        return json.str();
+    }
+
+private:
+    /**
+     * @brief Policy applied after the ring: freshest frame within the age budget
+     */
+    static RateControlConfig processingPolicy(const RateControlConfig& rate_control) {
+        RateControlConfig policy;
+        policy.mode = RateControlMode::LATEST_ONLY;
+        policy.max_frame_age_ms = rate_control.max_frame_age_ms;
+        return policy;
+    }
+
+    /**
+     * @brief Forward new ring drops, rate skips and failed reads to the performance monitor
+     */
+    void syncCaptureCounters() {
+        uint64_t ring_drops = capture_.getRing().getDroppedCount();
+        if (ring_drops > synced_ring_drops_) {
+            recordDropped(ring_drops - synced_ring_drops_);
+        }
+        synced_ring_drops_ = ring_drops;
+
+        uint64_t skipped = capture_.getSkippedFrames();
+        if (skipped > synced_skipped_) {
+            performance_monitor_.recordSkipped(skipped - synced_skipped_);
+            if (aggregate_monitor_) {
+                aggregate_monitor_->recordSkipped(skipped - synced_skipped_);
+            }
+        }
+        synced_skipped_ = skipped;
+
+        uint64_t failed_reads = capture_.getFailedReads();
+        if (failed_reads > synced_failed_reads_) {
+            performance_monitor_.recordFailed(failed_reads - synced_failed_reads_);
+            if (aggregate_monitor_) {
+                aggregate_monitor_->recordFailed(failed_reads - synced_failed_reads_);
+            }
+        }
+        synced_failed_reads_ = failed_reads;
+    }
+
+    void recordDropped(uint64_t frames) {
+        performance_monitor_.recordDropped(frames);
+        if (aggregate_monitor_) {
+            aggregate_monitor_->recordDropped(frames);
+        }
+    }
+
+    std::string name_;
+    std::string window_name_;
+    std::string source_uri_;
+    CaptureThread capture_;
+    PerformanceMonitor performance_monitor_;
+    RateControlConfig rate_control_;
+    RateController rate_controller_;       // Age budget only; rate skipping is done by the capture thread
+    ChangeGate change_gate_;               // Used from the worker processing this stream's frame
+    StreamResult last_result_;             // Latest published result, read by the Web API
+    bool has_result_ = false;
+    mutable std::mutex result_mutex_;
+    bool latency_critical_;
+    PerformanceMonitor* aggregate_monitor_ = nullptr;
+    std::atomic<uint64_t> stale_frames_{0};
+    uint64_t synced_ring_drops_ = 0;       // Capture counters already forwarded to the monitor
+    uint64_t synced_skipped_ = 0;
+    uint64_t synced_failed_reads_ = 0;
+    LatencyHistogram capture_to_result_;   // SLA metric: capture timestamp to result
+    LatencyHistogram capture_stage_;       // Driver wait + decode
+    LatencyHistogram queue_stage_;         // Waiting in the frame ring
+    LatencyHistogram process_stage_;       // Worker queue + processing
+    ModuleLogger logger_;
+};
@@ -5,6 +5,7 @@
 #include <thread>
 #include <atomic>
 #include <map>
+#include <vector>
 #include <functional>
 #include <sstream>
 #include <iostream>
@@ -34,6 +35,8 @@
 
 #include "logger.hpp"
 #include "performance_monitor.hpp"
+#include "thread_topology.hpp"
+#include "json_escape.hpp"
 
 /**
  * @brief Simple HTTP Web API Server - Header-only implementation
@@ -43,6 +46,8 @@
 class WebApiServer {
 public:
     using RequestHandler = std::function<std::string(const std::string& method, const std::string& path, const std::string& body)>;
+    using MetricsProvider = std::function<std::string(const std::string& path)>;
+    using InfoProvider = std::function<std::string()>;
     
     WebApiServer(int port = 8080) : port_(port), running_(false) {
         logger_ = std::make_unique<ModuleLogger>("WEBAPI");
@@ -154,6 +159,29 @@ public:
         logger_->debug("Added route: " + path);
     }
     
+    /**
+     * @brief Add a named JSON section to the /metrics response
+     *
+     * The provider gets the request path (including any query string) and
+     * must return a complete JSON value. Register providers before start();
+     * they are called from client threads.
+     */
+    void addMetricsProvider(const std::string& name, MetricsProvider provider) {
+        metrics_providers_.emplace_back(name, provider);
+        logger_->debug("Added metrics provider: " + name);
+    }
+    
+    /**
+     * @brief Add a named JSON section to the /info response
+     *
+     * The provider must return a complete JSON value. Register providers
+     * before start(); they are called from client threads.
+     */
+    void addInfoProvider(const std::string& name, InfoProvider provider) {
+        info_providers_.emplace_back(name, provider);
+        logger_->debug("Added info provider: " + name);
+    }
+    
     /**
      * @brief Set performance monitor reference
      */
@@ -168,6 +196,83 @@ public:
         inference_service_ = service;
     }
     
+    /**
+     * @brief Get a query parameter from a request path ("" if absent)
+     */
+    static std::string getQueryParameter(const std::string& path, const std::string& key) {
+        size_t query = path.find('?');
+        while (query != std::string::npos) {
+            size_t start = query + 1;
+            size_t end = path.find('&', start);
+            std::string pair = path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+            size_t eq = pair.find('=');
+            if (pair.substr(0, eq) == key) {
+                return eq == std::string::npos ? "" : pair.substr(eq + 1);
+            }
+            query = end;
+        }
+        return "";
+    }
+    
+    /**
+     * @brief Extract a string field from a flat JSON body ("" if absent), decoding its escapes
+     */
+    static std::string extractJsonString(const std::string& body, const std::string& key) {
+        size_t pos = body.find("\"" + key + "\"");
+        if (pos == std::string::npos) return "";
+        pos = body.find(':', pos + key.length() + 2);
+        if (pos == std::string::npos) return "";
+        size_t start = body.find('"', pos + 1);
+        if (start == std::string::npos) return "";
+        size_t end = start + 1;
+        while (end < body.size() && body[end] != '"') {
+            end += body[end] == '\\' ? 2 : 1; // An escaped quote does not end the string
+        }
+        if (end >= body.size()) return "";
+        return jsonUnescape(body.substr(start + 1, end - start - 1));
+    }
+    
+    /**
+     * @brief Escape a string for use inside a JSON string literal
+     */
+    static std::string escapeJsonString(const std::string& str) {
+        return jsonEscape(str);
+    }
+    
+    /**
+     * @brief Extract a numeric field from a flat JSON body
+     */
+    static double extractJsonNumber(const std::string& body, const std::string& key, double default_value) {
+        size_t pos = body.find("\"" + key + "\"");
+        if (pos == std::string::npos) return default_value;
+        pos = body.find(':', pos + key.length() + 2);
+        if (pos == std::string::npos) return default_value;
+        try {
+            return std::stod(body.substr(pos + 1));
+        } catch (...) {
+            return default_value;
+        }
+    }
+    
+    static int extractJsonInt(const std::string& body, const std::string& key, int default_value) {
+        return static_cast<int>(extractJsonNumber(body, key, default_value));
+    }
+    
+    /**
+     * @brief Extract a true/false field from a flat JSON body
+     */
+    static bool extractJsonBool(const std::string& body, const std::string& key, bool default_value) {
+        size_t pos = body.find("\"" + key + "\"");
+        if (pos == std::string::npos) return default_value;
+        pos = body.find(':', pos + key.length() + 2);
+        if (pos == std::string::npos) return default_value;
+        size_t start = body.find_first_not_of(" \t\r\n", pos + 1);
+        if (start == std::string::npos) return default_value;
+        if (body.compare(start, 4, "true") == 0) return true;
+        if (body.compare(start, 5, "false") == 0) return false;
+        return default_value;
+    }
+    
     /**
      * @brief Check if server is running
      */
@@ -189,6 +294,8 @@ private:
     std::thread server_thread_;
     std::unique_ptr<ModuleLogger> logger_;
     std::map<std::string, RequestHandler> routes_;
+    std::vector<std::pair<std::string, MetricsProvider>> metrics_providers_;
+    std::vector<std::pair<std::string, InfoProvider>> info_providers_;
     
     // References to other components
     const PerformanceMonitor* performance_monitor_ = nullptr;
@@ -209,8 +316,8 @@ private:
         
         // Performance metrics endpoint
         addRoute("/metrics", [this](const std::string& method, const std::string& path, const std::string& body) {
-            (void)method; (void)path; (void)body;
-            return handleMetricsRequest();
+            (void)method; (void)body;
+            return handleMetricsRequest(path);
         });
         
         // Performance stats endpoint (detailed)
@@ -239,6 +346,7 @@ private:
     }
     
     void serverLoop() {
+        ScopedThreadRole role(ThreadRole::WEB);
         logger_->info("Server loop started");
         
         while (running_) {
@@ -262,6 +370,7 @@ private:
     }
     
     void handleClient(SOCKET client_socket) {
+        ScopedThreadRole role(ThreadRole::WEB);
         char buffer[4096];
         int bytes_received = recv(client_socket, buffer, sizeof(buffer) - 1, 0);
         
@@ -278,9 +387,9 @@ private:
         
         logger_->debug("Request: " + method + " " + path);
         
-        // Find matching route
+        // Find matching route (query string is left for the handler)
         std::string response;
-        auto it = routes_.find(path);
+        auto it = routes_.find(path.substr(0, path.find('?')));
         if (it != routes_.end()) {
             try {
                 response = it->second(method, path, body);
@@ -357,7 +466,7 @@ private:
         return createJsonResponse(200, json.str());
     }
     
-    std::string handleMetricsRequest() {
+    std::string handleMetricsRequest(const std::string& path) {
         if (!performance_monitor_) {
             return createJsonResponse(503, R"({"error":"Performance monitor not available"})");
         }
@@ -373,6 +482,18 @@ private:
         json << "\"max\":" << performance_monitor_->getMaxFrameTime();
         json << "},";
         json << "\"total_frames\":" << performance_monitor_->getTotalFrames() << ",";
+        json << "\"frames\":{";
+        json << "\"processed\":" << performance_monitor_->getTotalFrames() << ",";
+        json << "\"dropped\":" << performance_monitor_->getDroppedFrames() << ",";
+        json << "\"skipped\":" << performance_monitor_->getSkippedFrames() << ",";
+        json << "\"failed\":" << performance_monitor_->getFailedFrames() << ",";
+        json << "\"drop_rate\":" << std::setprecision(4) << performance_monitor_->getDropRate() << std::setprecision(2) << ",";
+        json << "\"input_fps\":" << performance_monitor_->getInputFPS() << ",";
+        json << "\"effective_fps\":" << performance_monitor_->getFPS();
+        json << "},";
+        for (const auto& provider : metrics_providers_) {
+            json << "\"" << provider.first << "\":" << provider.second(path) << ",";
+        }
         json << "\"timestamp\":\"" << getCurrentTimestamp() << "\"";
         json << "}";
         
@@ -473,6 +594,9 @@ private:
         }
         json << "]";
         json << "}";
+        for (const auto& provider : info_providers_) {
+            json << ",\"" << provider.first << "\":" << provider.second();
+        }
         json << "}";
         
         return createJsonResponse(200, json.str());
@@ -577,21 +701,6 @@ watch -n 2 "curl -s http://localhost:)" + std::to_string(port_) + R"(/metrics |
         return oss.str();
     }
     
-    std::string escapeJsonString(const std::string& str) {
-        std::string escaped;
-        for (char c : str) {
-            switch (c) {
-                case '"': escaped += "\\\""; break;
-                case '\\': escaped += "\\\\"; break;
-                case '\n': escaped += "\\n"; break;
-                case '\r': escaped += "\\r"; break;
-                case '\t': escaped += "\\t"; break;
-                default: escaped += c; break;
-            }
-        }
-        return escaped;
-    }
-    
     std::string logLevelToString(LogLevel level) {
         switch (level) {
             case LogLevel::TRACE: return "TRACE";
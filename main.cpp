@@ -3,24 +3,212 @@
 #include <chrono>
 #include <csignal>
 #include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
+#include <functional>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 #include "inference_service.hpp"
 #include "logger.hpp"
 
 // Global flag for graceful shutdown
 std::atomic<bool> shutdown_requested(false);
 
-// Signal handler for graceful shutdown
-void signal_handler(int signal) {
-    if (signal == SIGINT || signal == SIGTERM) {
+/**
+ * @brief Turns SIGINT/SIGTERM into a shutdown event
+ *
+ * POSIX: the signals are blocked in every thread and a dedicated thread
+ * takes them with sigwait(), so the callback may lock and notify freely.
+ * Windows runs signal handlers on their own thread, so the handler calls
+ * the callback directly.
+ */
+class ShutdownSignalWatcher {
+public:
+    /**
+     * @brief Route SIGINT/SIGTERM to the watcher; call before any thread is created
+     */
+    static void install() {
+#ifdef _WIN32
+        std::signal(SIGINT, signal_handler);
+        std::signal(SIGTERM, signal_handler);
+#else
+        sigset_t signals = shutdownSignals();
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr); // Inherited by every thread created later
+#endif
+    }
+
+    explicit ShutdownSignalWatcher(std::function<void()> on_signal) {
+        callback() = std::move(on_signal);
+#ifndef _WIN32
+        // Signals that arrived earlier are still pending and are taken here
+        thread_ = std::thread([this]() {
+            sigset_t signals = shutdownSignals();
+            int signal = 0;
+            while (sigwait(&signals, &signal) == 0 && !exiting_) {
+                notify();
+            }
+        });
+#endif
+    }
+
+    ~ShutdownSignalWatcher() {
+#ifndef _WIN32
+        exiting_ = true;
+        pthread_kill(thread_.native_handle(), SIGTERM); // Blocked, so it only wakes sigwait()
+        thread_.join();
+#endif
+        callback() = nullptr;
+    }
+
+private:
+#ifndef _WIN32
+    std::thread thread_;
+    std::atomic<bool> exiting_{false};
+
+    static sigset_t shutdownSignals() {
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        return signals;
+    }
+#else
+    static void signal_handler(int signal) {
+        if (signal == SIGINT || signal == SIGTERM) {
+            std::signal(signal, signal_handler); // Handlers are reset after each delivery
+            notify();
+        }
+    }
+#endif
+
+    static std::function<void()>& callback() {
+        static std::function<void()> on_signal;
+        return on_signal;
+    }
+
+    static void notify() {
         shutdown_requested = true;
         std::cout << "\nShutdown signal received, exiting gracefully..." << std::endl;
+        if (callback()) {
+            callback()();
+        }
+    }
+};
+
+// Stream name for a source URI: cameras keep the "camera<id>" name the API has always used
+std::string stream_name_for(const std::string& source) {
+    std::string id = source.compare(0, 7, "camera:") == 0 ? source.substr(7) : source;
+    if (!id.empty() && std::all_of(id.begin(), id.end(), [](unsigned char c) { return std::isdigit(c) != 0; })) {
+        return "camera" + id;
     }
+    return "main";
+}
+
+// Print command line usage
+void print_usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --headless          Run without preview windows (no HighGUI calls)\n"
+              << "  --preview-fps <n>   Preview refresh cap in frames per second (default 10)\n"
+              << "  --source <uri>      Frame source: camera:<id>, file:<path>, dir:<path> or synthetic:<w>x<h>[@<fps>]\n"
+              << "                      (default camera:0)\n"
+              << "  --pacing <mode>     realtime (native frame rate, default) or fast, for file, dir and synthetic sources\n"
+              << "  --backend <name>    Inference backend: opencv_dnn (default) or reference\n"
+              << "  --model <path>      ONNX model to load (default: none, no inference)\n"
+              << "  --input-size <WxH>  Network input size (default 224x224)\n"
+              << "  --warmup <n>        Warm-up inferences before serving (default 3)\n"
+              << "  --cache-dir <path>  Optimized-network cache directory (default: none)\n"
+              << "  --opencv-preprocess Use cv::dnn::blobFromImages instead of the fused SIMD preprocessing\n"
+              << "  --max-batch <n>     Batch up to n inference requests (default 1, no batching)\n"
+              << "  --batch-delay <ms>  Longest a request waits for its batch to fill (default 2)\n"
+              << "  --max-in-flight <n> Queued + running inference requests before rejecting (default 64)\n"
+              << "  --result-cache-mb <n> Cache inference() results for identical inputs (0 = off)\n"
+              << "  --workers <n>       Inference worker threads (default: one per hardware thread)\n"
+              << "  --opencv-threads <n> OpenCV internal pool size, also DNN intra-op threads (default: OpenCV's)\n"
+              << "  --pin <role=cpus>   Pin capture|inference|web|logger threads, e.g. inference=2-15 (repeatable)\n"
+              << "  --help              Show this message" << std::endl;
 }
 
-int main() {
-    // Set up signal handlers
-    std::signal(SIGINT, signal_handler);
-    std::signal(SIGTERM, signal_handler);
+int main(int argc, char* argv[]) {
+    DisplayConfig display_config;
+    CaptureConfig capture_config;
+    std::string source = "camera:0";
+    ModelConfig model_config;
+    BatchSchedulerConfig batch_config;
+    size_t max_in_flight = 64;
+    ResultCacheConfig result_cache_config;
+    size_t inference_workers = 0;
+    ThreadTopologyConfig thread_topology;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            display_config.headless = true;
+        } else if (std::strcmp(argv[i], "--preview-fps") == 0 && i + 1 < argc) {
+            display_config.max_fps = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            source = argv[++i];
+        } else if (std::strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            std::string pacing = argv[++i];
+            if (pacing != "realtime" && pacing != "fast") {
+                std::cerr << "Invalid pacing: " << pacing << std::endl;
+                return 1;
+            }
+            capture_config.pacing = stringToPacingMode(pacing);
+        } else if (std::strcmp(argv[i], "--backend") == 0 && i + 1 < argc) {
+            model_config.backend = argv[++i];
+        } else if (std::strcmp(argv[i], "--model") == 0 && i + 1 < argc) {
+            model_config.model_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--input-size") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &model_config.input_width, &model_config.input_height) != 2) {
+                std::cerr << "Invalid input size: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            model_config.warmup_runs = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--cache-dir") == 0 && i + 1 < argc) {
+            model_config.cache_dir = argv[++i];
+        } else if (std::strcmp(argv[i], "--opencv-preprocess") == 0) {
+            model_config.fused_preprocess = false;
+        } else if (std::strcmp(argv[i], "--max-batch") == 0 && i + 1 < argc) {
+            batch_config.max_batch_size = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--batch-delay") == 0 && i + 1 < argc) {
+            batch_config.max_delay_ms = std::max(0.0, std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-in-flight") == 0 && i + 1 < argc) {
+            max_in_flight = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--result-cache-mb") == 0 && i + 1 < argc) {
+            int megabytes = std::max(0, std::atoi(argv[++i]));
+            result_cache_config.enabled = megabytes > 0;
+            result_cache_config.max_bytes = static_cast<size_t>(megabytes) * 1024 * 1024;
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            inference_workers = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--opencv-threads") == 0 && i + 1 < argc) {
+            thread_topology.opencv_threads = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--pin") == 0 && i + 1 < argc) {
+            std::string mapping = argv[++i];
+            size_t equals = mapping.find('=');
+            ThreadRole role;
+            CpuSet cpus;
+            if (equals == std::string::npos || !threadRoleFromString(mapping.substr(0, equals), role) ||
+                !CpuSet::parse(mapping.substr(equals + 1), cpus)) {
+                std::cerr << "Invalid pinning: " << mapping << std::endl;
+                return 1;
+            }
+            thread_topology.cpus(role) = cpus;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    
+    // Set up signal handling before the logger and service start their threads
+    ShutdownSignalWatcher::install();
     
     // Initialize logging system
     Logger::getInstance().initialize(
@@ -35,9 +223,17 @@ int main() {
     app_logger.info("=== Inference Service Starting ===");
     app_logger.info("Logging system initialized");
     
-    std::cout << "Inference service with camera starting..." << std::endl;
+    std::cout << "Inference service starting (source " << source << ")..." << std::endl;
     
     InferenceService service;
+    service.setDisplayConfig(display_config);
+    service.setCaptureConfig(capture_config);
+    service.setModelConfig(model_config);
+    service.setBatching(batch_config);
+    service.setMaxInFlight(max_in_flight);
+    service.setResultCache(result_cache_config);
+    service.setInferenceWorkers(inference_workers);
+    service.setThreadTopology(thread_topology);
     
     // Initialize service
     app_logger.info("Initializing inference service");
@@ -61,25 +257,28 @@ int main() {
         std::cout << "Warning: Web API server failed to start" << std::endl;
     }
     
-    // Start camera
-    app_logger.info("Starting camera subsystem");
-    if (!service.startCamera(0)) {
-        app_logger.critical("Failed to start camera - terminating application");
-        std::cerr << "Failed to start camera" << std::endl;
+    // Start the frame source
+    app_logger.info("Starting frame source " + source + " (pacing " + pacingModeToString(capture_config.pacing) + ")");
+    if (!service.startStream(stream_name_for(source), source)) {
+        app_logger.critical("Failed to start frame source " + source + " - terminating application");
+        std::cerr << "Failed to start frame source " << source << std::endl;
         return -1;
     }
     
-    app_logger.info("Camera subsystem started - entering main processing loop");
-    std::cout << "Camera started. Press ESC in camera window to exit..." << std::endl;
+    app_logger.info("Frame source started - entering main processing loop");
+    if (display_config.headless) {
+        std::cout << "Source started (headless). Press Ctrl+C or POST /service/stop to exit..." << std::endl;
+    } else {
+        std::cout << "Source started. Press ESC in the preview window to exit..." << std::endl;
+    }
     
-    // Process camera frames
-    while (service.isCameraRunning() && !shutdown_requested) {
-        if (!service.processFrame()) {
-            break; // Exit on ESC key or error
+    // Process frames; sleeps until a frame lands or shutdown is requested
+    // (signal, ESC in the preview, POST /service/stop, or every stream ending)
+    {
+        ShutdownSignalWatcher signal_watcher([&service]() { service.requestShutdown(); });
+        if (!shutdown_requested) {
+            service.run();
         }
-        
-        // Small delay to prevent high CPU usage
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
     
     // Check if shutdown was requested via signal
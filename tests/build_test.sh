@@ -31,7 +31,7 @@ COMMON_FLAGS="-std=c++17 -I$INCLUDE_DIR -I$PROJECT_ROOT/vcpkg/installed/x64-wind
 COMMON_LIBS="-L$PROJECT_ROOT/vcpkg/installed/x64-windows/lib"
 
 # OpenCV libraries (adjust based on your installation)
-OPENCV_LIBS="-lopencv_core -lopencv_imgproc -lopencv_highgui -lopencv_imgcodecs -lopencv_videoio"
+OPENCV_LIBS="-lopencv_core -lopencv_imgproc -lopencv_highgui -lopencv_imgcodecs -lopencv_videoio -lopencv_dnn"
 
 echo -e "${YELLOW}Compiling unit tests...${NC}"
 
@@ -42,6 +42,141 @@ if [ -f "$TESTS_DIR/unit/test_logger.cpp" ]; then
         -o "$TEST_BUILD_DIR/test_logger" || echo -e "${RED}Failed to build test_logger${NC}"
 fi
 
+if [ -f "$TESTS_DIR/unit/test_frame_ring.cpp" ]; then
+    echo "Building test_frame_ring..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_frame_ring.cpp" \
+        -o "$TEST_BUILD_DIR/test_frame_ring" || echo -e "${RED}Failed to build test_frame_ring${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_latency_histogram.cpp" ]; then
+    echo "Building test_latency_histogram..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_latency_histogram.cpp" \
+        -o "$TEST_BUILD_DIR/test_latency_histogram" || echo -e "${RED}Failed to build test_latency_histogram${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_rate_controller.cpp" ]; then
+    echo "Building test_rate_controller..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_rate_controller.cpp" \
+        -o "$TEST_BUILD_DIR/test_rate_controller" || echo -e "${RED}Failed to build test_rate_controller${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_inference_backend.cpp" ]; then
+    echo "Building test_inference_backend..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_inference_backend.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_inference_backend" || echo -e "${RED}Failed to build test_inference_backend${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_batch_scheduler.cpp" ]; then
+    echo "Building test_batch_scheduler..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_batch_scheduler.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_batch_scheduler" || echo -e "${RED}Failed to build test_batch_scheduler${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_result_cache.cpp" ]; then
+    echo "Building test_result_cache..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_result_cache.cpp" \
+        -o "$TEST_BUILD_DIR/test_result_cache" || echo -e "${RED}Failed to build test_result_cache${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_model_pipeline.cpp" ]; then
+    echo "Building test_model_pipeline..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_model_pipeline.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_model_pipeline" || echo -e "${RED}Failed to build test_model_pipeline${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_thread_topology.cpp" ]; then
+    echo "Building test_thread_topology..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_thread_topology.cpp" \
+        -o "$TEST_BUILD_DIR/test_thread_topology" || echo -e "${RED}Failed to build test_thread_topology${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_network_cache.cpp" ]; then
+    echo "Building test_network_cache..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_network_cache.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_network_cache" || echo -e "${RED}Failed to build test_network_cache${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_tiled_inference.cpp" ]; then
+    echo "Building test_tiled_inference..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_tiled_inference.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_tiled_inference" || echo -e "${RED}Failed to build test_tiled_inference${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_fused_preprocess.cpp" ]; then
+    echo "Building test_fused_preprocess..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_fused_preprocess.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_fused_preprocess" || echo -e "${RED}Failed to build test_fused_preprocess${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_detection_postprocess.cpp" ]; then
+    echo "Building test_detection_postprocess..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_detection_postprocess.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_detection_postprocess" || echo -e "${RED}Failed to build test_detection_postprocess${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_letterbox.cpp" ]; then
+    echo "Building test_letterbox..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_letterbox.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_letterbox" || echo -e "${RED}Failed to build test_letterbox${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_strip_pipeline.cpp" ]; then
+    echo "Building test_strip_pipeline..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_strip_pipeline.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_strip_pipeline" || echo -e "${RED}Failed to build test_strip_pipeline${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_frame_pool.cpp" ]; then
+    echo "Building test_frame_pool..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_frame_pool.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_frame_pool" || echo -e "${RED}Failed to build test_frame_pool${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_frame_source.cpp" ]; then
+    echo "Building test_frame_source..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_frame_source.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_frame_source" || echo -e "${RED}Failed to build test_frame_source${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_capture_thread.cpp" ]; then
+    echo "Building test_capture_thread..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_capture_thread.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_capture_thread" || echo -e "${RED}Failed to build test_capture_thread${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_change_gate.cpp" ]; then
+    echo "Building test_change_gate..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_change_gate.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_change_gate" || echo -e "${RED}Failed to build test_change_gate${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_inference_service.cpp" ]; then
+    echo "Building test_inference_service..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_inference_service.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_inference_service" || echo -e "${RED}Failed to build test_inference_service${NC}"
+fi
+
+if [ -f "$TESTS_DIR/unit/test_json_escape.cpp" ]; then
+    echo "Building test_json_escape..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/unit/test_json_escape.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/test_json_escape" || echo -e "${RED}Failed to build test_json_escape${NC}"
+fi
+
 echo -e "${YELLOW}Compiling performance tests...${NC}"
 
 # Build performance tests
@@ -52,6 +187,20 @@ if [ -f "$TESTS_DIR/performance/perf_frame_processing.cpp" ]; then
         -o "$TEST_BUILD_DIR/perf_frame_processing" || echo -e "${RED}Failed to build perf_frame_processing${NC}"
 fi
 
+if [ -f "$TESTS_DIR/performance/perf_model_load.cpp" ]; then
+    echo "Building perf_model_load..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/performance/perf_model_load.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/perf_model_load" || echo -e "${RED}Failed to build perf_model_load${NC}"
+fi
+
+if [ -f "$TESTS_DIR/performance/perf_postprocess.cpp" ]; then
+    echo "Building perf_postprocess..."
+    g++ $COMMON_FLAGS "$TESTS_DIR/performance/perf_postprocess.cpp" \
+        $COMMON_LIBS $OPENCV_LIBS \
+        -o "$TEST_BUILD_DIR/perf_postprocess" || echo -e "${RED}Failed to build perf_postprocess${NC}"
+fi
+
 echo -e "${YELLOW}Compiling temporary tests...${NC}"
 
 # Build temp tests
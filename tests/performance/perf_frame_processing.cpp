@@ -6,6 +6,14 @@
 #include "inference_service.hpp"
 #include "performance_monitor.hpp"
 #include "logger.hpp"
+#include "frame_pool.hpp"
+#include "frame_source.hpp"
+#include "video_stream.hpp"
+#include "change_gate.hpp"
+#include "tiled_inference.hpp"
+#include "fused_preprocess.hpp"
+#include "letterbox.hpp"
+#include "strip_pipeline.hpp"
 #include <opencv2/opencv.hpp>
 #include <iostream>
 #include <chrono>
@@ -14,6 +22,14 @@
 
 class FrameProcessingPerfTest {
 public:
+    /**
+     * @brief Intermediate buffers reused across frames (no per-frame allocation)
+     */
+    struct ProcessingBuffers {
+        cv::Mat gray, blurred, edges, dilated;
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
+    };
+
     static void test_synthetic_frame_processing() {
         std::cout << "Testing synthetic frame processing performance..." << std::endl;
         
@@ -41,30 +57,390 @@ public:
         
         Logger::getInstance().shutdown();
     }
-    
+
+    /**
+     * @brief End-to-end throughput: synthetic source -> capture thread -> ring -> processing
+     *
+     * Unpaced source, a blocking ring and FIFO consumption until the ring is
+     * closed and drained, so every frame is processed and the result is the
+     * pipeline's sustainable frame rate.
+     */
+    static void test_pipeline_throughput() {
+        std::cout << "Testing capture pipeline throughput..." << std::endl;
+
+        Logger::getInstance().initialize(LogLevel::INFO, LogTarget::BOTH,
+                                       "test_logs/perf_test.log");
+        ModuleLogger perf_logger("PERF_TEST");
+
+        std::vector<cv::Size> test_sizes = {{640, 480}, {1280, 720}, {1920, 1080}};
+        const uint64_t num_frames = 300;
+
+        for (const auto& size : test_sizes) {
+            CaptureConfig config;
+            config.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            config.overflow_policy = OverflowPolicy::BLOCK;
+            config.max_frames = num_frames;
+
+            VideoStream stream("perf", config);
+            std::string source = "synthetic:" + std::to_string(size.width) + "x" + std::to_string(size.height);
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+            if (!stream.start(source)) {
+                throw std::runtime_error("Failed to start " + source);
+            }
+
+            ProcessingBuffers buffers;
+            uint64_t processed = 0;
+            CapturedFrame captured;
+            // Sleeps in the ring until a frame lands; returns false once closed and drained
+            while (!stream.isFinished()) {
+                if (stream.takeNextFrame(captured, std::chrono::milliseconds(100))) {
+                    process_frame(captured.frame.mat(), buffers);
+                    stream.recordResult(captured.metadata, FrameMetadata::Clock::now());
+                    captured.frame.reset();
+                    processed++;
+                }
+            }
+            auto end_time = std::chrono::high_resolution_clock::now();
+            stream.stop();
+            if (processed != num_frames) {
+                throw std::runtime_error("Pipeline " + source + " processed " + std::to_string(processed) +
+                                         " of " + std::to_string(num_frames) + " frames");
+            }
+
+            double seconds = std::chrono::duration<double>(end_time - start_time).count();
+            double fps = processed / seconds;
+
+            perf_logger.info("Pipeline " + source + ": " + std::to_string(processed) + " frames in " +
+                             std::to_string(seconds) + "s (" + std::to_string(fps) + " FPS)");
+
+            const LatencyHistogram& latency = stream.getCaptureToResultLatency();
+            perf_logger.info("Pipeline " + source + " capture-to-result: " + latency.toJson());
+
+            std::cout << "  " << source << ": " << processed << " frames, "
+                      << std::fixed << std::setprecision(1) << fps << " FPS, capture-to-result P50/P99: "
+                      << std::setprecision(2) << latency.getPercentile(0.50) << "/"
+                      << latency.getPercentile(0.99) << "ms" << std::endl;
+        }
+        std::cout << std::endl;
+
+        Logger::getInstance().shutdown();
+    }
+
+    /**
+     * @brief Cost of the change gate per frame versus the processing it can skip
+     */
+    static void test_change_gate_cost() {
+        std::cout << "Testing change gate cost..." << std::endl;
+
+        std::vector<cv::Size> test_sizes = {{640, 480}, {1280, 720}, {1920, 1080}};
+        const int num_frames = 200;
+
+        for (const auto& size : test_sizes) {
+            FrameSourceOptions source_options;
+            source_options.width = size.width;
+            source_options.height = size.height;
+            source_options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            SyntheticSource source(source_options);
+            if (!source.open()) {
+                throw std::runtime_error("Failed to open synthetic source");
+            }
+
+            ChangeGateConfig gate_config;
+            gate_config.enabled = true;
+            ChangeGate gate(gate_config);
+            cv::Mat frame;
+            source.read(frame);
+
+            // Same frame every time (static scene): every call after the first is a reuse
+            auto start_time = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < num_frames; ++i) {
+                gate.shouldProcess(frame);
+            }
+            auto end_time = std::chrono::high_resolution_clock::now();
+            double gate_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count() / num_frames;
+
+            ProcessingBuffers buffers;
+            cv::Mat work;
+            start_time = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < 20; ++i) {
+                frame.copyTo(work);
+                process_frame(work, buffers);
+            }
+            end_time = std::chrono::high_resolution_clock::now();
+            double process_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count() / 20;
+
+            ChangeGateStats stats = gate.getStats();
+            std::cout << "  " << size.width << "x" << size.height << ": gate "
+                      << std::fixed << std::setprecision(3) << gate_ms << "ms/frame vs processing "
+                      << process_ms << "ms/frame, skip ratio " << std::setprecision(2) << stats.skipRatio() << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    static void test_tiled_inference() {
+        std::cout << "Testing tiled inference cost..." << std::endl;
+
+        auto backend = std::make_shared<ReferenceBackend>();
+        backend->load(ModelConfig());
+        // 8x8 grid of 60x60 boxes per tile: neighbouring tiles report the same objects in their overlap
+        RegionDecoder grid = [](const std::vector<cv::Mat>& outputs, size_t index, const cv::Size& tile_size) {
+            std::vector<PipelineRegion> regions;
+            for (int y = 0; y + 60 <= tile_size.height; y += 80) {
+                for (int x = 0; x + 60 <= tile_size.width; x += 80) {
+                    PipelineRegion region;
+                    region.box = cv::Rect(x, y, 60, 60);
+                    region.class_id = (x / 80 + y / 80) % 3;
+                    region.score = 0.5f + outputs[0].at<float>(static_cast<int>(index), region.class_id) * 0.5f;
+                    regions.push_back(region);
+                }
+            }
+            return regions;
+        };
+
+        std::vector<cv::Size> test_sizes = {{1280, 720}, {1920, 1080}};
+        const int num_frames = 50;
+        for (const auto& size : test_sizes) {
+            FrameSourceOptions source_options;
+            source_options.width = size.width;
+            source_options.height = size.height;
+            source_options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            SyntheticSource source(source_options);
+            if (!source.open()) {
+                throw std::runtime_error("Failed to open synthetic source");
+            }
+            cv::Mat frame;
+
+            for (bool batch_tiles : {true, false}) {
+                TilingConfig config;
+                config.batch_tiles = batch_tiles;
+                TiledInference tiler(backend, grid, config);
+                std::vector<PipelineRegion> detections;
+                TiledFrameStats stats;
+                double inference_ms = 0.0;
+                double merge_ms = 0.0;
+                for (int i = 0; i < num_frames; ++i) {
+                    source.read(frame);
+                    if (!tiler.run(frame, detections, &stats)) {
+                        throw std::runtime_error("Tiled inference failed");
+                    }
+                    inference_ms += stats.inference_ms;
+                    merge_ms += stats.merge_ms;
+                }
+                std::cout << "  " << size.width << "x" << size.height << " " << (batch_tiles ? "batch   " : "parallel")
+                          << ": " << stats.tiles << " tiles, " << stats.raw_detections << " -> " << stats.detections
+                          << " detections, inference " << std::fixed << std::setprecision(3) << inference_ms / num_frames
+                          << "ms/frame, merge " << merge_ms / num_frames << "ms/frame" << std::endl;
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    static void test_preprocessing() {
+        std::cout << "Testing input preprocessing (640x640 float tensor)..." << std::endl;
+
+        std::vector<cv::Size> test_sizes = {{320, 240}, {640, 480}, {1280, 720}, {1920, 1080}};
+        const cv::Size input_size(640, 640);
+        const double scale = 1.0 / 255.0;
+        const cv::Scalar mean(0, 0, 0);
+        const int num_frames = 50;
+        std::vector<float> tensor(3 * static_cast<size_t>(input_size.area()));
+        std::vector<int8_t> quantized(tensor.size());
+
+        for (const auto& size : test_sizes) {
+            FrameSourceOptions source_options;
+            source_options.width = size.width;
+            source_options.height = size.height;
+            source_options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            SyntheticSource source(source_options);
+            if (!source.open()) {
+                throw std::runtime_error("Failed to open synthetic source");
+            }
+            cv::Mat frame;
+            source.read(frame);
+
+            // Unfused: four passes with intermediate Mats (reused across frames)
+            cv::Mat rgb, resized, converted;
+            std::vector<cv::Mat> planes;
+            for (int c = 0; c < 3; ++c) {
+                planes.emplace_back(input_size, CV_32F, tensor.data() + c * static_cast<size_t>(input_size.area()));
+            }
+            double unfused_ms = timePerFrame(num_frames, [&]() {
+                cv::cvtColor(frame, rgb, cv::COLOR_BGR2RGB);
+                cv::resize(rgb, resized, input_size, 0, 0, cv::INTER_LINEAR);
+                resized.convertTo(converted, CV_32F, scale);
+                cv::split(converted, planes);
+            });
+
+            cv::Mat blob;
+            double blob_ms = timePerFrame(num_frames, [&]() {
+                cv::dnn::blobFromImage(frame, blob, scale, input_size, mean, true, false, CV_32F);
+            });
+
+            std::cout << "  " << size.width << "x" << size.height << ": unfused " << std::fixed << std::setprecision(3)
+                      << unfused_ms << "ms, blobFromImage " << blob_ms << "ms";
+            FusedPreprocessor preprocessor(input_size, scale, mean, true);
+            for (SimdPath path : FusedPreprocessor::availablePaths()) {
+                preprocessor.setPath(path);
+                double fused_ms = timePerFrame(num_frames, [&]() { preprocessor.run(frame, tensor.data()); });
+                std::cout << ", " << simdPathToString(path) << " " << fused_ms << "ms (" << std::setprecision(1)
+                          << unfused_ms / fused_ms << "x)" << std::setprecision(3);
+            }
+            preprocessor.setPath(FusedPreprocessor::bestPath());
+            double int8_ms = timePerFrame(num_frames, [&]() { preprocessor.run(frame, quantized.data(), Int8Quantization()); });
+            std::cout << ", int8 " << int8_ms << "ms" << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    static void test_letterbox() {
+        std::cout << "Testing letterbox preprocessing (640x640, pad 114)..." << std::endl;
+
+        std::vector<cv::Size> test_sizes = {{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+        const cv::Size input_size(640, 640);
+        const double scale = 1.0 / 255.0;
+        const cv::Scalar pad_value = cv::Scalar::all(114);
+        const int num_frames = 50;
+
+        for (const auto& size : test_sizes) {
+            FrameSourceOptions source_options;
+            source_options.width = size.width;
+            source_options.height = size.height;
+            source_options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            SyntheticSource source(source_options);
+            if (!source.open()) {
+                throw std::runtime_error("Failed to open synthetic source");
+            }
+            cv::Mat frame;
+            source.read(frame);
+            LetterboxTransform transform = LetterboxTransform::letterbox(size, input_size);
+
+            // Usual approach: resize, pad into a new image, then build the blob from it
+            cv::Mat resized, padded, blob;
+            double baseline_ms = timePerFrame(num_frames, [&]() {
+                cv::resize(frame, resized, transform.content.size(), 0, 0, cv::INTER_LINEAR);
+                cv::copyMakeBorder(resized, padded, transform.content.y,
+                                   input_size.height - transform.content.y - transform.content.height, transform.content.x,
+                                   input_size.width - transform.content.x - transform.content.width,
+                                   cv::BORDER_CONSTANT, pad_value);
+                cv::dnn::blobFromImage(padded, blob, scale, cv::Size(), cv::Scalar(), true, false, CV_32F);
+            });
+
+            Letterboxer letterboxer(input_size, scale);
+            LetterboxedFrame letterboxed;
+            double fused_ms = timePerFrame(num_frames, [&]() { letterboxer.process(frame, letterboxed); });
+            FramePoolStats pool_stats = letterboxer.getPoolStats();
+
+            std::cout << "  " << size.width << "x" << size.height << " (content " << transform.content.width << "x"
+                      << transform.content.height << "): resize + copyMakeBorder + blob " << std::fixed
+                      << std::setprecision(3) << baseline_ms << "ms, letterboxer " << fused_ms << "ms ("
+                      << std::setprecision(1) << baseline_ms / fused_ms << "x), pool misses " << pool_stats.misses
+                      << std::setprecision(3) << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    static void test_strip_pipeline() {
+        std::cout << "Testing the cache-blocked strip pipeline (process_frame chain)..." << std::endl;
+
+        std::vector<cv::Size> test_sizes = {{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}};
+        const int num_frames = 30;
+
+        for (const auto& size : test_sizes) {
+            FrameSourceOptions source_options;
+            source_options.width = size.width;
+            source_options.height = size.height;
+            source_options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            SyntheticSource source(source_options);
+            if (!source.open()) {
+                throw std::runtime_error("Failed to open synthetic source");
+            }
+            cv::Mat frame, work, expected;
+            source.read(frame);
+
+            // Stage by stage over the whole frame, as the other tests run it
+            ProcessingBuffers buffers;
+            double serial_ms = timePerFrame(num_frames, [&]() {
+                frame.copyTo(work);
+                process_frame(work, buffers);
+            });
+            work.copyTo(expected);
+
+            std::cout << "  " << size.width << "x" << size.height << ": serial " << std::fixed << std::setprecision(3)
+                      << serial_ms << "ms";
+            // One participant isolates the cache blocking; then every hardware thread
+            for (size_t threads : {static_cast<size_t>(1), static_cast<size_t>(0)}) {
+                StripConfig config;
+                config.threads = threads;
+                StripPipeline pipeline(processFrameStages(buffers.kernel), config);
+                double strip_ms = timePerFrame(num_frames, [&]() {
+                    frame.copyTo(work);
+                    pipeline.run(work, work);
+                });
+                const bool identical = cv::norm(work, expected, cv::NORM_INF) == 0.0;
+                std::cout << ", " << pipeline.getThreadCount() << " thread(s) " << strip_ms << "ms ("
+                          << std::setprecision(1) << serial_ms / strip_ms << "x, "
+                          << pipeline.computeStripRows(0, size, CV_8UC3) << "-row strips, "
+                          << (identical ? "identical" : "DIFFERS") << ")" << std::setprecision(3);
+                if (!identical) {
+                    throw std::runtime_error("Strip pipeline output differs from the serial chain");
+                }
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
 private:
+    template <typename Work>
+    static double timePerFrame(int frames, Work work) {
+        work(); // Warm-up: first-call allocations
+        auto start_time = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            work();
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count() / frames;
+    }
+
     static void test_frame_processing_at_resolution(const cv::Size& size, 
                                                   PerformanceMonitor& monitor,
                                                   ModuleLogger& logger) {
         const int num_frames = 100;
         std::vector<double> processing_times;
+        processing_times.reserve(num_frames);
         
         // Reset monitor for this test
         monitor.reset();
         
+        FramePool pool(size, CV_8UC3, 2);
+        ProcessingBuffers buffers;
+        
+        FrameSourceOptions source_options;
+        source_options.width = size.width;
+        source_options.height = size.height;
+        source_options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+        SyntheticSource source(source_options);
+        if (!source.open()) {
+            throw std::runtime_error("Failed to open synthetic source");
+        }
+        
         for (int i = 0; i < num_frames; ++i) {
             monitor.startFrame();
             
             // Create synthetic frame
-            cv::Mat frame = create_synthetic_frame(size);
+            PooledFrame frame = pool.acquire();
+            source.read(frame.mat());
             
             // Simulate typical image processing operations
-            process_frame(frame);
+            process_frame(frame.mat(), buffers);
             
             monitor.endFrame();
             processing_times.push_back(monitor.getCurrentFrameTime());
         }
         
+        FramePoolStats pool_stats = pool.getStats();
+        
         // Calculate statistics
         double avg_time = std::accumulate(processing_times.begin(), 
                                         processing_times.end(), 0.0) / num_frames;
@@ -87,6 +463,7 @@ private:
         logger.info("P95 time: " + std::to_string(p95_time) + "ms");
         logger.info("P99 time: " + std::to_string(p99_time) + "ms");
         logger.info("Theoretical FPS: " + std::to_string(1000.0 / avg_time));
+        logger.info("Frame pool: " + pool_stats.toJson());
         
         // Console output for immediate feedback
         std::cout << "  Resolution: " << size.width << "x" << size.height << std::endl;
@@ -94,51 +471,44 @@ private:
         std::cout << "  Range: " << min_time << " - " << max_time << "ms" << std::endl;
         std::cout << "  P95/P99: " << p95_time << "/" << p99_time << "ms" << std::endl;
         std::cout << "  Theoretical FPS: " << std::setprecision(1) << (1000.0 / avg_time) << std::endl;
+        std::cout << "  Frame pool hits/misses: " << pool_stats.hits << "/" << pool_stats.misses << std::endl;
         std::cout << std::endl;
     }
     
-    static cv::Mat create_synthetic_frame(const cv::Size& size) {
-        // Create a synthetic frame with some patterns
-        cv::Mat frame(size, CV_8UC3);
-        
-        // Fill with gradient pattern
-        for (int y = 0; y < size.height; ++y) {
-            for (int x = 0; x < size.width; ++x) {
-                frame.at<cv::Vec3b>(y, x) = cv::Vec3b(
-                    static_cast<uchar>((x * 255) / size.width),
-                    static_cast<uchar>((y * 255) / size.height),
-                    static_cast<uchar>(((x + y) * 255) / (size.width + size.height))
-                );
-            }
-        }
-        
-        return frame;
-    }
-    
-    static void process_frame(cv::Mat& frame) {
+    static void process_frame(cv::Mat& frame, ProcessingBuffers& buffers) {
         // Simulate typical image processing pipeline
-        cv::Mat gray, blurred, edges;
+        // Destination Mats keep their storage between calls, so create() is a no-op
         
         // Convert to grayscale
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+        cv::cvtColor(frame, buffers.gray, cv::COLOR_BGR2GRAY);
         
         // Apply Gaussian blur
-        cv::GaussianBlur(gray, blurred, cv::Size(5, 5), 1.5);
+        cv::GaussianBlur(buffers.gray, buffers.blurred, cv::Size(5, 5), 1.5);
         
         // Edge detection
-        cv::Canny(blurred, edges, 50, 150);
+        cv::Canny(buffers.blurred, buffers.edges, 50, 150);
         
         // Some morphological operations
-        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
-        cv::Mat dilated;
-        cv::dilate(edges, dilated, kernel);
-        
-        // Convert back to color (simulate output preparation)
-        cv::Mat result;
-        cv::cvtColor(dilated, result, cv::COLOR_GRAY2BGR);
+        cv::dilate(buffers.edges, buffers.dilated, buffers.kernel);
         
-        // Copy result back to original frame
-        result.copyTo(frame);
+        // Convert back to color straight into the frame (simulate output preparation)
+        cv::cvtColor(buffers.dilated, frame, cv::COLOR_GRAY2BGR);
+    }
+
+    /**
+     * @brief process_frame as strip stages (Canny needs the whole frame)
+     */
+    static std::vector<StripStage> processFrameStages(const cv::Mat& kernel) {
+        return {
+            StripStage::rows("gray", 0, CV_8UC1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY); }),
+            StripStage::rows("blur", 2, -1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::GaussianBlur(src, dst, cv::Size(5, 5), 1.5); }),
+            StripStage::whole("canny", CV_8UC1, [](const cv::Mat& src, cv::Mat& dst) { cv::Canny(src, dst, 50, 150); }),
+            StripStage::rows("dilate", 1, -1, [kernel](const cv::Mat& src, cv::Mat& dst) { cv::dilate(src, dst, kernel); }),
+            StripStage::rows("bgr", 0, CV_8UC3,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::cvtColor(src, dst, cv::COLOR_GRAY2BGR); }),
+        };
     }
 };
 
@@ -149,6 +519,12 @@ int main() {
     
     try {
         FrameProcessingPerfTest::test_synthetic_frame_processing();
+        FrameProcessingPerfTest::test_pipeline_throughput();
+        FrameProcessingPerfTest::test_change_gate_cost();
+        FrameProcessingPerfTest::test_tiled_inference();
+        FrameProcessingPerfTest::test_preprocessing();
+        FrameProcessingPerfTest::test_letterbox();
+        FrameProcessingPerfTest::test_strip_pipeline();
         
         std::cout << "🎉 Performance test completed!" << std::endl;
         
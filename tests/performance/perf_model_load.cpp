@@ -0,0 +1,220 @@
+/**
+ * @file perf_model_load.cpp
+ * @brief Model load time and resident memory, with and without memory mapping,
+ *        and startup with a cold and a warm optimized-network cache
+ *
+ * Usage: perf_model_load [model.onnx]
+ * Without a model (or INFERENCE_BENCH_MODEL) only the raw file test runs.
+ */
+
+#include "inference_backend.hpp"
+#include "mapped_file.hpp"
+#include "network_cache.hpp"
+#include "logger.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+class ModelLoadPerfTest {
+public:
+    /**
+     * @brief Resident set split into anonymous (private heap) and file-backed (shareable) pages
+     */
+    struct ResidentMemory {
+        double anon_mb = 0.0;
+        double file_mb = 0.0;
+    };
+
+    /**
+     * @brief Reading a large file into the heap vs mapping it and touching every page
+     */
+    static void test_raw_file_load() {
+        std::cout << "Testing raw file load (heap read vs mapping)..." << std::endl;
+
+        const size_t file_mb = 64;
+        const std::string path = "perf_model_load.bin";
+        {
+            std::ofstream out(path, std::ios::binary);
+            std::vector<char> block(1024 * 1024);
+            for (size_t i = 0; i < block.size(); ++i) block[i] = static_cast<char>(i * 31 + i / 4096);
+            for (size_t i = 0; i < file_mb; ++i) out.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+
+        // Mapping first: freed heap pages are not always returned to the OS
+        {
+            ResidentMemory before = readResidentMemory();
+            auto start = std::chrono::steady_clock::now();
+            MappedFile file(path);
+            double open_ms = elapsedMs(start);
+            uint64_t checksum = touchPages(file.data(), file.size());
+            double total_ms = elapsedMs(start);
+            ResidentMemory after = readResidentMemory();
+            printResult("mmap (MAP_SHARED)", open_ms, total_ms, before, after, checksum);
+        }
+        {
+            ResidentMemory before = readResidentMemory();
+            auto start = std::chrono::steady_clock::now();
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            std::vector<uint8_t> buffer(static_cast<size_t>(in.tellg()));
+            in.seekg(0);
+            in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            double open_ms = elapsedMs(start);
+            uint64_t checksum = touchPages(buffer.data(), buffer.size());
+            double total_ms = elapsedMs(start);
+            ResidentMemory after = readResidentMemory();
+            printResult("heap read", open_ms, total_ms, before, after, checksum);
+        }
+
+        std::remove(path.c_str());
+        std::cout << "  File-backed pages are shared by every process mapping the file; anonymous pages are per process" << std::endl;
+        std::cout << "✅ Raw file load test completed" << std::endl << std::endl;
+    }
+
+    /**
+     * @brief Backend load with and without map_weights
+     */
+    static void test_backend_load(const std::string& model_path) {
+        std::cout << "Testing OpenCV DNN model load: " << model_path << std::endl;
+
+        for (bool map_weights : {true, false}) {
+            ModelConfig config;
+            config.model_path = model_path;
+            config.map_weights = map_weights;
+            config.warmup_runs = 1;
+
+            ResidentMemory before = readResidentMemory();
+            auto start = std::chrono::steady_clock::now();
+            auto backend = InferenceBackend::create("opencv_dnn");
+            if (!backend->load(config)) {
+                std::cout << "  ❌ Load failed" << std::endl;
+                return;
+            }
+            double total_ms = elapsedMs(start);
+            ResidentMemory after = readResidentMemory();
+
+            const ModelLoadTimings& timings = backend->getLoadTimings();
+            std::cout << std::fixed << std::setprecision(2);
+            std::cout << "  " << std::left << std::setw(18) << (map_weights ? "mapped" : "readNet(path)") << std::right
+                      << " parse " << std::setw(8) << timings.parse_ms << "ms"
+                      << "  setup " << std::setw(8) << timings.setup_ms << "ms"
+                      << "  warm-up " << std::setw(8) << timings.warmup_ms << "ms"
+                      << "  total " << std::setw(8) << total_ms << "ms"
+                      << "  RSS anon +" << (after.anon_mb - before.anon_mb) << "MB"
+                      << ", file +" << (after.file_mb - before.file_mb) << "MB" << std::endl;
+        }
+        std::cout << "  OpenCV DNN copies weights into its own blobs, so anonymous RSS stays per process either way" << std::endl;
+        std::cout << "✅ Backend load test completed" << std::endl << std::endl;
+    }
+
+    /**
+     * @brief Startup (create + load + warm-up) with an empty cache directory, then with the filled one
+     */
+    static void test_network_cache(const std::string& model_path) {
+        std::cout << "Testing startup with cold and warm network cache: " << model_path << std::endl;
+
+        std::filesystem::path cache_dir = std::filesystem::temp_directory_path() / "perf_model_load_cache";
+        std::filesystem::remove_all(cache_dir);
+
+        for (const char* label : {"cold cache", "warm cache"}) {
+            ModelConfig config;
+            config.model_path = model_path;
+            config.cache_dir = cache_dir.string();
+            config.warmup_runs = 1;
+
+            auto start = std::chrono::steady_clock::now();
+            auto backend = InferenceBackend::create("opencv_dnn");
+            if (!NetworkCache(config.cache_dir).loadBackend(*backend, config)) {
+                std::cout << "  ❌ Load failed" << std::endl;
+                return;
+            }
+            double total_ms = elapsedMs(start);
+
+            const NetworkCacheStatus& status = backend->getNetworkCacheStatus();
+            std::cout << std::fixed << std::setprecision(2);
+            std::cout << "  " << std::left << std::setw(18) << label << std::right
+                      << " startup " << std::setw(8) << total_ms << "ms"
+                      << "  (hash " << status.key_ms << "ms, cache io " << status.io_ms << "ms, state: "
+                      << status.state << ")" << std::endl;
+        }
+
+        std::filesystem::remove_all(cache_dir);
+        std::cout << "  The second start reads the model from the page cache either way; state \"unsupported\" means the" << std::endl;
+        std::cout << "  backend cannot export its optimized network, so both starts parse and optimize" << std::endl;
+        std::cout << "✅ Network cache test completed" << std::endl << std::endl;
+    }
+
+private:
+    static ResidentMemory readResidentMemory() {
+        ResidentMemory memory;
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            double kb = 0.0;
+            fields >> key >> kb;
+            if (key == "RssAnon:") memory.anon_mb = kb / 1024.0;
+            if (key == "RssFile:") memory.file_mb = kb / 1024.0;
+        }
+#endif
+        return memory;
+    }
+
+    // Reads one byte per page so every page is faulted in
+    static uint64_t touchPages(const uint8_t* data, size_t size) {
+        uint64_t checksum = 0;
+        for (size_t offset = 0; offset < size; offset += 4096) {
+            checksum += data[offset];
+        }
+        return checksum;
+    }
+
+    static void printResult(const std::string& label, double open_ms, double total_ms,
+                            const ResidentMemory& before, const ResidentMemory& after, uint64_t checksum) {
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "  " << std::left << std::setw(18) << label << std::right
+                  << " open/read " << std::setw(8) << open_ms << "ms"
+                  << "  all pages " << std::setw(8) << total_ms << "ms"
+                  << "  RSS anon +" << (after.anon_mb - before.anon_mb) << "MB"
+                  << ", file +" << (after.file_mb - before.file_mb) << "MB"
+                  << "  (checksum " << checksum << ")" << std::endl;
+    }
+
+    static double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+int main(int argc, char* argv[]) {
+    std::cout << "⚡ Model Load Performance Test" << std::endl;
+    std::cout << "==============================" << std::endl;
+    std::cout << std::endl;
+
+    try {
+        ModelLoadPerfTest::test_raw_file_load();
+
+        const char* env_model = std::getenv("INFERENCE_BENCH_MODEL");
+        std::string model_path = argc > 1 ? argv[1] : (env_model ? env_model : "");
+        if (model_path.empty()) {
+            std::cout << "No model given (argument or INFERENCE_BENCH_MODEL), skipping backend load test" << std::endl;
+        } else {
+            ModelLoadPerfTest::test_backend_load(model_path);
+            ModelLoadPerfTest::test_network_cache(model_path);
+        }
+
+        std::cout << "🎉 Performance test completed!" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Performance test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file test_batch_scheduler.cpp
+ * @brief Unit tests for the dynamic batch scheduler
+ */
+
+#include "batch_scheduler.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <future>
+
+/**
+ * @brief Reference backend that records the size of every batch it runs
+ */
+class RecordingBackend : public ReferenceBackend {
+public:
+    bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch_sizes.push_back(images.size());
+        }
+        if (fail) {
+            return false;
+        }
+        return ReferenceBackend::runBatch(images, outputs);
+    }
+
+    std::mutex mutex;
+    std::vector<size_t> batch_sizes;
+    bool fail = false;
+};
+
+class BatchSchedulerTest {
+public:
+    static void test_full_batches() {
+        std::cout << "Testing batches fill up to the maximum size..." << std::endl;
+
+        auto backend = std::make_shared<RecordingBackend>();
+        backend->load(ModelConfig());
+        BatchSchedulerConfig config;
+        config.max_batch_size = 4;
+        config.max_delay_ms = 200.0; // Long enough that only the size limit triggers
+        BatchScheduler scheduler(backend, config);
+
+        // Dominant channel alternates so each result can be matched to its request
+        std::vector<cv::Mat> images;
+        for (int i = 0; i < 8; ++i) {
+            images.emplace_back(8, 8, CV_8UC3, i % 2 ? cv::Scalar(0, 0, 255) : cv::Scalar(255, 0, 0));
+        }
+        std::vector<std::future<InferenceResult>> results;
+        for (const auto& image : images) {
+            results.push_back(scheduler.submit(image));
+        }
+        for (size_t i = 0; i < results.size(); ++i) {
+            InferenceResult result = results[i].get();
+            assert(result.top_index == (i % 2 ? 2 : 0));
+        }
+
+        assert(scheduler.getRequestCount() == 8);
+        assert(scheduler.getBatchCount() == 2);
+        assert(backend->batch_sizes.size() == 2 && backend->batch_sizes[0] == 4 && backend->batch_sizes[1] == 4);
+        assert(scheduler.getQueueDelay().getCount() == 8);
+
+        std::cout << "✅ Full batch test passed" << std::endl;
+    }
+
+    static void test_delay_flush() {
+        std::cout << "Testing partial batch flushes after the delay..." << std::endl;
+
+        auto backend = std::make_shared<RecordingBackend>();
+        backend->load(ModelConfig());
+        BatchSchedulerConfig config;
+        config.max_batch_size = 16;
+        config.max_delay_ms = 5.0;
+        BatchScheduler scheduler(backend, config);
+
+        cv::Mat image(8, 8, CV_8UC3, cv::Scalar(0, 255, 0));
+        auto start = std::chrono::steady_clock::now();
+        InferenceResult result = scheduler.submit(image).get();
+        double waited_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        assert(result.top_index == 1);
+        assert(backend->batch_sizes.size() == 1 && backend->batch_sizes[0] == 1);
+        assert(waited_ms >= 4.0 && waited_ms < 200.0);
+
+        std::cout << "✅ Delay flush test passed (waited " << waited_ms << "ms)" << std::endl;
+    }
+
+    static void test_failure_propagates() {
+        std::cout << "Testing backend failures reach every request..." << std::endl;
+
+        auto backend = std::make_shared<RecordingBackend>();
+        backend->load(ModelConfig());
+        backend->fail = true;
+        BatchSchedulerConfig config;
+        config.max_batch_size = 2;
+        config.max_delay_ms = 1.0;
+        BatchScheduler scheduler(backend, config);
+
+        cv::Mat image(8, 8, CV_8UC3, cv::Scalar(0, 0, 0));
+        auto first = scheduler.submit(image);
+        auto second = scheduler.submit(image);
+        int failures = 0;
+        for (auto* future : {&first, &second}) {
+            try {
+                future->get();
+            } catch (const std::runtime_error&) {
+                failures++;
+            }
+        }
+        assert(failures == 2);
+
+        std::cout << "✅ Failure propagation test passed" << std::endl;
+    }
+
+    static void test_shutdown_drains() {
+        std::cout << "Testing shutdown runs queued requests..." << std::endl;
+
+        auto backend = std::make_shared<RecordingBackend>();
+        backend->load(ModelConfig());
+        BatchSchedulerConfig config;
+        config.max_batch_size = 8;
+        config.max_delay_ms = 10000.0;
+        BatchScheduler scheduler(backend, config);
+
+        cv::Mat image(8, 8, CV_8UC3, cv::Scalar(255, 0, 0));
+        auto result = scheduler.submit(image);
+        scheduler.shutdown();
+        InferenceResult flushed = result.get();
+        assert(flushed.top_index == 0);
+
+        bool rejected = false;
+        try {
+            scheduler.submit(image);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected);
+
+        std::cout << "✅ Shutdown drain test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Batch Scheduler Unit Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    BatchSchedulerTest::test_full_batches();
+    BatchSchedulerTest::test_delay_flush();
+    BatchSchedulerTest::test_failure_propagates();
+    BatchSchedulerTest::test_shutdown_drains();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All batch scheduler unit tests passed!" << std::endl;
+    return 0;
+}
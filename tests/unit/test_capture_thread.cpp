@@ -0,0 +1,154 @@
+/**
+ * @file test_capture_thread.cpp
+ * @brief Unit tests for the capture thread's grab/decode split
+ */
+
+#include "capture_thread.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Finite source that counts grabs and decodes; each frame is filled with its index
+ */
+class CountingSource : public FrameSource {
+public:
+    CountingSource(uint64_t total, const FrameSourceOptions& options)
+        : FrameSource(options), total_(total) {}
+
+    bool open() override { opened_ = true; return true; }
+    void close() override { opened_ = false; }
+    bool isOpened() const override { return opened_; }
+    cv::Size getFrameSize() const override { return cv::Size(options_.width, options_.height); }
+    double getNativeFps() const override { return 0.0; }
+    std::string describe() const override { return "counting"; }
+
+    std::atomic<uint64_t> grabs{0};
+    std::atomic<uint64_t> retrieves{0};
+
+protected:
+    bool grabFrame() override {
+        if (grabs == total_) {
+            markExhausted();
+            return false;
+        }
+        grabs++;
+        return true;
+    }
+
+    bool retrieveFrame(cv::Mat& frame) override {
+        retrieves++;
+        frame.create(options_.height, options_.width, CV_8UC3);
+        frame.setTo(cv::Scalar::all(static_cast<double>(grabs.load() % 256)));
+        return true;
+    }
+
+private:
+    uint64_t total_;
+    bool opened_ = false;
+};
+
+class CaptureThreadTest {
+public:
+    static void test_every_nth_decodes_only_admitted_frames() {
+        std::cout << "Testing every_nth grabs every frame but decodes one in N..." << std::endl;
+
+        const uint64_t produced = 30;
+        const uint64_t n = 3;
+
+        CaptureConfig config;
+        config.width = 32;
+        config.height = 24;
+        config.ring_capacity = 4;
+        config.overflow_policy = OverflowPolicy::BLOCK;   // Keep every decoded frame
+        config.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+
+        auto owned = std::make_unique<CountingSource>(produced, config.toSourceOptions());
+        CountingSource* source = owned.get();
+
+        CaptureThread capture(config);
+        RateControlConfig policy;
+        policy.mode = RateControlMode::EVERY_NTH;
+        policy.every_nth = n;
+        capture.setDecodePolicy(policy);
+        bool started = capture.start(std::move(owned));
+        assert(started);
+
+        std::vector<uint64_t> sequences;
+        std::vector<int> pixels;
+        CapturedFrame captured;
+        while (!capture.isFinished()) {
+            if (capture.getNextFrame(captured, std::chrono::milliseconds(100))) {
+                sequences.push_back(captured.metadata.sequence);
+                pixels.push_back(captured.frame.mat().ptr<uchar>(0)[0]);
+            }
+        }
+        capture.stop();
+
+        assert(source->grabs == produced);
+        assert(source->retrieves == produced / n);
+        assert(capture.getGrabbedFrames() == produced);
+        assert(capture.getCapturedFrames() == produced / n);
+        assert(capture.getSkippedFrames() == produced - produced / n);
+
+        // The decoded frames are exactly every Nth grab, in order
+        assert(sequences.size() == produced / n);
+        for (size_t i = 1; i < sequences.size(); ++i) {
+            assert(sequences[i] - sequences[i - 1] == n);
+            assert(pixels[i] - pixels[i - 1] == static_cast<int>(n));
+        }
+
+        std::cout << "✅ every_nth decode test passed" << std::endl;
+    }
+
+    static void test_every_frame_decoded_without_skipping() {
+        std::cout << "Testing every_nth=1 decodes every frame..." << std::endl;
+
+        const uint64_t produced = 12;
+
+        CaptureConfig config;
+        config.width = 32;
+        config.height = 24;
+        config.overflow_policy = OverflowPolicy::BLOCK;
+        config.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+
+        auto owned = std::make_unique<CountingSource>(produced, config.toSourceOptions());
+        CountingSource* source = owned.get();
+
+        CaptureThread capture(config);
+        RateControlConfig policy;
+        policy.mode = RateControlMode::EVERY_NTH;
+        policy.every_nth = 1;
+        capture.setDecodePolicy(policy);
+        bool started = capture.start(std::move(owned));
+        assert(started);
+
+        uint64_t consumed = 0;
+        CapturedFrame captured;
+        while (!capture.isFinished()) {
+            if (capture.getNextFrame(captured, std::chrono::milliseconds(100))) {
+                consumed++;
+            }
+        }
+        capture.stop();
+
+        assert(source->grabs == produced);
+        assert(source->retrieves == produced);
+        assert(consumed == produced);
+        assert(capture.getSkippedFrames() == 0);
+
+        std::cout << "✅ every_nth=1 decode test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Capture Thread Unit Tests" << std::endl;
+    std::cout << "===================================" << std::endl;
+
+    CaptureThreadTest::test_every_nth_decodes_only_admitted_frames();
+    CaptureThreadTest::test_every_frame_decoded_without_skipping();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All capture thread unit tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file test_change_gate.cpp
+ * @brief Unit tests for the static-scene change gate and per-stream result reuse
+ */
+
+#include "change_gate.hpp"
+#include "video_stream.hpp"
+#include <cassert>
+#include <iostream>
+
+class ChangeGateTest {
+public:
+    static cv::Mat frame(int value) {
+        return cv::Mat(48, 64, CV_8UC3, cv::Scalar(value, value, value));
+    }
+
+    static ChangeGateConfig enabledConfig() {
+        ChangeGateConfig config;
+        config.enabled = true;
+        config.threshold = 2.0;
+        config.analysis_width = 32;
+        config.max_reuse_frames = 0;
+        return config;
+    }
+
+    static FrameMetadata metadata(uint64_t sequence) {
+        FrameMetadata metadata;
+        metadata.sequence = sequence;
+        metadata.capture_time = FrameMetadata::Clock::now();
+        return metadata;
+    }
+
+    static void test_static_frame_skipped() {
+        std::cout << "Testing static frames are skipped..." << std::endl;
+
+        ChangeGate gate(enabledConfig());
+        bool process = gate.shouldProcess(frame(100));
+        assert(process);    // No reference yet
+        process = gate.shouldProcess(frame(100));
+        assert(!process);
+        process = gate.shouldProcess(frame(101));
+        assert(!process);   // Below the threshold
+
+        // Drift accumulates against the last processed frame
+        process = gate.shouldProcess(frame(103));
+        assert(process);
+
+        // Invalidate forces the next pass
+        gate.invalidate();
+        process = gate.shouldProcess(frame(103));
+        assert(process);
+
+        std::cout << "✅ Static frame test passed" << std::endl;
+    }
+
+    static void test_changed_frame_processed() {
+        std::cout << "Testing changed frames are processed..." << std::endl;
+
+        ChangeGate gate(enabledConfig());
+        bool process = gate.shouldProcess(frame(50));
+        assert(process);
+        process = gate.shouldProcess(frame(200));
+        assert(process);
+        assert(gate.getStats().last_score >= 2.0);
+        process = gate.shouldProcess(frame(200));
+        assert(!process);
+        process = gate.shouldProcess(frame(50));
+        assert(process);
+
+        // Disabled gate processes everything and counts nothing
+        ChangeGate disabled;
+        process = disabled.shouldProcess(frame(50));
+        assert(process);
+        process = disabled.shouldProcess(frame(50));
+        assert(process);
+        assert(disabled.getStats().evaluated == 0);
+
+        std::cout << "✅ Changed frame test passed" << std::endl;
+    }
+
+    static void test_max_reuse_forces_refresh() {
+        std::cout << "Testing max_reuse_frames forces a refresh..." << std::endl;
+
+        ChangeGateConfig config = enabledConfig();
+        config.max_reuse_frames = 3;
+        ChangeGate gate(config);
+
+        bool process = gate.shouldProcess(frame(80));
+        assert(process);
+        for (int round = 0; round < 2; ++round) {
+            for (uint32_t i = 0; i < config.max_reuse_frames; ++i) {
+                process = gate.shouldProcess(frame(80));
+                assert(!process);
+            }
+            process = gate.shouldProcess(frame(80));
+            assert(process);   // Forced although nothing changed
+        }
+
+        std::cout << "✅ Forced refresh test passed" << std::endl;
+    }
+
+    static void test_skip_ratio_stats() {
+        std::cout << "Testing skip ratio statistics..." << std::endl;
+
+        ChangeGate gate(enabledConfig());
+        assert(gate.getStats().skipRatio() == 0.0);
+
+        // 1 processed, 3 reused
+        for (int i = 0; i < 4; ++i) {
+            gate.shouldProcess(frame(120));
+        }
+        ChangeGateStats stats = gate.getStats();
+        assert(stats.evaluated == 4);
+        assert(stats.processed == 1);
+        assert(stats.reused == 3);
+        assert(stats.skipRatio() == 0.75);
+        assert(stats.toJson().find("\"skip_ratio\":0.7500") != std::string::npos);
+
+        gate.resetStats();
+        stats = gate.getStats();
+        assert(stats.evaluated == 0 && stats.processed == 0 && stats.reused == 0);
+        assert(stats.skipRatio() == 0.0);
+
+        // The reference survives a stats reset
+        bool process = gate.shouldProcess(frame(120));
+        assert(!process);
+
+        std::cout << "✅ Skip ratio test passed" << std::endl;
+    }
+
+    static void test_skipped_frame_reuses_result() {
+        std::cout << "Testing skipped frames republish the previous result..." << std::endl;
+
+        StreamOptions options;
+        options.change_gate = enabledConfig();
+        VideoStream stream("gate", CaptureConfig(), options);
+
+        // Nothing published yet: even a repeated frame goes to inference
+        StreamResult result;
+        bool has_result = stream.getLastResult(result);
+        assert(!has_result);
+        bool process = stream.gateFrame(frame(60), metadata(1));
+        assert(process);
+        process = stream.gateFrame(frame(60), metadata(2));
+        assert(process);
+        assert(stream.getMetricsJson().find("\"last_result\":null") != std::string::npos);
+
+        InferenceResult inference;
+        inference.top_index = 7;
+        inference.top_score = 0.9f;
+        inference.num_scores = 10;
+        FrameMetadata processed = metadata(2);
+        stream.publishResult(processed, inference);
+
+        FrameMetadata skipped = metadata(3);
+        process = stream.gateFrame(frame(60), skipped);
+        assert(!process);
+        has_result = stream.getLastResult(result);
+        assert(has_result);
+        assert(result.reused);
+        assert(result.sequence == 3);
+        assert(result.source_sequence == 2);
+        assert(result.capture_time == skipped.capture_time);
+        assert(result.inference.top_index == 7 && result.inference.top_score == 0.9f);
+        assert(!result.pipeline);
+        assert(stream.getMetricsJson().find("\"source_sequence\":2") != std::string::npos);
+
+        // A change runs inference again; the new result replaces the old one
+        process = stream.gateFrame(frame(200), metadata(4));
+        assert(process);
+        inference.top_index = 3;
+        stream.publishResult(metadata(4), inference);
+        has_result = stream.getLastResult(result);
+        assert(has_result);
+        assert(!result.reused && result.sequence == 4 && result.source_sequence == 4);
+        assert(result.inference.top_index == 3);
+
+        // Pipeline results are reused the same way
+        auto pipeline = std::make_shared<PipelineResult>();
+        pipeline->latency_ms = 1.5;
+        stream.publishResult(metadata(5), InferenceResult(), pipeline);
+        process = stream.gateFrame(frame(200), metadata(6));
+        assert(!process);
+        has_result = stream.getLastResult(result);
+        assert(has_result);
+        assert(result.reused && result.sequence == 6 && result.source_sequence == 5);
+        assert(result.pipeline == pipeline);
+        assert(result.toJson().find("\"pipeline\":") != std::string::npos);
+
+        std::cout << "✅ Result reuse test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Change Gate Unit Tests" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    ChangeGateTest::test_static_frame_skipped();
+    ChangeGateTest::test_changed_frame_processed();
+    ChangeGateTest::test_max_reuse_forces_refresh();
+    ChangeGateTest::test_skip_ratio_stats();
+    ChangeGateTest::test_skipped_frame_reuses_result();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All change gate unit tests passed!" << std::endl;
+    return 0;
+}
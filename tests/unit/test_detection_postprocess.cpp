@@ -0,0 +1,244 @@
+/**
+ * @file test_detection_postprocess.cpp
+ * @brief Unit tests for the vectorized detection decoder and NMS
+ */
+
+#include "detection_postprocess.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+class DetectionPostprocessTest {
+public:
+    /**
+     * @brief Textbook greedy NMS with a division per pair
+     */
+    static std::vector<uint32_t> referenceNms(const DetectionBoxes& boxes, float iou_threshold, size_t max_detections,
+                                              bool class_aware) {
+        std::vector<uint32_t> keep;
+        std::vector<bool> removed(boxes.size(), false);
+        for (size_t i = 0; i < boxes.size() && keep.size() < max_detections; ++i) {
+            if (removed[i]) continue;
+            keep.push_back(static_cast<uint32_t>(i));
+            for (size_t j = i + 1; j < boxes.size(); ++j) {
+                if (class_aware && boxes.class_id[i] != boxes.class_id[j]) continue;
+                float w = std::max(0.0f, std::min(boxes.x2[i], boxes.x2[j]) - std::max(boxes.x1[i], boxes.x1[j]));
+                float h = std::max(0.0f, std::min(boxes.y2[i], boxes.y2[j]) - std::max(boxes.y1[i], boxes.y1[j]));
+                float inter = w * h;
+                if (inter / (boxes.area[i] + boxes.area[j] - inter) > iou_threshold) {
+                    removed[j] = true;
+                }
+            }
+        }
+        return keep;
+    }
+
+    static void test_compaction_and_best_class() {
+        std::cout << "Testing compaction and best class on every path..." << std::endl;
+
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        DetectionPostprocessor postprocessor;
+
+        // Vector tails on both sides of every lane width
+        for (size_t count : {0, 1, 7, 8, 9, 15, 16, 17, 33, 100, 1000, 100003}) {
+            std::vector<float> scores(count);
+            for (float& score : scores) score = unit(rng);
+
+            std::vector<uint32_t> expected;
+            for (size_t i = 0; i < count; ++i) {
+                if (scores[i] > 0.7f) expected.push_back(static_cast<uint32_t>(i));
+            }
+
+            // Scores on a 1/8 grid so several classes tie; the lowest class must win
+            const size_t classes = 13;
+            std::vector<float> class_scores(classes * count);
+            for (float& score : class_scores) score = std::round(unit(rng) * 8) / 8;
+            std::vector<float> expected_best(count);
+            std::vector<int32_t> expected_class(count);
+            for (size_t i = 0; i < count; ++i) {
+                expected_best[i] = class_scores[i];
+                for (size_t c = 1; c < classes; ++c) {
+                    if (class_scores[c * count + i] > expected_best[i]) {
+                        expected_best[i] = class_scores[c * count + i];
+                        expected_class[i] = static_cast<int32_t>(c);
+                    }
+                }
+            }
+
+            for (SimdPath path : availableSimdPaths()) {
+                bool selected = postprocessor.setPath(path);
+                assert(selected);
+                std::vector<uint32_t> indices(count);
+                indices.resize(postprocessor.compactAbove(scores.data(), count, 0.7f, indices.data()));
+                assert(indices == expected);
+
+                std::vector<float> best(count);
+                std::vector<int32_t> best_class(count);
+                postprocessor.bestClass(class_scores.data(), classes, count, best.data(), best_class.data());
+                assert(best == expected_best);
+                assert(best_class == expected_class);
+            }
+        }
+
+        std::cout << "✅ Compaction and best class test passed" << std::endl;
+    }
+
+    static void test_select_top_k() {
+        std::cout << "Testing top-k selection..." << std::endl;
+
+        const std::vector<float> scores = {0.1f, 0.9f, 0.5f, 0.9f, 0.3f, 0.7f};
+        std::vector<uint32_t> indices = {0, 1, 2, 3, 4, 5};
+        DetectionPostprocessor::selectTopK(indices, scores.data(), 3);
+        // Equal scores keep index order
+        assert((indices == std::vector<uint32_t>{1, 3, 5}));
+
+        indices = {5, 4, 3, 2, 1, 0};
+        DetectionPostprocessor::selectTopK(indices, scores.data(), 0);
+        assert((indices == std::vector<uint32_t>{1, 3, 5, 2, 4, 0}));
+
+        indices = {4, 2};
+        DetectionPostprocessor::selectTopK(indices, scores.data(), 10);
+        assert((indices == std::vector<uint32_t>{2, 4}));
+
+        std::cout << "✅ Top-k test passed" << std::endl;
+    }
+
+    static void test_nms_matches_reference() {
+        std::cout << "Testing NMS against the reference on every path..." << std::endl;
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        DetectionPostprocessor postprocessor;
+
+        for (int trial = 0; trial < 20; ++trial) {
+            const size_t count = 1 + rng() % 3000;
+            std::vector<std::tuple<float, float, float, float, float, int>> candidates;
+            for (size_t i = 0; i < count; ++i) {
+                float cx = unit(rng) * 600, cy = unit(rng) * 600;
+                float w = 10 + unit(rng) * 100, h = 10 + unit(rng) * 100;
+                candidates.emplace_back(unit(rng), cx - w / 2, cy - h / 2, cx + w / 2, cy + h / 2,
+                                        static_cast<int>(rng() % 4));
+            }
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const auto& a, const auto& b) { return std::get<0>(a) > std::get<0>(b); });
+            DetectionBoxes boxes;
+            for (const auto& c : candidates) {
+                boxes.push(std::get<1>(c), std::get<2>(c), std::get<3>(c), std::get<4>(c), std::get<0>(c), std::get<5>(c));
+            }
+
+            for (bool class_aware : {true, false}) {
+                for (size_t max_detections : {static_cast<size_t>(5), static_cast<size_t>(300)}) {
+                    std::vector<uint32_t> expected = referenceNms(boxes, 0.45f, max_detections, class_aware);
+                    for (SimdPath path : availableSimdPaths()) {
+                        bool selected = postprocessor.setPath(path);
+                        assert(selected);
+                        std::vector<uint32_t> keep;
+                        postprocessor.nms(boxes, 0.45f, max_detections, class_aware, keep);
+                        assert(keep == expected);
+                    }
+                }
+            }
+        }
+
+        std::cout << "✅ NMS test passed" << std::endl;
+    }
+
+    /**
+     * @brief [2, 4 + 3 classes, 6 candidates]; batch slot 1 holds the boxes, slot 0 is empty
+     */
+    static cv::Mat makeYoloOutput(std::vector<float>& storage) {
+        const int classes = 3, count = 6, rows = 4 + classes;
+        storage.assign(2 * rows * count, 0.0f);
+        float* slot = storage.data() + rows * count;
+        auto set = [&](int i, float cx, float cy, float w, float h, int cls, float score) {
+            slot[i] = cx;
+            slot[count + i] = cy;
+            slot[2 * count + i] = w;
+            slot[3 * count + i] = h;
+            slot[(4 + cls) * count + i] = score;
+        };
+        set(0, 100, 100, 50, 50, 0, 0.9f);
+        set(1, 102, 101, 50, 50, 0, 0.8f);   // Suppressed by 0
+        set(2, 102, 101, 50, 50, 1, 0.7f);   // Same place, other class
+        set(3, 600, 600, 100, 100, 2, 0.3f);
+        set(4, 300, 300, 20, 20, 2, 0.1f);   // Below the threshold
+        set(5, 639, 10, 40, 40, 1, 0.6f);    // Clipped at the right edge
+        int sizes[3] = {2, rows, count};
+        return cv::Mat(3, sizes, CV_32F, storage.data());
+    }
+
+    static void test_decode_yolo() {
+        std::cout << "Testing YOLO decoding..." << std::endl;
+
+        std::vector<float> storage;
+        cv::Mat output = makeYoloOutput(storage);
+        const cv::Size image_size(1280, 1280);   // 2x the 640x640 network input
+        PostprocessConfig config;
+        DetectionPostprocessor postprocessor;
+
+        for (SimdPath path : availableSimdPaths()) {
+            bool selected = postprocessor.setPath(path);
+            assert(selected);
+            std::vector<PipelineRegion> detections;
+            bool decoded = postprocessor.decodeYolo(output, 1, config, image_size, detections);
+            assert(decoded);
+            assert(detections.size() == 4);
+            assert(detections[0].class_id == 0 && detections[0].box == cv::Rect(150, 150, 100, 100));
+            assert(detections[1].class_id == 1 && detections[1].box == cv::Rect(154, 152, 100, 100));
+            assert(detections[2].class_id == 1 && detections[2].box == cv::Rect(1238, 0, 42, 60));
+            assert(detections[3].class_id == 2 && detections[3].box == cv::Rect(1100, 1100, 180, 180));
+            assert(std::fabs(detections[0].score - 0.9f) < 1e-6f);
+        }
+
+        std::vector<PipelineRegion> detections;
+        bool decoded = postprocessor.decodeYolo(output, 0, config, image_size, detections);
+        assert(decoded);
+        assert(detections.empty());
+
+        config.class_aware = false;
+        decoded = postprocessor.decodeYolo(output, 1, config, image_size, detections);
+        assert(decoded);
+        assert(detections.size() == 3);
+
+        config.max_detections = 1;
+        decoded = postprocessor.decodeYolo(output, 1, config, image_size, detections);
+        assert(decoded);
+        assert(detections.size() == 1 && detections[0].class_id == 0);
+
+        decoded = postprocessor.decodeYolo(output, 2, config, image_size, detections);
+        assert(!decoded);
+        decoded = postprocessor.decodeYolo(cv::Mat(10, 10, CV_32F), 0, config, image_size, detections);
+        assert(!decoded);
+
+        // Through the pipeline decoder interface
+        RegionDecoder decoder = DetectionPostprocessor::yoloDecoder(PostprocessConfig());
+        std::vector<PipelineRegion> regions = decoder({output}, 1, image_size);
+        assert(regions.size() == 4);
+        assert(decoder({}, 0, image_size).empty());
+
+        std::cout << "✅ YOLO decoding test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Detection Postprocess Unit Tests" << std::endl;
+    std::cout << "===========================================" << std::endl;
+
+    std::cout << "Paths on this CPU:";
+    for (SimdPath path : availableSimdPaths()) {
+        std::cout << " " << simdPathToString(path);
+    }
+    std::cout << std::endl;
+
+    DetectionPostprocessTest::test_compaction_and_best_class();
+    DetectionPostprocessTest::test_select_top_k();
+    DetectionPostprocessTest::test_nms_matches_reference();
+    DetectionPostprocessTest::test_decode_yolo();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All detection postprocess unit tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file test_frame_pool.cpp
+ * @brief Unit tests for the preallocated frame pool
+ */
+
+#include "frame_pool.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+class FramePoolTest {
+public:
+    static void test_recycles_released_buffers() {
+        std::cout << "Testing released buffers are recycled..." << std::endl;
+
+        FramePool pool(cv::Size(64, 48), CV_8UC3);
+        PooledFrame frame = pool.acquire();
+        const uchar* data = frame.mat().data;
+        FramePoolStats stats = pool.getStats();
+        assert(stats.hits == 0 && stats.misses == 1 && stats.buffers == 1);
+
+        frame.reset();
+        frame = pool.acquire();
+        assert(frame.mat().data == data);
+        stats = pool.getStats();
+        assert(stats.hits == 1 && stats.misses == 1 && stats.buffers == 1);
+
+        // Preallocated buffers are hits from the first acquire
+        FramePool preallocated(cv::Size(64, 48), CV_8UC3, 2);
+        PooledFrame a = preallocated.acquire();
+        PooledFrame b = preallocated.acquire();
+        assert(a.mat().data != b.mat().data);
+        PooledFrame c = preallocated.acquire();
+        stats = preallocated.getStats();
+        assert(stats.hits == 2 && stats.misses == 1 && stats.buffers == 3);
+
+        // A holder that reallocated the Mat is detached; the header is rebuilt on the next acquire
+        PooledFrame detached = pool.acquire();
+        detached.mat().create(10, 10, CV_8UC1);
+        assert(!detached.isPooled());
+        detached.reset();
+        frame.reset();
+        frame = pool.acquire();
+        assert(frame.isPooled() && frame.mat().size() == cv::Size(64, 48) && frame.mat().type() == CV_8UC3);
+
+        std::cout << "✅ Recycling test passed" << std::endl;
+    }
+
+    static void test_refcount() {
+        std::cout << "Testing refcounts across copies and moves..." << std::endl;
+
+        FramePool pool(cv::Size(32, 32), CV_8UC1);
+        PooledFrame first = pool.acquire();
+        assert(first.useCount() == 1);
+        const uchar* data = first.mat().data;
+
+        PooledFrame copy = first;
+        assert(first.useCount() == 2 && copy.mat().data == data);
+
+        PooledFrame moved = std::move(copy);
+        assert(!copy && copy.useCount() == 0);
+        assert(moved.useCount() == 2 && moved.mat().data == data);
+
+        PooledFrame assigned;
+        assigned = moved;
+        assert(first.useCount() == 3);
+
+        // The buffer stays out of the pool until the last holder lets go
+        first.reset();
+        moved.reset();
+        assert(pool.getStats().in_use == 1);
+        assert(assigned.useCount() == 1);
+        assigned.reset();
+        assert(pool.getStats().in_use == 0);
+
+        PooledFrame again = pool.acquire();
+        assert(again.mat().data == data && pool.getStats().hits == 1);
+
+        std::cout << "✅ Refcount test passed" << std::endl;
+    }
+
+    static void test_alignment() {
+        std::cout << "Testing 64-byte buffer alignment..." << std::endl;
+
+        // Odd row sizes too: every buffer starts on a cache line, not just the first
+        for (const cv::Size& size : {cv::Size(640, 480), cv::Size(33, 7), cv::Size(1, 1)}) {
+            FramePool pool(size, CV_8UC3, 3);
+            std::vector<PooledFrame> frames;
+            for (int i = 0; i < 5; ++i) {
+                frames.push_back(pool.acquire());
+                assert(reinterpret_cast<uintptr_t>(frames.back().mat().data) % 64 == 0);
+                assert(frames.back().isPooled());
+                assert(frames.back().mat().size() == size && frames.back().mat().type() == CV_8UC3);
+            }
+        }
+
+        std::cout << "✅ Alignment test passed" << std::endl;
+    }
+
+    static void test_reconfigure() {
+        std::cout << "Testing reconfigure drops old-generation buffers..." << std::endl;
+
+        const cv::Size small(64, 48), large(128, 96);
+        FramePool pool(small, CV_8UC3, 2);
+        PooledFrame held = pool.acquire();
+
+        // The free buffer is replaced at the new geometry; the held one survives until released
+        pool.reconfigure(large, CV_8UC3);
+        assert(pool.getSize() == large && pool.getType() == CV_8UC3);
+        FramePoolStats stats = pool.getStats();
+        assert(stats.buffers == 2 && stats.in_use == 1);
+        assert(stats.bytes_resident == 64 * 48 * 3 + 128 * 96 * 3);
+        assert(held.mat().size() == small);
+
+        PooledFrame fresh = pool.acquire();
+        assert(fresh.mat().size() == large && pool.getStats().hits == 2);
+
+        held.reset();
+        stats = pool.getStats();
+        assert(stats.buffers == 1 && stats.in_use == 1);
+        assert(stats.bytes_resident == 128 * 96 * 3);
+
+        // Released old-generation buffers never come back
+        fresh.reset();
+        for (int i = 0; i < 3; ++i) {
+            PooledFrame frame = pool.acquire();
+            assert(frame.mat().size() == large);
+        }
+
+        // Same geometry: nothing changes
+        stats = pool.getStats();
+        pool.reconfigure(large, CV_8UC3);
+        assert(pool.getStats().buffers == stats.buffers && pool.getStats().misses == stats.misses);
+
+        std::cout << "✅ Reconfigure test passed" << std::endl;
+    }
+
+    static void test_stats() {
+        std::cout << "Testing stats accounting..." << std::endl;
+
+        const size_t frame_bytes = 320 * 240 * 3;
+        FramePool pool(cv::Size(320, 240), CV_8UC3, 1);
+        FramePoolStats stats = pool.getStats();
+        assert(stats.buffers == 1 && stats.in_use == 0 && stats.bytes_resident == frame_bytes);
+
+        std::vector<PooledFrame> frames;
+        for (int i = 0; i < 4; ++i) {
+            frames.push_back(pool.acquire());
+        }
+        stats = pool.getStats();
+        assert(stats.hits == 1 && stats.misses == 3);
+        assert(stats.buffers == 4 && stats.in_use == 4 && stats.bytes_resident == 4 * frame_bytes);
+
+        frames.clear();
+        stats = pool.getStats();
+        assert(stats.buffers == 4 && stats.in_use == 0 && stats.bytes_resident == 4 * frame_bytes);
+
+        std::string json = stats.toJson();
+        assert(json.find("\"hits\":1") != std::string::npos);
+        assert(json.find("\"misses\":3") != std::string::npos);
+        assert(json.find("\"bytes_resident\":" + std::to_string(4 * frame_bytes)) != std::string::npos);
+
+        std::cout << "✅ Stats test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Frame Pool Unit Tests" << std::endl;
+    std::cout << "================================" << std::endl;
+
+    FramePoolTest::test_recycles_released_buffers();
+    FramePoolTest::test_refcount();
+    FramePoolTest::test_alignment();
+    FramePoolTest::test_reconfigure();
+    FramePoolTest::test_stats();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All frame pool unit tests passed!" << std::endl;
+    return 0;
+}
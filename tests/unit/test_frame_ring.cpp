@@ -0,0 +1,170 @@
+/**
+ * @file test_frame_ring.cpp
+ * @brief Unit tests for the bounded frame ring
+ */
+
+#include "frame_ring.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+class FrameRingTest {
+public:
+    static void test_fifo_order() {
+        std::cout << "Testing FIFO order..." << std::endl;
+
+        FrameRing<int> ring(4, OverflowPolicy::DROP_OLDEST);
+        bool pushed = ring.push(1);
+        assert(pushed);
+        pushed = ring.push(2);
+        assert(pushed);
+        pushed = ring.push(3);
+        assert(pushed);
+        assert(ring.size() == 3);
+
+        int value = 0;
+        bool popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 1);
+        popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 2);
+        popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 3);
+        popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(!popped);
+
+        std::cout << "✅ FIFO order test passed" << std::endl;
+    }
+
+    static void test_drop_oldest() {
+        std::cout << "Testing drop-oldest overflow policy..." << std::endl;
+
+        FrameRing<int> ring(2, OverflowPolicy::DROP_OLDEST);
+        bool pushed = ring.push(1);
+        assert(pushed);
+        pushed = ring.push(2);
+        assert(pushed);
+        pushed = ring.push(3); // Evicts 1
+        assert(pushed);
+
+        int value = 0;
+        bool popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 2);
+        popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 3);
+        assert(ring.getDroppedCount() == 1);
+
+        std::cout << "✅ Drop-oldest test passed" << std::endl;
+    }
+
+    static void test_drop_newest() {
+        std::cout << "Testing drop-newest overflow policy..." << std::endl;
+
+        FrameRing<int> ring(2, OverflowPolicy::DROP_NEWEST);
+        bool pushed = ring.push(1);
+        assert(pushed);
+        pushed = ring.push(2);
+        assert(pushed);
+        pushed = ring.push(3); // Rejected
+        assert(!pushed);
+
+        int value = 0;
+        bool popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 1);
+        popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 2);
+        assert(ring.getDroppedCount() == 1);
+
+        std::cout << "✅ Drop-newest test passed" << std::endl;
+    }
+
+    static void test_block() {
+        std::cout << "Testing blocking overflow policy..." << std::endl;
+
+        FrameRing<int> ring(1, OverflowPolicy::BLOCK);
+        bool pushed = ring.push(1);
+        assert(pushed);
+
+        std::thread producer([&ring] {
+            ring.push(2); // Blocks until the consumer pops
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        assert(ring.size() == 1);
+
+        int value = 0;
+        bool popped = ring.pop(value, std::chrono::milliseconds(100));
+        assert(popped && value == 1);
+        popped = ring.pop(value, std::chrono::milliseconds(1000));
+        assert(popped && value == 2);
+        producer.join();
+        assert(ring.getDroppedCount() == 0);
+
+        std::cout << "✅ Blocking policy test passed" << std::endl;
+    }
+
+    static void test_pop_latest() {
+        std::cout << "Testing freshest-frame pop..." << std::endl;
+
+        FrameRing<int> ring(4, OverflowPolicy::DROP_OLDEST);
+        ring.push(1);
+        ring.push(2);
+        ring.push(3);
+
+        int value = 0;
+        bool popped = ring.popLatest(value);
+        assert(popped && value == 3);
+        assert(ring.size() == 0);
+        assert(ring.getDroppedCount() == 2);
+        popped = ring.popLatest(value);
+        assert(!popped);
+
+        std::cout << "✅ Freshest-frame pop test passed" << std::endl;
+    }
+
+    static void test_close() {
+        std::cout << "Testing close and drain..." << std::endl;
+
+        FrameRing<int> ring(2, OverflowPolicy::BLOCK);
+        ring.push(1);
+        ring.close();
+
+        bool pushed = ring.push(2);
+        assert(!pushed);
+        assert(!ring.isFinished());
+
+        int value = 0;
+        bool popped = ring.pop(value, std::chrono::milliseconds(0));
+        assert(popped && value == 1);
+        assert(ring.isFinished());
+
+        // A closed, empty ring must not wait out the timeout
+        auto start = std::chrono::steady_clock::now();
+        popped = ring.popLatest(value, std::chrono::milliseconds(1000));
+        assert(!popped);
+        assert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500));
+
+        ring.reset();
+        assert(!ring.isClosed());
+        pushed = ring.push(3);
+        assert(pushed);
+
+        std::cout << "✅ Close and drain test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Frame Ring Unit Tests" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    FrameRingTest::test_fifo_order();
+    FrameRingTest::test_drop_oldest();
+    FrameRingTest::test_drop_newest();
+    FrameRingTest::test_block();
+    FrameRingTest::test_pop_latest();
+    FrameRingTest::test_close();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All frame ring unit tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_frame_source.cpp
+ * @brief Unit tests for frame source URI parsing and the non-camera sources
+ */
+
+#include "frame_source.hpp"
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+class FrameSourceTest {
+public:
+    template <typename Source>
+    static bool isA(const std::unique_ptr<FrameSource>& source) {
+        return source && dynamic_cast<Source*>(source.get()) != nullptr;
+    }
+
+    static void test_create_parses_uris() {
+        std::cout << "Testing FrameSource::create() URI parsing..." << std::endl;
+
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "test_frame_source_uri";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        std::filesystem::path video = dir / "clip.mp4";
+        std::ofstream(video) << "not a real video";
+
+        FrameSourceOptions options;
+
+        // Cameras: bare number or camera:<id>; opening is never attempted here
+        auto bare = FrameSource::create("0", options);
+        assert(isA<CameraSource>(bare) && bare->describe() == "camera:0" && bare->isLive());
+        auto camera = FrameSource::create("camera:1", options);
+        assert(isA<CameraSource>(camera) && camera->describe() == "camera:1");
+        assert(!FrameSource::create("camera:front", options));
+
+        // synthetic:<w>x<h>[@<fps>] overrides the options' geometry and rate
+        auto synthetic = FrameSource::create("synthetic:320x240", options);
+        assert(isA<SyntheticSource>(synthetic));
+        assert(synthetic->getOptions().width == 320 && synthetic->getOptions().height == 240);
+        assert(synthetic->getOptions().fps == options.fps);
+        auto paced = FrameSource::create("synthetic:64x48@15", options);
+        assert(isA<SyntheticSource>(paced) && paced->getOptions().fps == 15.0);
+        assert(isA<SyntheticSource>(FrameSource::create("synthetic:", options)));
+        assert(!FrameSource::create("synthetic:axb", options));
+
+        // Explicit schemes, then bare paths resolved by what exists on disk
+        auto listed = FrameSource::create("dir:" + dir.string(), options);
+        assert(isA<ImageDirectorySource>(listed) && listed->describe() == "dir:" + dir.string());
+        assert(isA<ImageDirectorySource>(FrameSource::create(dir.string(), options)));
+        auto file = FrameSource::create(video.string(), options);
+        assert(isA<VideoFileSource>(file) && file->describe() == "file:" + video.string());
+        assert(isA<VideoFileSource>(FrameSource::create("file:" + video.string(), options)));
+
+        // Non-ASCII names are paths, not camera ids
+        auto unicode = FrameSource::create("视频.mp4", options);
+        assert(isA<VideoFileSource>(unicode));
+
+        assert(!FrameSource::create("rtsp://camera.local/stream", options));
+
+        std::filesystem::remove_all(dir);
+        std::cout << "✅ URI parsing test passed" << std::endl;
+    }
+
+    static void test_synthetic_source() {
+        std::cout << "Testing the synthetic source..." << std::endl;
+
+        FrameSourceOptions options;
+        options.width = 160;
+        options.height = 120;
+        options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+        options.max_frames = 3;
+        SyntheticSource source(options);
+        assert(!source.isOpened());
+        bool opened = source.open();
+        assert(opened && source.isOpened());
+        assert(source.getFrameSize() == cv::Size(160, 120));
+        assert(source.describe() == "synthetic:160x120");
+
+        cv::Mat first, second;
+        bool has_frame = source.read(first);
+        assert(has_frame);
+        has_frame = source.read(second);
+        assert(has_frame);
+        assert(first.size() == cv::Size(160, 120) && first.type() == CV_8UC3);
+        assert(cv::norm(first, second, cv::NORM_INF) > 0);   // The block moves
+
+        // Grabbed but not retrieved still counts towards max_frames
+        bool grabbed = source.grab();
+        assert(grabbed);
+        assert(source.getFramesGrabbed() == 3);
+        assert(!source.isExhausted());
+        has_frame = source.read(first);
+        assert(!has_frame);
+        assert(source.isExhausted());
+
+        FrameSourceOptions empty;
+        empty.width = 0;
+        opened = SyntheticSource(empty).open();
+        assert(!opened);
+
+        std::cout << "✅ Synthetic source test passed" << std::endl;
+    }
+
+    static void test_image_directory_source() {
+        std::cout << "Testing the image directory source..." << std::endl;
+
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "test_frame_source_images";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        // Sorted by name; the third image has another size and is resized to the first
+        cv::imwrite((dir / "a.png").string(), cv::Mat(48, 64, CV_8UC3, cv::Scalar(10, 10, 10)));
+        cv::imwrite((dir / "b.png").string(), cv::Mat(48, 64, CV_8UC3, cv::Scalar(20, 20, 20)));
+        cv::imwrite((dir / "c.png").string(), cv::Mat(24, 32, CV_8UC3, cv::Scalar(30, 30, 30)));
+        std::ofstream(dir / "notes.txt") << "ignored";
+
+        FrameSourceOptions options;
+        options.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+        options.prefetch_depth = 2;
+        {
+            ImageDirectorySource source(dir.string(), options);
+            bool opened = source.open();
+            assert(opened && source.isOpened());
+            assert(source.getFrameSize() == cv::Size(64, 48));
+
+            cv::Mat frame;
+            bool has_frame = false;
+            for (int expected : {10, 20, 30}) {
+                has_frame = source.read(frame);
+                assert(has_frame);
+                assert(frame.size() == cv::Size(64, 48));
+                assert(frame.ptr<uchar>(0)[0] == expected);
+            }
+            // End of stream without loop
+            has_frame = source.read(frame);
+            assert(!has_frame);
+            assert(source.isExhausted());
+            assert(source.getFramesGrabbed() == 3);
+            source.close();
+            assert(!source.isOpened());
+        }
+        {
+            options.loop = true;
+            ImageDirectorySource source(dir.string(), options);
+            bool opened = source.open();
+            assert(opened);
+            cv::Mat frame;
+            for (int i = 0; i < 7; ++i) {
+                bool has_frame = source.read(frame);
+                assert(has_frame);
+                assert(frame.ptr<uchar>(0)[0] == 10 * (i % 3 + 1));
+            }
+            assert(!source.isExhausted());
+        }
+
+        // No images: open fails
+        std::filesystem::path empty = dir / "empty";
+        std::filesystem::create_directories(empty);
+        ImageDirectorySource nothing(empty.string(), options);
+        bool opened = nothing.open();
+        assert(!opened);
+
+        std::filesystem::remove_all(dir);
+        std::cout << "✅ Image directory source test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Frame Source Unit Tests" << std::endl;
+    std::cout << "==================================" << std::endl;
+
+    FrameSourceTest::test_create_parses_uris();
+    FrameSourceTest::test_synthetic_source();
+    FrameSourceTest::test_image_directory_source();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All frame source unit tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file test_fused_preprocess.cpp
+ * @brief Unit tests for the fused resize/colour/normalize/planar preprocessing kernel
+ */
+
+#include "fused_preprocess.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+class FusedPreprocessTest {
+public:
+    static cv::Mat randomImage(int width, int height) {
+        cv::Mat image(height, width, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+        return image;
+    }
+
+    /**
+     * @brief The unfused chain: colour swap, resize, convert, normalize, split into planes
+     */
+    static std::vector<float> referenceChain(const cv::Mat& image, const cv::Size& size, double scale,
+                                             const cv::Scalar& mean, bool swap_rb) {
+        cv::Mat rgb, resized, converted;
+        if (swap_rb) {
+            cv::cvtColor(image, rgb, cv::COLOR_BGR2RGB);
+        } else {
+            rgb = image;
+        }
+        cv::resize(rgb, resized, size, 0, 0, cv::INTER_LINEAR);
+        resized.convertTo(converted, CV_32F);
+        converted = (converted - mean) * scale;
+
+        std::vector<float> tensor(3 * static_cast<size_t>(size.area()));
+        std::vector<cv::Mat> planes;
+        for (int c = 0; c < 3; ++c) {
+            planes.emplace_back(size.height, size.width, CV_32F, tensor.data() + c * static_cast<size_t>(size.area()));
+        }
+        cv::split(converted, planes);
+        return tensor;
+    }
+
+    static double maxDifference(const std::vector<float>& a, const float* b) {
+        double worst = 0.0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            worst = std::max(worst, static_cast<double>(std::fabs(a[i] - b[i])));
+        }
+        return worst;
+    }
+
+    static void test_matches_opencv_chain() {
+        std::cout << "Testing every path against the unfused OpenCV chain..." << std::endl;
+
+        const double scale = 1.0 / 255.0;
+        const cv::Scalar mean(10, 20, 30);
+        // Downscale, upscale, odd sizes (vector tails), exact 2x, a single pixel
+        const std::vector<std::pair<cv::Size, cv::Size>> cases = {
+            {{1920, 1080}, {224, 224}}, {{640, 480}, {640, 640}}, {{100, 50}, {227, 131}},
+            {{640, 480}, {320, 240}}, {{37, 23}, {17, 9}}, {{1, 1}, {5, 3}},
+        };
+
+        for (const auto& test_case : cases) {
+            cv::Mat image = randomImage(test_case.first.width, test_case.first.height);
+            const cv::Size& size = test_case.second;
+            for (bool swap_rb : {true, false}) {
+                std::vector<float> expected = referenceChain(image, size, scale, mean, swap_rb);
+                FusedPreprocessor preprocessor(size, scale, mean, swap_rb);
+                for (SimdPath path : FusedPreprocessor::availablePaths()) {
+                    bool selected = preprocessor.setPath(path);
+                    assert(selected);
+                    std::vector<float> tensor(expected.size());
+                    bool ran = preprocessor.run(image, tensor.data());
+                    assert(ran);
+                    // OpenCV interpolates 8-bit images in fixed point: within one pixel level
+                    double difference = maxDifference(expected, tensor.data());
+                    if (difference > scale * 1.01) {
+                        std::cerr << simdPathToString(path) << " " << test_case.first.width << "x" << test_case.first.height
+                                  << " -> " << size.width << "x" << size.height << ": " << difference << std::endl;
+                    }
+                    assert(difference <= scale * 1.01);
+                }
+            }
+        }
+
+        // Same tensor layout as the blob the OpenCV DNN backend used to build
+        cv::Mat image = randomImage(1280, 720);
+        cv::Mat blob = cv::dnn::blobFromImage(image, scale, cv::Size(300, 300), mean, true, false, CV_32F);
+        FusedPreprocessor preprocessor(cv::Size(300, 300), scale, mean, true);
+        std::vector<float> tensor(3 * 300 * 300);
+        bool ran = preprocessor.run(image, tensor.data());
+        assert(ran);
+        std::vector<float> expected(blob.ptr<float>(), blob.ptr<float>() + tensor.size());
+        assert(maxDifference(expected, tensor.data()) <= scale * 1.01);
+
+        std::cout << "✅ OpenCV chain test passed" << std::endl;
+    }
+
+    static void test_paths_agree_and_int8() {
+        std::cout << "Testing SIMD paths agree with scalar and int8 output..." << std::endl;
+
+        cv::Mat image = randomImage(1920, 1080);
+        const cv::Size size(227, 131);
+        FusedPreprocessor preprocessor(size, 1.0 / 255.0, cv::Scalar(124, 116, 104), true);
+        const size_t values = 3 * static_cast<size_t>(size.area());
+        Int8Quantization quantization;
+        quantization.scale = 1.0f / 64.0f;
+        quantization.zero_point = -3;
+
+        std::vector<float> scalar(values);
+        bool selected = preprocessor.setPath(SimdPath::SCALAR);
+        assert(selected);
+        bool ran = preprocessor.run(image, scalar.data());
+        assert(ran);
+
+        for (SimdPath path : FusedPreprocessor::availablePaths()) {
+            selected = preprocessor.setPath(path);
+            assert(selected);
+            std::vector<float> tensor(values);
+            std::vector<int8_t> quantized(values);
+            ran = preprocessor.run(image, tensor.data());
+            assert(ran);
+            ran = preprocessor.run(image, quantized.data(), quantization);
+            assert(ran);
+            assert(maxDifference(scalar, tensor.data()) < 1e-5);
+
+            for (size_t i = 0; i < values; ++i) {
+                long q = std::lrint(tensor[i] / quantization.scale) + quantization.zero_point;
+                q = std::max(-128L, std::min(127L, q));
+                assert(std::abs(q - quantized[i]) <= 1);  // Rounding ties may land either side
+            }
+            std::cout << "  " << simdPathToString(path) << " ok" << std::endl;
+        }
+
+        // Values beyond the int8 range saturate
+        FusedPreprocessor saturating(cv::Size(16, 16), 1.0, cv::Scalar(), true);
+        cv::Mat white(16, 16, CV_8UC3, cv::Scalar(255, 255, 255));
+        std::vector<int8_t> quantized(3 * 16 * 16);
+        Int8Quantization unit;
+        unit.scale = 1.0f;
+        for (SimdPath path : FusedPreprocessor::availablePaths()) {
+            selected = saturating.setPath(path);
+            assert(selected);
+            ran = saturating.run(white, quantized.data(), unit);
+            assert(ran);
+            for (int8_t q : quantized) {
+                assert(q == 127);
+            }
+        }
+
+        std::cout << "✅ Path agreement test passed" << std::endl;
+    }
+
+    static void test_batch_reuses_blob() {
+        std::cout << "Testing batches reuse the blob and reject other formats..." << std::endl;
+
+        FusedPreprocessor preprocessor(cv::Size(64, 48));
+        std::vector<cv::Mat> images = {randomImage(640, 480), randomImage(320, 200)};
+        cv::Mat blob;
+        bool ran = preprocessor.runBatch(images, blob);
+        assert(ran);
+        assert(blob.dims == 4 && blob.size[0] == 2 && blob.size[1] == 3 && blob.size[2] == 48 && blob.size[3] == 64);
+        assert(blob.type() == CV_32F);
+
+        // Second image must land in the second slot
+        std::vector<float> single(3 * 64 * 48);
+        ran = preprocessor.run(images[1], single.data());
+        assert(ran);
+        assert(maxDifference(single, blob.ptr<float>() + single.size()) == 0.0);
+
+        const uchar* storage = blob.data;
+        ran = preprocessor.runBatch(images, blob);
+        assert(ran);
+        assert(blob.data == storage);
+
+        cv::Mat gray(48, 64, CV_8UC1, cv::Scalar(0));
+        ran = preprocessor.run(gray, single.data());
+        assert(!ran);
+        ran = preprocessor.runBatch({}, blob);
+        assert(!ran);
+
+        std::cout << "✅ Batch test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Fused Preprocess Unit Tests" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    std::cout << "Paths on this CPU:";
+    for (SimdPath path : FusedPreprocessor::availablePaths()) {
+        std::cout << " " << simdPathToString(path);
+    }
+    std::cout << std::endl;
+
+    FusedPreprocessTest::test_matches_opencv_chain();
+    FusedPreprocessTest::test_paths_agree_and_int8();
+    FusedPreprocessTest::test_batch_reuses_blob();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All fused preprocess unit tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file test_inference_backend.cpp
+ * @brief Unit tests for the backend registry and the reference backend
+ */
+
+#include "inference_backend.hpp"
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+
+class InferenceBackendTest {
+public:
+    static void test_registry() {
+        std::cout << "Testing backend registry..." << std::endl;
+
+        std::vector<std::string> names = InferenceBackend::getBackendNames();
+        assert(std::find(names.begin(), names.end(), "opencv_dnn") != names.end());
+        assert(std::find(names.begin(), names.end(), "reference") != names.end());
+
+        auto backend = InferenceBackend::create("reference");
+        assert(backend && backend->getName() == "reference");
+        assert(!InferenceBackend::create("no_such_backend"));
+
+        // Custom backends are selectable by name like the built-ins
+        InferenceBackend::registerBackend("custom", []() { return std::make_unique<ReferenceBackend>(); });
+        assert(InferenceBackend::create("custom") != nullptr);
+
+        std::cout << "✅ Registry test passed" << std::endl;
+    }
+
+    static void test_reference_batch() {
+        std::cout << "Testing reference backend batch run..." << std::endl;
+
+        auto backend = InferenceBackend::create("reference");
+        assert(!backend->requiresModelFile());
+        bool loaded = backend->load(ModelConfig());
+        assert(loaded && backend->isLoaded());
+
+        std::vector<int> shape = backend->getInputShape();
+        assert(shape.size() == 4 && shape[0] == 1 && shape[1] == 3);
+
+        // Dominant channel per image: blue, green, red
+        std::vector<cv::Mat> images = {
+            cv::Mat(32, 48, CV_8UC3, cv::Scalar(200, 10, 10)),
+            cv::Mat(16, 16, CV_8UC3, cv::Scalar(10, 200, 10)),
+            cv::Mat(64, 32, CV_8UC3, cv::Scalar(10, 10, 255)),
+        };
+        std::vector<cv::Mat> outputs;
+        bool ran = backend->runBatch(images, outputs);
+        assert(ran);
+        assert(outputs.size() == 1 && outputs[0].rows == 3);
+
+        std::vector<InferenceResult> results = backend->decode(outputs, images.size());
+        assert(results.size() == 3);
+        for (int i = 0; i < 3; ++i) {
+            assert(results[i].top_index == i);
+            assert(results[i].num_scores == 3);
+        }
+        assert(results[2].top_score > 0.99f);
+
+        ran = backend->runBatch({}, outputs);
+        assert(!ran);
+
+        std::cout << "✅ Reference batch test passed" << std::endl;
+    }
+
+    static void test_missing_model() {
+        std::cout << "Testing OpenCV DNN backend with a missing model..." << std::endl;
+
+        auto backend = InferenceBackend::create("opencv_dnn");
+        assert(backend->requiresModelFile());
+
+        ModelConfig config;
+        config.model_path = "does_not_exist.onnx";
+        bool loaded = backend->load(config);
+        assert(!loaded && !backend->isLoaded());
+
+        std::vector<cv::Mat> outputs;
+        bool ran = backend->runBatch({cv::Mat(8, 8, CV_8UC3)}, outputs);
+        assert(!ran);
+
+        std::cout << "✅ Missing model test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Inference Backend Unit Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    InferenceBackendTest::test_registry();
+    InferenceBackendTest::test_reference_batch();
+    InferenceBackendTest::test_missing_model();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All inference backend unit tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file test_inference_service.cpp
+ * @brief Unit tests for the inference service's asynchronous request API and lifecycle
+ */
+
+#include "inference_service.hpp"
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+/**
+ * @brief Reference backend whose batches block while the gate is held
+ */
+class SlowBackend : public ReferenceBackend {
+public:
+    std::string getName() const override {
+        return "slow";
+    }
+
+    bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) override {
+        {
+            std::unique_lock<std::mutex> lock(mutex());
+            started()++;
+            condition().notify_all();
+            condition().wait(lock, [] { return !held(); });
+        }
+        return ReferenceBackend::runBatch(images, outputs);
+    }
+
+    static void hold() {
+        std::lock_guard<std::mutex> lock(mutex());
+        held() = true;
+        started() = 0;
+    }
+
+    static void release() {
+        std::lock_guard<std::mutex> lock(mutex());
+        held() = false;
+        condition().notify_all();
+    }
+
+    /**
+     * @brief Wait until this many batches are blocked in the backend
+     */
+    static bool waitForStarted(int count, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex());
+        return condition().wait_for(lock, timeout, [count] { return started() >= count; });
+    }
+
+private:
+    static std::mutex& mutex() { static std::mutex instance; return instance; }
+    static std::condition_variable& condition() { static std::condition_variable instance; return instance; }
+    static bool& held() { static bool instance = false; return instance; }
+    static int& started() { static int instance = 0; return instance; }
+};
+
+class InferenceServiceTest {
+public:
+    static std::string encodedImage() {
+        std::vector<uchar> bytes;
+        cv::imencode(".png", cv::Mat(32, 32, CV_8UC3, cv::Scalar(0, 0, 255)), bytes);
+        return std::string(bytes.begin(), bytes.end());
+    }
+
+    static void test_in_flight_limit_rejects_without_blocking() {
+        std::cout << "Testing the in-flight limit rejects immediately..." << std::endl;
+
+        InferenceBackend::registerBackend("slow", []() { return std::make_unique<SlowBackend>(); });
+
+        InferenceService service;
+        ModelConfig model;
+        model.backend = "slow";
+        model.warmup_runs = 0;
+        service.setModelConfig(model);
+        DisplayConfig display;
+        display.headless = true;
+        service.setDisplayConfig(display);
+        service.setInferenceWorkers(2);
+        bool initialized = service.initialize();
+        assert(initialized);
+        service.setMaxInFlight(2);
+
+        std::string image = encodedImage();
+        SlowBackend::hold();
+
+        // Two requests fill the limit: one future, one callback
+        std::future<InferenceResponse> first = service.inferenceAsync(image);
+        std::promise<InferenceResponse> callback_done;
+        InferenceStatus queued = service.inferenceAsync(image, [&callback_done](const InferenceResponse& response) {
+            callback_done.set_value(response);
+        });
+        assert(queued == InferenceStatus::OK);
+        bool blocked = SlowBackend::waitForStarted(2, std::chrono::seconds(5));
+        assert(blocked);
+        assert(service.getInFlightRequests() == 2);
+
+        // The third is turned away while both are stuck in the backend; if it
+        // waited for a slot it would never return before release()
+        auto submit_start = std::chrono::steady_clock::now();
+        std::future<InferenceResponse> third = service.inferenceAsync(image);
+        std::future_status ready = third.wait_for(std::chrono::milliseconds(0));
+        assert(ready == std::future_status::ready);
+        InferenceResponse response = third.get();
+        assert(response.status == InferenceStatus::REJECTED);
+
+        bool rejected_callback_called = false;
+        InferenceStatus rejected = service.inferenceAsync(image, [&rejected_callback_called](const InferenceResponse&) {
+            rejected_callback_called = true;
+        });
+        assert(rejected == InferenceStatus::REJECTED);
+        double submit_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submit_start).count();
+        assert(service.getInFlightRequests() == 2);
+
+        // Both accepted forms complete once the backend moves again
+        SlowBackend::release();
+        ready = first.wait_for(std::chrono::seconds(5));
+        assert(ready == std::future_status::ready);
+        response = first.get();
+        assert(response.status == InferenceStatus::OK);
+        assert(response.result.top_index == 2);   // Red channel
+
+        std::future<InferenceResponse> called = callback_done.get_future();
+        ready = called.wait_for(std::chrono::seconds(5));
+        assert(ready == std::future_status::ready);
+        response = called.get();
+        assert(response.status == InferenceStatus::OK);
+        assert(!rejected_callback_called);
+        assert(service.getInFlightRequests() == 0);
+
+        // Slots are free again
+        response = service.inferenceAsync(image).get();
+        assert(response.status == InferenceStatus::OK);
+
+        service.stop();
+        std::cout << "✅ In-flight limit test passed (rejections took " << submit_ms << "ms)" << std::endl;
+    }
+
+    static void test_reload_races_with_stop() {
+        std::cout << "Testing model reloads racing with stop()..." << std::endl;
+
+        InferenceService service;
+        ModelConfig model;
+        model.backend = "reference";
+        model.warmup_runs = 0;
+        service.setModelConfig(model);
+        DisplayConfig display;
+        display.headless = true;
+        service.setDisplayConfig(display);
+        bool initialized = service.initialize();
+        assert(initialized);
+
+        // Reloads keep coming from several threads (like Web API handlers) while the service stops
+        std::atomic<bool> go{false};
+        std::atomic<int> accepted{0};
+        std::vector<std::thread> reloaders;
+        for (int i = 0; i < 4; ++i) {
+            reloaders.emplace_back([&service, &go, &accepted, model]() {
+                while (!go) {
+                    std::this_thread::yield();
+                }
+                for (int attempt = 0; attempt < 200; ++attempt) {
+                    if (service.reloadModel(model)) {
+                        accepted++;
+                    }
+                }
+            });
+        }
+        go = true;
+        service.stop();
+        for (auto& reloader : reloaders) {
+            reloader.join();
+        }
+
+        // Nothing is accepted once stop() has run
+        bool reloaded = service.reloadModel(model);
+        assert(!reloaded);
+
+        std::cout << "✅ Reload/stop race test passed (" << accepted << " reloads accepted before stop)" << std::endl;
+    }
+
+    static void test_destroy_with_running_stream() {
+        std::cout << "Testing destruction with a stream still capturing..." << std::endl;
+
+        for (int round = 0; round < 3; ++round) {
+            InferenceService service;
+            ModelConfig model;
+            model.backend = "reference";
+            model.warmup_runs = 0;
+            service.setModelConfig(model);
+            DisplayConfig display;
+            display.headless = true;
+            service.setDisplayConfig(display);
+            bool initialized = service.initialize();
+            assert(initialized);
+
+            CaptureConfig capture;
+            capture.pacing = PacingMode::AS_FAST_AS_POSSIBLE;
+            service.setCaptureConfig(capture);
+            bool started = service.startStream("busy", "synthetic:64x48");
+            assert(started);
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            // No stop(): the destructor must join the capture thread before its members go
+        }
+
+        std::cout << "✅ Destruction test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Inference Service Unit Tests" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    InferenceServiceTest::test_in_flight_limit_rejects_without_blocking();
+    InferenceServiceTest::test_reload_races_with_stop();
+    InferenceServiceTest::test_destroy_with_running_stream();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All inference service unit tests passed!" << std::endl;
+    return 0;
+}
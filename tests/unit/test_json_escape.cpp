@@ -0,0 +1,92 @@
+/**
+ * @file test_json_escape.cpp
+ * @brief Unit tests for JSON string escaping and request field extraction
+ */
+
+#include "json_escape.hpp"
+#include "web_api_server.hpp"
+#include "inference_backend.hpp"
+#include <cassert>
+#include <iostream>
+
+class JsonEscapeTest {
+public:
+    static void test_escape() {
+        std::cout << "Testing JSON escaping..." << std::endl;
+
+        assert(jsonEscape("models/resnet18.onnx") == "models/resnet18.onnx");
+        assert(jsonEscape("C:\\models\\x.onnx") == "C:\\\\models\\\\x.onnx");
+        assert(jsonEscape("say \"hi\"") == "say \\\"hi\\\"");
+        assert(jsonEscape("a\nb\tc\r") == "a\\nb\\tc\\r");
+        assert(jsonEscape(std::string("\x01", 1)) == "\\u0001");
+        assert(jsonEscape("视频.mp4") == "视频.mp4");   // UTF-8 passes through
+        assert(WebApiServer::escapeJsonString("C:\\x") == "C:\\\\x");
+
+        std::cout << "✅ Escape test passed" << std::endl;
+    }
+
+    static void test_unescape() {
+        std::cout << "Testing JSON unescaping..." << std::endl;
+
+        assert(jsonUnescape("C:\\\\models\\\\x.onnx") == "C:\\models\\x.onnx");
+        assert(jsonUnescape("say \\\"hi\\\"") == "say \"hi\"");
+        assert(jsonUnescape("a\\/b\\nc") == "a/b\nc");
+        assert(jsonUnescape("\\u00e9") == "\xc3\xa9");
+        assert(jsonUnescape("\\u89c6") == "视");
+        assert(jsonUnescape("\\ud83d\\ude00") == "\xf0\x9f\x98\x80");   // Surrogate pair
+        assert(jsonUnescape("bad \\uZZ") == "bad \\uZZ");              // Malformed kept
+        assert(jsonUnescape("trailing \\") == "trailing \\");
+
+        // Round trip, including control characters
+        std::string original = std::string("C:\\dir \"q\"\n\t\x02 视频", 20);
+        assert(jsonUnescape(jsonEscape(original)) == original);
+
+        std::cout << "✅ Unescape test passed" << std::endl;
+    }
+
+    static void test_extract_string() {
+        std::cout << "Testing request field extraction..." << std::endl;
+
+        std::string body = R"({"model_path":"C:\\models\\v2.onnx","backend":"reference"})";
+        assert(WebApiServer::extractJsonString(body, "model_path") == "C:\\models\\v2.onnx");
+        assert(WebApiServer::extractJsonString(body, "backend") == "reference");
+
+        // An escaped quote does not end the value
+        std::string quoted = R"({"stream":"say \"hi\"","source":"synthetic:64x48"})";
+        assert(WebApiServer::extractJsonString(quoted, "stream") == "say \"hi\"");
+        assert(WebApiServer::extractJsonString(quoted, "source") == "synthetic:64x48");
+
+        assert(WebApiServer::extractJsonString(body, "missing") == "");
+        assert(WebApiServer::extractJsonString(R"({"model_path":"unterminated)", "model_path") == "");
+
+        std::cout << "✅ Extraction test passed" << std::endl;
+    }
+
+    static void test_backend_info_escapes_path() {
+        std::cout << "Testing backend info JSON escapes the model path..." << std::endl;
+
+        ReferenceBackend backend;
+        ModelConfig config;
+        config.model_path = "C:\\models\\\"x\".onnx";
+        bool loaded = backend.load(config);
+        assert(loaded);
+        std::string info = backend.getInfoJson();
+        assert(info.find("\"path\":\"C:\\\\models\\\\\\\"x\\\".onnx\"") != std::string::npos);
+
+        std::cout << "✅ Backend info test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running JSON Escape Unit Tests" << std::endl;
+    std::cout << "=================================" << std::endl;
+
+    JsonEscapeTest::test_escape();
+    JsonEscapeTest::test_unescape();
+    JsonEscapeTest::test_extract_string();
+    JsonEscapeTest::test_backend_info_escapes_path();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All JSON escape unit tests passed!" << std::endl;
+    return 0;
+}
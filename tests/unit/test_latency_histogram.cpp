@@ -0,0 +1,133 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for the latency histogram and frame metadata
+ */
+
+#include "latency_histogram.hpp"
+#include "frame_metadata.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+class LatencyHistogramTest {
+public:
+    static void test_empty() {
+        std::cout << "Testing empty histogram..." << std::endl;
+
+        LatencyHistogram histogram;
+        assert(histogram.getCount() == 0);
+        assert(histogram.getMean() == 0.0);
+        assert(histogram.getMin() == 0.0);
+        assert(histogram.getMax() == 0.0);
+        assert(histogram.getPercentile(0.99) == 0.0);
+
+        std::cout << "✅ Empty histogram test passed" << std::endl;
+    }
+
+    static void test_percentiles() {
+        std::cout << "Testing percentile accuracy..." << std::endl;
+
+        // 1..1000 ms uniformly
+        LatencyHistogram histogram;
+        for (int i = 1; i <= 1000; ++i) {
+            histogram.record(static_cast<double>(i));
+        }
+
+        assert(histogram.getCount() == 1000);
+        assert(std::fabs(histogram.getMean() - 500.5) < 0.01);
+        assert(histogram.getMin() == 1.0);
+        assert(histogram.getMax() == 1000.0);
+
+        // Buckets are 1/8 of a power of two wide
+        assert(std::fabs(histogram.getPercentile(0.50) - 500.0) / 500.0 < 0.125);
+        assert(std::fabs(histogram.getPercentile(0.90) - 900.0) / 900.0 < 0.125);
+        assert(std::fabs(histogram.getPercentile(0.99) - 990.0) / 990.0 < 0.125);
+        assert(histogram.getPercentile(1.0) <= histogram.getMax());
+        assert(histogram.getPercentile(0.0) >= histogram.getMin());
+
+        std::cout << "✅ Percentile test passed" << std::endl;
+    }
+
+    static void test_sub_millisecond() {
+        std::cout << "Testing sub-millisecond samples..." << std::endl;
+
+        LatencyHistogram histogram;
+        histogram.record(0.004);  // 4 us
+        histogram.record(0.0);
+        histogram.record(-1.0);   // Clamped to 0
+
+        assert(histogram.getCount() == 3);
+        assert(histogram.getMin() == 0.0);
+        assert(std::fabs(histogram.getMax() - 0.004) < 1e-9);
+
+        std::cout << "✅ Sub-millisecond test passed" << std::endl;
+    }
+
+    static void test_concurrent_record() {
+        std::cout << "Testing concurrent recording..." << std::endl;
+
+        LatencyHistogram histogram;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&histogram, t]() {
+                for (int i = 0; i < 10000; ++i) {
+                    histogram.record(1.0 + t);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        assert(histogram.getCount() == 40000);
+        assert(histogram.getMin() == 1.0);
+        assert(histogram.getMax() == 4.0);
+
+        histogram.reset();
+        assert(histogram.getCount() == 0);
+
+        std::cout << "✅ Concurrent recording test passed" << std::endl;
+    }
+
+    static void test_frame_metadata() {
+        std::cout << "Testing frame metadata stages..." << std::endl;
+
+        FrameMetadata metadata;
+        auto t0 = FrameMetadata::Clock::now();
+        metadata.capture_time = t0;
+        metadata.enterStage("queue", t0);
+        metadata.leaveStage("queue", t0 + std::chrono::milliseconds(5));
+        metadata.enterStage("process", t0 + std::chrono::milliseconds(5));
+
+        assert(metadata.hasStage("queue"));
+        assert(!metadata.hasStage("display"));
+        assert(std::fabs(metadata.stageMs("queue") - 5.0) < 1e-6);
+        assert(metadata.stageMs("process") == 0.0); // Not left yet
+        assert(std::fabs(metadata.ageMs(t0 + std::chrono::milliseconds(12)) - 12.0) < 1e-6);
+
+        // Stages beyond capacity are ignored instead of overflowing
+        for (size_t i = 0; i < FrameMetadata::MAX_STAGES * 2; ++i) {
+            metadata.enterStage("extra");
+        }
+        assert(metadata.stage_count == FrameMetadata::MAX_STAGES);
+
+        std::cout << "✅ Frame metadata test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Latency Histogram Unit Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    LatencyHistogramTest::test_empty();
+    LatencyHistogramTest::test_percentiles();
+    LatencyHistogramTest::test_sub_millisecond();
+    LatencyHistogramTest::test_concurrent_record();
+    LatencyHistogramTest::test_frame_metadata();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All latency histogram unit tests passed!" << std::endl;
+    return 0;
+}
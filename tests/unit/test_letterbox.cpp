@@ -0,0 +1,238 @@
+/**
+ * @file test_letterbox.cpp
+ * @brief Unit tests for letterboxing into pooled tensors and mapping boxes back
+ */
+
+#include "letterbox.hpp"
+#include "detection_postprocess.hpp"
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+class LetterboxTest {
+public:
+    static cv::Mat randomImage(int width, int height) {
+        cv::Mat image(height, width, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+        return image;
+    }
+
+    static void test_transform() {
+        std::cout << "Testing letterbox transforms..." << std::endl;
+
+        LetterboxTransform wide = LetterboxTransform::letterbox(cv::Size(1920, 1080), cv::Size(640, 640));
+        assert(wide.valid());
+        assert(wide.content == cv::Rect(0, 140, 640, 360));
+        assert(wide.scale_x == 3.0f && wide.scale_y == 3.0f);
+
+        LetterboxTransform tall = LetterboxTransform::letterbox(cv::Size(480, 640), cv::Size(640, 640));
+        assert(tall.content == cv::Rect(80, 0, 480, 640));
+
+        // Rounded content size: each axis maps back with its own exact ratio
+        LetterboxTransform odd = LetterboxTransform::letterbox(cv::Size(100, 37), cv::Size(64, 64));
+        assert(odd.content == cv::Rect(0, 20, 64, 24));
+        assert(odd.scale_x == 1.5625f && std::fabs(odd.scale_y - 37.0f / 24.0f) < 1e-6f);
+
+        for (const LetterboxTransform& transform : {wide, tall, odd}) {
+            const cv::Rect& c = transform.content;
+            cv::Point2f origin = transform.toSource(cv::Point2f(static_cast<float>(c.x), static_cast<float>(c.y)));
+            cv::Point2f corner = transform.toSource(cv::Point2f(static_cast<float>(c.x + c.width),
+                                                                static_cast<float>(c.y + c.height)));
+            assert(std::fabs(origin.x) < 1e-4f && std::fabs(origin.y) < 1e-4f);
+            assert(std::fabs(corner.x - transform.source.width) < 1e-3f);
+            assert(std::fabs(corner.y - transform.source.height) < 1e-3f);
+
+            cv::Point2f input = transform.toInput(cv::Point2f(17.0f, 11.0f));
+            cv::Point2f back = transform.toSource(input);
+            assert(std::fabs(back.x - 17.0f) < 1e-3f && std::fabs(back.y - 11.0f) < 1e-3f);
+        }
+
+        // Boxes reaching into the padding are clipped to the frame
+        assert(wide.toSource(100, 100, 200, 200) == cv::Rect(300, 0, 300, 480));
+        assert(wide.toSource(100, 10, 200, 100).empty());
+
+        LetterboxTransform stretch = LetterboxTransform::stretch(cv::Size(1280, 720), cv::Size(640, 640));
+        assert(stretch.content == cv::Rect(0, 0, 640, 640));
+        assert(stretch.scale_x == 2.0f && stretch.scale_y == 1.125f);
+        assert(!LetterboxTransform::letterbox(cv::Size(), cv::Size(640, 640)).valid());
+
+        std::cout << "✅ Transform test passed" << std::endl;
+    }
+
+    /**
+     * @brief resize + copyMakeBorder + blobFromImage, the allocation-heavy way
+     */
+    static std::vector<float> referenceTensor(const cv::Mat& image, const LetterboxTransform& transform, double scale,
+                                              const cv::Scalar& mean, const cv::Scalar& pad_value) {
+        cv::Mat resized, padded;
+        cv::resize(image, resized, transform.content.size(), 0, 0, cv::INTER_LINEAR);
+        const cv::Rect& c = transform.content;
+        // pad_value is in network (RGB) order, the padded image is still BGR
+        cv::copyMakeBorder(resized, padded, c.y, transform.input.height - c.y - c.height, c.x,
+                           transform.input.width - c.x - c.width, cv::BORDER_CONSTANT,
+                           cv::Scalar(pad_value[2], pad_value[1], pad_value[0]));
+        cv::Mat blob = cv::dnn::blobFromImage(padded, scale, cv::Size(), mean, true, false, CV_32F);
+        return std::vector<float>(blob.ptr<float>(), blob.ptr<float>() + blob.total());
+    }
+
+    static void test_tensor_matches_reference() {
+        std::cout << "Testing letterboxed tensors against resize + copyMakeBorder..." << std::endl;
+
+        const double scale = 1.0 / 255.0;
+        const cv::Scalar mean(10, 20, 30);
+        const cv::Scalar pad_value(114, 100, 90);
+        const std::vector<std::pair<cv::Size, cv::Size>> cases = {
+            {{1920, 1080}, {640, 640}}, {{480, 640}, {640, 640}}, {{100, 37}, {64, 64}},
+            {{640, 640}, {320, 320}}, {{33, 65}, {48, 40}},
+        };
+
+        for (const auto& test_case : cases) {
+            cv::Mat image = randomImage(test_case.first.width, test_case.first.height);
+            LetterboxTransform transform = LetterboxTransform::letterbox(test_case.first, test_case.second);
+            std::vector<float> expected = referenceTensor(image, transform, scale, mean, pad_value);
+
+            FusedPreprocessor preprocessor(test_case.second, scale, mean, true);
+            for (SimdPath path : FusedPreprocessor::availablePaths()) {
+                bool selected = preprocessor.setPath(path);
+                assert(selected);
+                // Stale contents must be overwritten everywhere, border included
+                std::vector<float> tensor(expected.size(), std::numeric_limits<float>::quiet_NaN());
+                bool ran = preprocessor.run(image, tensor.data(), transform.content, pad_value);
+                assert(ran);
+                for (size_t i = 0; i < tensor.size(); ++i) {
+                    assert(std::fabs(tensor[i] - expected[i]) <= scale * 1.01);
+                }
+            }
+
+            // Border holds the normalized pad value
+            const size_t plane = static_cast<size_t>(test_case.second.area());
+            std::vector<float> tensor(expected.size());
+            bool ran = preprocessor.run(image, tensor.data(), transform.content, pad_value);
+            assert(ran);
+            for (int c = 0; c < 3; ++c) {
+                const float pad = static_cast<float>((pad_value[c] - mean[c]) * scale);
+                if (transform.content.y > 0) {
+                    assert(std::fabs(tensor[c * plane] - pad) < 1e-6f);
+                }
+                if (transform.content.x > 0) {
+                    assert(std::fabs(tensor[c * plane + static_cast<size_t>(transform.content.y) * test_case.second.width] - pad) < 1e-6f);
+                }
+            }
+        }
+
+        // Int8 output pads with the quantized pad value
+        cv::Mat image = randomImage(1280, 720);
+        LetterboxTransform transform = LetterboxTransform::letterbox(image.size(), cv::Size(320, 320));
+        FusedPreprocessor preprocessor(cv::Size(320, 320), scale, cv::Scalar(), true);
+        Int8Quantization quantization;
+        quantization.scale = 1.0f / 127.0f;
+        quantization.zero_point = -10;
+        std::vector<int8_t> quantized(3 * 320 * 320, -100);   // Outside the reachable [-10, 117]
+        bool ran = preprocessor.run(image, quantized.data(), quantization, transform.content, cv::Scalar::all(255));
+        assert(ran);
+        assert(quantized[0] == 117 && quantized[320 * 320 - 1] == 117);
+        assert(quantized[static_cast<size_t>(transform.content.y) * 320] != -100);
+
+        // Content rectangles outside the tensor are rejected
+        std::vector<float> tensor(3 * 320 * 320);
+        ran = preprocessor.run(image, tensor.data(), cv::Rect(10, 10, 320, 300), cv::Scalar());
+        assert(!ran);
+        ran = preprocessor.run(image, tensor.data(), cv::Rect(0, 0, 0, 0), cv::Scalar());
+        assert(!ran);
+
+        std::cout << "✅ Tensor test passed" << std::endl;
+    }
+
+    static void test_letterboxer_recycles_tensors() {
+        std::cout << "Testing the letterbox stage recycles pooled tensors..." << std::endl;
+
+        Letterboxer letterboxer(cv::Size(320, 320), 1.0 / 255.0, cv::Scalar(), true, cv::Scalar::all(114), 2);
+        cv::Mat frame = randomImage(1280, 720);
+        LetterboxedFrame letterboxed;
+        bool processed = letterboxer.process(frame, letterboxed);
+        assert(processed);
+        assert(letterboxed.tensor.isPooled());
+        assert(letterboxed.tensor.mat().rows == 3 * 320 && letterboxed.tensor.mat().cols == 320);
+        assert(letterboxed.transform.content == cv::Rect(0, 70, 320, 180));
+
+        // Same result as the preprocessor on its own
+        std::vector<float> expected(3 * 320 * 320);
+        bool ran = letterboxer.getPreprocessor().run(frame, expected.data(), letterboxed.transform.content, cv::Scalar::all(114));
+        assert(ran);
+        assert(std::equal(expected.begin(), expected.end(), letterboxed.data()));
+
+        // Steady state: the same buffer comes back, nothing new is allocated
+        const float* storage = letterboxed.data();
+        for (int i = 0; i < 20; ++i) {
+            processed = letterboxer.process(frame, letterboxed);
+            assert(processed);
+            assert(letterboxed.data() == storage);
+        }
+        FramePoolStats stats = letterboxer.getPoolStats();
+        assert(stats.misses == 0 && stats.buffers == 2);
+
+        // Frames held elsewhere keep their tensor and transform
+        LetterboxedFrame held = letterboxed;
+        processed = letterboxer.process(randomImage(480, 640), letterboxed);
+        assert(processed);
+        assert(letterboxed.data() != held.data());
+        assert(held.transform.content == cv::Rect(0, 70, 320, 180));
+        assert(letterboxed.transform.content == cv::Rect(40, 0, 240, 320));
+
+        cv::Mat gray(720, 1280, CV_8UC1, cv::Scalar(0));
+        processed = letterboxer.process(gray, letterboxed);
+        assert(!processed);
+        assert(!letterboxed.tensor);
+
+        std::cout << "✅ Letterbox stage test passed" << std::endl;
+    }
+
+    static void test_decode_maps_back() {
+        std::cout << "Testing YOLO boxes map back through the transform..." << std::endl;
+
+        // [1, 4 + 2 classes, 3 candidates] in 640x640 input pixels
+        const int count = 3, rows = 6;
+        std::vector<float> data(rows * count, 0.0f);
+        auto set = [&](int i, float cx, float cy, float w, float h, int cls, float score) {
+            data[i] = cx;
+            data[count + i] = cy;
+            data[2 * count + i] = w;
+            data[3 * count + i] = h;
+            data[(4 + cls) * count + i] = score;
+        };
+        set(0, 320, 320, 64, 32, 0, 0.9f);
+        set(1, 100, 150, 40, 20, 1, 0.8f);   // Half in the top padding
+        set(2, 300, 50, 40, 40, 1, 0.7f);    // Entirely in the padding
+        int sizes[3] = {1, rows, count};
+        cv::Mat output(3, sizes, CV_32F, data.data());
+
+        LetterboxTransform transform = LetterboxTransform::letterbox(cv::Size(1920, 1080), cv::Size(640, 640));
+        DetectionPostprocessor postprocessor;
+        std::vector<PipelineRegion> detections;
+        bool decoded = postprocessor.decodeYolo(output, 0, PostprocessConfig(), transform, detections);
+        assert(decoded);
+        assert(detections.size() == 2);
+        assert(detections[0].box == cv::Rect(864, 492, 192, 96));
+        assert(detections[1].box == cv::Rect(240, 0, 120, 60));
+
+        decoded = postprocessor.decodeYolo(output, 0, PostprocessConfig(), LetterboxTransform(), detections);
+        assert(!decoded);
+
+        std::cout << "✅ Decode mapping test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Letterbox Unit Tests" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    LetterboxTest::test_transform();
+    LetterboxTest::test_tensor_matches_reference();
+    LetterboxTest::test_letterboxer_recycles_tensors();
+    LetterboxTest::test_decode_maps_back();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All letterbox unit tests passed!" << std::endl;
+    return 0;
+}
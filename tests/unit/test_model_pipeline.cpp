@@ -0,0 +1,216 @@
+/**
+ * @file test_model_pipeline.cpp
+ * @brief Unit tests for the multi-model pipeline executor
+ */
+
+#include "model_pipeline.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <vector>
+
+/**
+ * @brief Latch two backends must both reach; only possible if they run at the same time
+ */
+class Rendezvous {
+public:
+    explicit Rendezvous(int parties) : remaining_(parties) {}
+
+    /**
+     * @brief Arrive and wait for the others; false if they did not show up within timeout
+     */
+    bool arriveAndWait(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (--remaining_ <= 0) {
+            cv_.notify_all();
+            return true;
+        }
+        return cv_.wait_for(lock, timeout, [this] { return remaining_ <= 0; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int remaining_;
+};
+
+/**
+ * @brief Reference backend that records its batches and can wait at a rendezvous to expose parallelism
+ */
+class RecordingBackend : public ReferenceBackend {
+public:
+    bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch_sizes.push_back(images.size());
+            for (const auto& image : images) {
+                data.push_back(image.data);
+            }
+        }
+        if (rendezvous && !arrived.exchange(true)) {
+            met = rendezvous->arriveAndWait(std::chrono::seconds(5));
+        }
+        return ReferenceBackend::runBatch(images, outputs);
+    }
+
+    std::mutex mutex;
+    std::vector<size_t> batch_sizes;
+    std::vector<const uchar*> data;   // Pixel pointer of every image received
+    std::shared_ptr<Rendezvous> rendezvous;  // Waited on by the first batch only
+    std::atomic<bool> arrived{false};
+    std::atomic<bool> met{false};
+};
+
+class ModelPipelineTest {
+public:
+    /**
+     * @brief Three 40x40 squares: blue, green, red from left to right on a black frame
+     */
+    static cv::Mat makeFrame() {
+        cv::Mat frame(60, 160, CV_8UC3, cv::Scalar(0, 0, 0));
+        frame(cv::Rect(10, 10, 40, 40)).setTo(cv::Scalar(255, 0, 0));
+        frame(cv::Rect(60, 10, 40, 40)).setTo(cv::Scalar(0, 255, 0));
+        frame(cv::Rect(110, 10, 40, 40)).setTo(cv::Scalar(0, 0, 255));
+        return frame;
+    }
+
+    /**
+     * @brief Detector decoder that reports the three squares, class = square index
+     */
+    static std::vector<PipelineRegion> squares(const std::vector<cv::Mat>&, size_t, const cv::Size&) {
+        std::vector<PipelineRegion> regions(3);
+        for (int i = 0; i < 3; ++i) {
+            regions[i].box = cv::Rect(10 + 50 * i, 10, 40, 40);
+            regions[i].class_id = i;
+            regions[i].score = 0.9f;
+        }
+        return regions;
+    }
+
+    template <typename Backend>
+    static std::shared_ptr<Backend> loaded() {
+        auto backend = std::make_shared<Backend>();
+        backend->load(ModelConfig());
+        return backend;
+    }
+
+    static void test_detector_classifier() {
+        std::cout << "Testing detector -> crop -> batched classifier..." << std::endl;
+
+        auto classifier = loaded<RecordingBackend>();
+        ModelPipeline pipeline;
+        PipelineNode detector{"detector", "", loaded<ReferenceBackend>(), squares, nullptr, 1};
+        PipelineNode colour{"colour", "detector", classifier, nullptr, nullptr, 2};
+        bool added = pipeline.addNode(detector);
+        assert(added);
+        added = pipeline.addNode(colour);
+        assert(added);
+
+        cv::Mat frame = makeFrame();
+        PipelineResult result = pipeline.run(frame);
+        assert(result.ok);
+        assert(result.nodes["detector"].regions.size() == 3);
+
+        const PipelineNodeOutput& colours = result.nodes["colour"];
+        assert(colours.results.size() == 3);
+        for (int i = 0; i < 3; ++i) {
+            assert(colours.results[i].top_index == i);   // Blue, green, red = channel 0, 1, 2
+            assert(colours.sources[i] == i);
+            assert(colours.boxes[i] == cv::Rect(10 + 50 * i, 10, 40, 40));
+        }
+
+        // Three crops with max_batch 2: two calls, 2 + 1
+        assert(classifier->batch_sizes.size() == 2);
+        assert(classifier->batch_sizes[0] == 2 && classifier->batch_sizes[1] == 1);
+
+        // Crops are views into the frame buffer
+        const uchar* begin = frame.data;
+        const uchar* end = frame.data + frame.total() * frame.elemSize();
+        for (const uchar* pointer : classifier->data) {
+            assert(pointer >= begin && pointer < end);
+        }
+        assert(classifier->data[0] == frame.ptr<uchar>(10) + 10 * 3);
+
+        std::cout << "✅ Detector/classifier test passed" << std::endl;
+    }
+
+    static void test_filter_and_parallel_branches() {
+        std::cout << "Testing filtered branches run in parallel..." << std::endl;
+
+        // Each branch blocks until the other one is running too; run sequentially they would time out
+        auto rendezvous = std::make_shared<Rendezvous>(2);
+        auto first = loaded<RecordingBackend>();
+        auto second = loaded<RecordingBackend>();
+        first->rendezvous = rendezvous;
+        second->rendezvous = rendezvous;
+
+        ModelPipeline pipeline;
+        bool added = pipeline.addNode({"detector", "", loaded<ReferenceBackend>(), squares, nullptr, 16});
+        assert(added);
+        added = pipeline.addNode({"all", "detector", first, nullptr, nullptr, 16});
+        assert(added);
+        added = pipeline.addNode({"red_only", "detector", second, nullptr,
+                                  [](const PipelineRegion& region) { return region.class_id == 2; }, 16});
+        assert(added);
+
+        PipelineResult result = pipeline.run(makeFrame());
+
+        assert(result.ok);
+        assert(result.nodes["all"].results.size() == 3);
+        assert(result.nodes["red_only"].results.size() == 1);
+        assert(result.nodes["red_only"].results[0].top_index == 2);
+        assert(result.nodes["red_only"].sources[0] == 2);
+        assert(first->met && second->met);
+
+        std::cout << "✅ Parallel branch test passed" << std::endl;
+    }
+
+    static void test_validation_and_latency() {
+        std::cout << "Testing graph validation and per-node latency..." << std::endl;
+
+        ModelPipeline pipeline;
+        auto backend = loaded<ReferenceBackend>();
+        bool added = pipeline.addNode({"", "", backend, nullptr, nullptr, 1});
+        assert(!added);   // No name
+        added = pipeline.addNode({"orphan", "missing", backend, nullptr, nullptr, 1});
+        assert(!added);   // Unknown input
+        added = pipeline.addNode({"unloaded", "", std::make_shared<ReferenceBackend>(), nullptr, nullptr, 1});
+        assert(!added);
+        added = pipeline.addNode({"classifier", "", backend, nullptr, nullptr, 1});
+        assert(added);
+        added = pipeline.addNode({"classifier", "", backend, nullptr, nullptr, 1});
+        assert(!added);   // Duplicate
+        added = pipeline.addNode({"child", "classifier", backend, nullptr, nullptr, 1});
+        assert(!added);   // Input is not a detector
+
+        for (int i = 0; i < 5; ++i) {
+            PipelineResult result = pipeline.run(makeFrame());
+            assert(result.ok && result.nodes["classifier"].results.size() == 1);
+        }
+        std::string latency = pipeline.getPerformanceMonitor().getStageLatencyJson();
+        assert(latency.find("\"classifier\":{\"count\":5") != std::string::npos);
+        assert(latency.find("\"total\":{\"count\":5") != std::string::npos);
+
+        pipeline.getPerformanceMonitor().reset();
+        latency = pipeline.getPerformanceMonitor().getStageLatencyJson();
+        assert(latency.find("\"classifier\":{\"count\":0") != std::string::npos);
+
+        std::cout << "✅ Validation and latency test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Model Pipeline Unit Tests" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    ModelPipelineTest::test_detector_classifier();
+    ModelPipelineTest::test_filter_and_parallel_branches();
+    ModelPipelineTest::test_validation_and_latency();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All model pipeline unit tests passed!" << std::endl;
+    return 0;
+}
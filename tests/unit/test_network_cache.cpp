@@ -0,0 +1,207 @@
+/**
+ * @file test_network_cache.cpp
+ * @brief Unit tests for the optimized-network cache
+ */
+
+#include "network_cache.hpp"
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Reference backend that needs a model file and exports its "optimized" state
+ *
+ * The artifact is the model file's bytes reversed, so a hit can be told
+ * apart from a fresh load.
+ */
+class ExportingBackend : public ReferenceBackend {
+public:
+    std::string getName() const override {
+        return "exporting";
+    }
+
+    bool requiresModelFile() const override {
+        return true;
+    }
+
+    std::string getRuntimeVersion() const override {
+        return runtime_version;
+    }
+
+    bool supportsOptimizedExport() const override {
+        return supports_export;
+    }
+
+    bool load(const ModelConfig& config) override {
+        std::ifstream in(config.model_path, std::ios::binary);
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        optimized.assign(bytes.rbegin(), bytes.rend());
+        full_loads++;
+        return ReferenceBackend::load(config);
+    }
+
+    bool exportOptimized(std::vector<uint8_t>& artifact) const override {
+        if (!can_export) {
+            return false;
+        }
+        artifact = optimized;
+        return true;
+    }
+
+    bool loadOptimized(const ModelConfig& config, const std::vector<uint8_t>& artifact) override {
+        optimized = artifact;
+        cached_loads++;
+        return ReferenceBackend::load(config);
+    }
+
+    std::string runtime_version = "1.0";
+    bool supports_export = true;
+    bool can_export = true;     // Export can still fail at runtime when supported
+    std::vector<uint8_t> optimized;
+    int full_loads = 0;
+    int cached_loads = 0;
+};
+
+class NetworkCacheTest {
+public:
+    static std::filesystem::path makeDirectory() {
+        std::filesystem::path dir = std::filesystem::temp_directory_path() / "test_network_cache";
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+        return dir;
+    }
+
+    static void writeModel(const std::filesystem::path& path, const std::string& content) {
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+    }
+
+    static void test_cold_then_warm() {
+        std::cout << "Testing cold start fills the cache and a warm start uses it..." << std::endl;
+
+        std::filesystem::path dir = makeDirectory();
+        ModelConfig config;
+        config.model_path = (dir / "model.onnx").string();
+        config.cache_dir = (dir / "cache").string();
+        writeModel(config.model_path, "model-v1");
+        NetworkCache cache(config.cache_dir);
+
+        ExportingBackend cold;
+        bool loaded = cache.loadBackend(cold, config);
+        assert(loaded);
+        assert(cold.full_loads == 1 && cold.cached_loads == 0);
+        assert(cold.getNetworkCacheStatus().state == "stored");
+        std::string key = cold.getNetworkCacheStatus().key;
+        assert(key.rfind("exporting-", 0) == 0 && key.size() == 10 + 32);
+        assert(std::filesystem::exists(cache.artifactPath(key)));
+        assert(std::filesystem::exists(cache.manifestPath(key)));
+
+        ExportingBackend warm;
+        loaded = cache.loadBackend(warm, config);
+        assert(loaded);
+        assert(warm.full_loads == 0 && warm.cached_loads == 1);
+        assert(warm.getNetworkCacheStatus().state == "hit");
+        assert(warm.optimized == cold.optimized);
+        assert(warm.getInfoJson().find("\"network_cache\":{\"enabled\":true,\"state\":\"hit\"") != std::string::npos);
+
+        std::filesystem::remove_all(dir);
+        std::cout << "✅ Cold/warm test passed" << std::endl;
+    }
+
+    static void test_key_changes() {
+        std::cout << "Testing model, runtime and input size changes miss..." << std::endl;
+
+        std::filesystem::path dir = makeDirectory();
+        ModelConfig config;
+        config.model_path = (dir / "model.onnx").string();
+        writeModel(config.model_path, "model-v1");
+
+        ExportingBackend backend;
+        std::string base, other;
+        bool keyed = NetworkCache::makeKey(backend, config, base);
+        assert(keyed);
+        keyed = NetworkCache::makeKey(backend, config, other);
+        assert(keyed && other == base);
+
+        writeModel(config.model_path, "model-v2");
+        keyed = NetworkCache::makeKey(backend, config, other);
+        assert(keyed && other != base);
+        writeModel(config.model_path, "model-v1");
+
+        backend.runtime_version = "2.0";
+        keyed = NetworkCache::makeKey(backend, config, other);
+        assert(keyed && other != base);
+        backend.runtime_version = "1.0";
+
+        config.input_width = 320;
+        keyed = NetworkCache::makeKey(backend, config, other);
+        assert(keyed && other != base);
+
+        config.model_path = (dir / "missing.onnx").string();
+        keyed = NetworkCache::makeKey(backend, config, other);
+        assert(!keyed);
+
+        std::filesystem::remove_all(dir);
+        std::cout << "✅ Key test passed (CPU features: " << NetworkCache::cpuFeatures() << ")" << std::endl;
+    }
+
+    static void test_unsupported_backend() {
+        std::cout << "Testing backends without export load normally..." << std::endl;
+
+        std::filesystem::path dir = makeDirectory();
+        ModelConfig config;
+        config.model_path = (dir / "model.onnx").string();
+        config.cache_dir = (dir / "cache").string();
+        writeModel(config.model_path, "model-v1");
+        NetworkCache cache(config.cache_dir);
+
+        for (int start = 0; start < 2; ++start) {
+            ExportingBackend backend;
+            backend.supports_export = false;
+            bool loaded = cache.loadBackend(backend, config);
+            assert(loaded);
+            assert(backend.full_loads == 1);
+            const NetworkCacheStatus& status = backend.getNetworkCacheStatus();
+            assert(status.state == "unsupported");
+            assert(status.key.empty() && status.key_ms == 0.0 && status.io_ms == 0.0); // Model never hashed
+        }
+
+        // A model file that cannot be hashed is no error when there is nothing to cache
+        ModelConfig unreadable = config;
+        unreadable.model_path = (dir / "missing.onnx").string();
+        ExportingBackend skipped;
+        skipped.supports_export = false;
+        bool loaded = cache.loadBackend(skipped, unreadable);
+        assert(loaded);
+        assert(skipped.getNetworkCacheStatus().state == "unsupported");
+
+        // Supported but failing at runtime: hashed, loaded, nothing stored
+        ExportingBackend failing;
+        failing.can_export = false;
+        loaded = cache.loadBackend(failing, config);
+        assert(loaded);
+        assert(failing.full_loads == 1);
+        assert(failing.getNetworkCacheStatus().state == "unsupported");
+        assert(!failing.getNetworkCacheStatus().key.empty());
+        assert(!std::filesystem::exists(config.cache_dir)); // Nothing written
+
+        std::filesystem::remove_all(dir);
+        std::cout << "✅ Unsupported backend test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Network Cache Unit Tests" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    NetworkCacheTest::test_cold_then_warm();
+    NetworkCacheTest::test_key_changes();
+    NetworkCacheTest::test_unsupported_backend();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All network cache unit tests passed!" << std::endl;
+    return 0;
+}
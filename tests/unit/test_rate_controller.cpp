@@ -0,0 +1,112 @@
+/**
+ * @file test_rate_controller.cpp
+ * @brief Unit tests for frame rate control and the age budget
+ */
+
+#include "rate_controller.hpp"
+#include <cassert>
+#include <iostream>
+#include <chrono>
+
+class RateControllerTest {
+public:
+    static void test_latest_only() {
+        std::cout << "Testing latest-only mode..." << std::endl;
+
+        RateController controller;
+        auto now = FrameMetadata::Clock::now();
+        for (uint64_t seq = 1; seq <= 10; ++seq) {
+            RateController::Decision decision = controller.admit(makeFrame(seq, now), now);
+            assert(decision == RateController::Decision::ADMIT);
+        }
+
+        std::cout << "✅ Latest-only test passed" << std::endl;
+    }
+
+    static void test_every_nth() {
+        std::cout << "Testing every-Nth mode..." << std::endl;
+
+        RateControlConfig config;
+        config.mode = RateControlMode::EVERY_NTH;
+        config.every_nth = 3;
+        RateController controller(config);
+        auto now = FrameMetadata::Clock::now();
+
+        int admitted = 0;
+        for (uint64_t seq = 1; seq <= 9; ++seq) {
+            if (controller.admit(makeFrame(seq, now), now) == RateController::Decision::ADMIT) {
+                admitted++;
+            }
+        }
+        assert(admitted == 3); // 1, 4, 7
+
+        // Frames lost upstream still count toward N
+        RateController::Decision decision = controller.admit(makeFrame(20, now), now);
+        assert(decision == RateController::Decision::ADMIT);
+        decision = controller.admit(makeFrame(21, now), now);
+        assert(decision == RateController::Decision::SKIP_RATE);
+
+        std::cout << "✅ Every-Nth test passed" << std::endl;
+    }
+
+    static void test_target_fps() {
+        std::cout << "Testing target fps mode..." << std::endl;
+
+        RateControlConfig config;
+        config.mode = RateControlMode::TARGET_FPS;
+        config.target_fps = 10.0;
+        RateController controller(config);
+
+        // 100 fps input for one second -> about 10 admitted
+        auto start = FrameMetadata::Clock::now();
+        int admitted = 0;
+        for (uint64_t seq = 1; seq <= 100; ++seq) {
+            auto now = start + std::chrono::milliseconds(10 * (seq - 1));
+            if (controller.admit(makeFrame(seq, now), now) == RateController::Decision::ADMIT) {
+                admitted++;
+            }
+        }
+        assert(admitted >= 9 && admitted <= 11);
+
+        std::cout << "✅ Target fps test passed" << std::endl;
+    }
+
+    static void test_age_budget() {
+        std::cout << "Testing frame age budget..." << std::endl;
+
+        RateControlConfig config;
+        config.max_frame_age_ms = 50.0;
+        RateController controller(config);
+
+        auto captured = FrameMetadata::Clock::now();
+        RateController::Decision decision =
+            controller.admit(makeFrame(1, captured), captured + std::chrono::milliseconds(10));
+        assert(decision == RateController::Decision::ADMIT);
+        decision = controller.admit(makeFrame(2, captured), captured + std::chrono::milliseconds(80));
+        assert(decision == RateController::Decision::DROP_STALE);
+
+        std::cout << "✅ Age budget test passed" << std::endl;
+    }
+
+private:
+    static FrameMetadata makeFrame(uint64_t sequence, FrameMetadata::TimePoint capture_time) {
+        FrameMetadata metadata;
+        metadata.sequence = sequence;
+        metadata.capture_time = capture_time;
+        return metadata;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Rate Controller Unit Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    RateControllerTest::test_latest_only();
+    RateControllerTest::test_every_nth();
+    RateControllerTest::test_target_fps();
+    RateControllerTest::test_age_budget();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All rate controller unit tests passed!" << std::endl;
+    return 0;
+}
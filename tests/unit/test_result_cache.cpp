@@ -0,0 +1,165 @@
+/**
+ * @file test_result_cache.cpp
+ * @brief Unit tests for the 128-bit hash and the sharded LRU result cache
+ */
+
+#include "result_cache.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ResultCacheTest {
+public:
+    using Cache = ResultCache<std::string>;
+
+    static void test_hash128() {
+        std::cout << "Testing 128-bit hash..." << std::endl;
+
+        // Reference values for MurmurHash3_x64_128, seed 0
+        Hash128 empty = hash128("", 0);
+        assert(empty.low == 0 && empty.high == 0);
+        const std::string fox = "The quick brown fox jumps over the lazy dog";
+        Hash128 fox_hash = hash128(fox.data(), fox.size());
+        assert(fox_hash.low == 0xe34bbc7bbc071b6cULL);
+        assert(fox_hash.high == 0x7a433ca9c49a9347ULL);
+
+        // Every tail length, and a one-byte change anywhere changes the hash
+        std::string data(100, 'x');
+        for (size_t length = 0; length <= data.size(); ++length) {
+            Hash128 base = hash128(data.data(), length);
+            if (length > 0) {
+                std::string changed = data.substr(0, length);
+                changed[length - 1] = 'y';
+                assert(!(hash128(changed.data(), length) == base));
+            }
+        }
+
+        std::cout << "✅ Hash test passed" << std::endl;
+    }
+
+    static void test_hit_and_version() {
+        std::cout << "Testing hits and model versions..." << std::endl;
+
+        ResultCacheConfig config;
+        config.enabled = true;
+        Cache cache(config);
+
+        const std::string input = "encoded image bytes";
+        Cache::Key v1 = Cache::makeKey(input.data(), input.size(), 1);
+        Cache::Key v2 = Cache::makeKey(input.data(), input.size(), 2);
+
+        std::string value;
+        bool hit = cache.get(v1, value);
+        assert(!hit);
+        cache.put(v1, "result-v1");
+        hit = cache.get(v1, value);
+        assert(hit && value == "result-v1");
+        hit = cache.get(v2, value);
+        assert(!hit); // Same bytes, new model: miss
+
+        ResultCacheStats stats = cache.getStats();
+        assert(stats.hits == 1 && stats.misses == 2 && stats.entries == 1);
+
+        cache.clear();
+        hit = cache.get(v1, value);
+        assert(!hit);
+        stats = cache.getStats();
+        assert(stats.entries == 0 && stats.bytes == 0 && stats.invalidations == 1);
+
+        std::cout << "✅ Hit and version test passed" << std::endl;
+    }
+
+    static void test_lru_eviction() {
+        std::cout << "Testing LRU eviction under the byte budget..." << std::endl;
+
+        ResultCacheConfig config;
+        config.enabled = true;
+        config.shards = 1;
+        config.max_bytes = 4096;
+        Cache cache(config);
+
+        auto key = [](int i) { return Cache::makeKey(&i, sizeof(i), 1); };
+        const size_t value_bytes = 900;
+        std::string value;
+
+        for (int i = 0; i < 3; ++i) {
+            cache.put(key(i), std::to_string(i), value_bytes);
+        }
+        bool hit = cache.get(key(0), value); // 0 becomes most recently used
+        assert(hit);
+        // Room for three entries: inserting two more evicts 1 then 2
+        for (int i = 3; i < 5; ++i) {
+            cache.put(key(i), std::to_string(i), value_bytes);
+        }
+
+        ResultCacheStats stats = cache.getStats();
+        assert(stats.bytes <= config.max_bytes);
+        assert(stats.evictions > 0);
+        hit = cache.get(key(0), value);
+        assert(hit && value == "0"); // Recently used survives
+        hit = cache.get(key(1), value);
+        assert(!hit);                // Oldest went first
+        hit = cache.get(key(2), value);
+        assert(!hit);
+        hit = cache.get(key(4), value);
+        assert(hit);
+
+        // An entry larger than the budget is not cached at all
+        cache.put(key(100), "huge", 10000);
+        hit = cache.get(key(100), value);
+        assert(!hit);
+
+        std::cout << "✅ LRU eviction test passed" << std::endl;
+    }
+
+    static void test_concurrent_access() {
+        std::cout << "Testing concurrent access across shards..." << std::endl;
+
+        ResultCacheConfig config;
+        config.enabled = true;
+        config.max_bytes = 1024 * 1024;
+        Cache cache(config);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; ++t) {
+            threads.emplace_back([&cache, t]() {
+                std::string value;
+                for (int i = 0; i < 2000; ++i) {
+                    int id = (i * 7 + t) % 256;
+                    Cache::Key key = Cache::makeKey(&id, sizeof(id), 1);
+                    if (!cache.get(key, value)) {
+                        cache.put(key, std::to_string(id), 16);
+                    } else {
+                        assert(value == std::to_string(id));
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ResultCacheStats stats = cache.getStats();
+        assert(stats.hits + stats.misses == 8 * 2000);
+        assert(stats.entries == 256);
+        assert(stats.hitRatio() > 0.9);
+
+        std::cout << "✅ Concurrent access test passed (hit ratio " << stats.hitRatio() << ")" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Result Cache Unit Tests" << std::endl;
+    std::cout << "===================================" << std::endl;
+
+    ResultCacheTest::test_hash128();
+    ResultCacheTest::test_hit_and_version();
+    ResultCacheTest::test_lru_eviction();
+    ResultCacheTest::test_concurrent_access();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All result cache unit tests passed!" << std::endl;
+    return 0;
+}
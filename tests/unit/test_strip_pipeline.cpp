@@ -0,0 +1,211 @@
+/**
+ * @file test_strip_pipeline.cpp
+ * @brief Unit tests for the cache-blocked, strip-parallel classical CV stage
+ */
+
+#include "strip_pipeline.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+class StripPipelineTest {
+public:
+    /**
+     * @brief The perf test's process_frame chain: gray, blur, Canny, dilate, back to BGR
+     */
+    static std::vector<StripStage> edgeChain() {
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
+        return {
+            StripStage::rows("gray", 0, CV_8UC1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY); }),
+            StripStage::rows("blur", 2, -1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::GaussianBlur(src, dst, cv::Size(5, 5), 1.5); }),
+            StripStage::whole("canny", CV_8UC1, [](const cv::Mat& src, cv::Mat& dst) { cv::Canny(src, dst, 50, 150); }),
+            StripStage::rows("dilate", 1, -1, [kernel](const cv::Mat& src, cv::Mat& dst) { cv::dilate(src, dst, kernel); }),
+            StripStage::rows("bgr", 0, CV_8UC3,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::cvtColor(src, dst, cv::COLOR_GRAY2BGR); }),
+        };
+    }
+
+    /**
+     * @brief Noise with filled shapes, so every stage (Canny included) has real work
+     */
+    static cv::Mat sceneImage(int width, int height, unsigned seed) {
+        cv::Mat image(height, width, CV_8UC3);
+        cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(64));
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 20; ++i) {
+            cv::Point center(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+            cv::Scalar colour(rng() % 256, rng() % 256, rng() % 256);
+            if (i % 2) {
+                cv::circle(image, center, 1 + static_cast<int>(rng() % (width / 4 + 1)), colour, cv::FILLED);
+            } else {
+                cv::Rect box(center.x, center.y, 1 + static_cast<int>(rng() % (width / 3 + 1)),
+                             1 + static_cast<int>(rng() % (height / 3 + 1)));
+                cv::rectangle(image, box, colour, cv::FILLED);
+            }
+        }
+        return image;
+    }
+
+    static bool identical(const cv::Mat& a, const cv::Mat& b) {
+        return a.size() == b.size() && a.type() == b.type() && cv::norm(a, b, cv::NORM_INF) == 0.0;
+    }
+
+    static void test_matches_serial() {
+        std::cout << "Testing strip output is bit-identical to the serial chain..." << std::endl;
+
+        // Frames shorter than one strip, odd sizes, and sizes with many strips
+        const std::vector<cv::Size> sizes = {{640, 480}, {1280, 720}, {333, 97}, {64, 5}, {31, 1}};
+        for (const cv::Size& size : sizes) {
+            cv::Mat frame = sceneImage(size.width, size.height, static_cast<unsigned>(size.area()));
+            cv::Mat expected;
+            StripPipeline reference(edgeChain(), StripConfig());
+            bool ran = reference.runSerial(frame, expected);
+            assert(ran);
+            assert(expected.type() == CV_8UC3 && expected.size() == size);
+
+            for (size_t threads : {1, 2, 4}) {
+                for (size_t cache_bytes : {static_cast<size_t>(0), static_cast<size_t>(4096)}) {
+                    StripConfig config;
+                    config.threads = threads;
+                    config.cache_bytes = cache_bytes;   // 4 KiB: strips of min_strip_rows
+                    config.min_strip_rows = 1;
+                    StripPipeline pipeline(edgeChain(), config);
+                    cv::Mat output;
+                    for (int repeat = 0; repeat < 2; ++repeat) {   // Second run reuses all scratch
+                        ran = pipeline.run(frame, output);
+                        assert(ran);
+                        if (!identical(output, expected)) {
+                            std::cerr << size.width << "x" << size.height << " threads " << threads << " cache "
+                                      << cache_bytes << ": output differs" << std::endl;
+                        }
+                        assert(identical(output, expected));
+                    }
+                }
+            }
+        }
+
+        std::cout << "✅ Serial equivalence test passed" << std::endl;
+    }
+
+    static void test_in_place() {
+        std::cout << "Testing in-place runs..." << std::endl;
+
+        StripConfig config;
+        config.threads = 3;
+        config.cache_bytes = 8192;
+        config.min_strip_rows = 1;
+
+        // One phase with a halo: strips must not read rows a neighbour already overwrote
+        std::vector<StripStage> blur = {
+            StripStage::rows("blur", 2, -1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::GaussianBlur(src, dst, cv::Size(5, 5), 1.5); }),
+            StripStage::rows("blur_again", 2, -1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::GaussianBlur(src, dst, cv::Size(5, 5), 1.5); }),
+        };
+        StripPipeline pipeline(blur, config);
+        cv::Mat frame = sceneImage(200, 150, 7);
+        cv::Mat expected;
+        bool ran = pipeline.runSerial(frame, expected);
+        assert(ran);
+        ran = pipeline.run(frame, frame);
+        assert(ran);
+        assert(identical(frame, expected));
+
+        // The edge chain in place, as process_frame does it
+        StripPipeline chain(edgeChain(), config);
+        frame = sceneImage(320, 240, 11);
+        ran = chain.runSerial(frame, expected);
+        assert(ran);
+        ran = chain.run(frame, frame);
+        assert(ran);
+        assert(identical(frame, expected));
+
+        // Output of another type into the same Mat
+        std::vector<StripStage> gray = {
+            StripStage::rows("gray", 0, CV_8UC1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY); }),
+            StripStage::rows("blur", 2, -1,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::GaussianBlur(src, dst, cv::Size(5, 5), 1.5); }),
+        };
+        StripPipeline to_gray(gray, config);
+        frame = sceneImage(97, 61, 3);
+        ran = to_gray.runSerial(frame, expected);
+        assert(ran);
+        ran = to_gray.run(frame, frame);
+        assert(ran);
+        assert(identical(frame, expected));
+
+        std::cout << "✅ In-place test passed" << std::endl;
+    }
+
+    static void test_strip_rows() {
+        std::cout << "Testing strip sizing..." << std::endl;
+
+        StripConfig config;
+        config.threads = 1;
+        config.cache_bytes = 9600 * 100;   // BGR + gray + blurred rows of 1920 pixels: 9600 bytes
+        StripPipeline pipeline(edgeChain(), config);
+        assert(pipeline.getPhaseCount() == 3);
+        assert(pipeline.computeStripRows(0, cv::Size(1920, 1080), CV_8UC3) == 100);
+
+        // Enough strips for every participant
+        config.threads = 4;
+        config.cache_bytes = 64 << 20;
+        StripPipeline parallel(edgeChain(), config);
+        assert(parallel.getThreadCount() == 4);
+        assert(parallel.computeStripRows(0, cv::Size(1920, 1080), CV_8UC3) == 270);
+
+        // Never below the minimum, never above the frame
+        config.cache_bytes = 1;
+        StripPipeline tiny(edgeChain(), config);
+        assert(tiny.computeStripRows(0, cv::Size(1920, 1080), CV_8UC3) == 16);
+        assert(tiny.computeStripRows(0, cv::Size(1920, 10), CV_8UC3) == 10);
+
+        assert(StripPipeline::l2CacheBytes() > 0);
+
+        std::cout << "✅ Strip sizing test passed" << std::endl;
+    }
+
+    static void test_rejects_bad_input() {
+        std::cout << "Testing invalid input and stages..." << std::endl;
+
+        StripPipeline pipeline(edgeChain(), StripConfig());
+        cv::Mat output;
+        bool ran = pipeline.run(cv::Mat(), output);
+        assert(!ran);
+
+        StripPipeline empty{std::vector<StripStage>(), StripConfig()};
+        ran = empty.run(sceneImage(32, 32, 1), output);
+        assert(!ran);
+
+        // Declares BGR but writes gray
+        std::vector<StripStage> wrong = {
+            StripStage::rows("gray", 1, CV_8UC3,
+                             [](const cv::Mat& src, cv::Mat& dst) { cv::cvtColor(src, dst, cv::COLOR_BGR2GRAY); }),
+        };
+        StripConfig config;
+        config.threads = 2;
+        StripPipeline mismatched(wrong, config);
+        ran = mismatched.run(sceneImage(64, 64, 2), output);
+        assert(!ran);
+
+        std::cout << "✅ Invalid input test passed" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Strip Pipeline Unit Tests" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    StripPipelineTest::test_matches_serial();
+    StripPipelineTest::test_in_place();
+    StripPipelineTest::test_strip_rows();
+    StripPipelineTest::test_rejects_bad_input();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All strip pipeline unit tests passed!" << std::endl;
+    return 0;
+}
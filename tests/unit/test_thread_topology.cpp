@@ -0,0 +1,174 @@
+/**
+ * @file test_thread_topology.cpp
+ * @brief Unit tests for CPU set parsing and per-role thread pinning
+ */
+
+#include "thread_topology.hpp"
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+class ThreadTopologyTest {
+public:
+    static void test_cpu_set_parse() {
+        std::cout << "Testing CPU set parsing..." << std::endl;
+
+        CpuSet set;
+        bool parsed = CpuSet::parse("0-3,8,10-11", set);
+        assert(parsed);
+        assert(set.cpus == std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+        assert(set.toString() == "0-3,8,10-11");
+
+        parsed = CpuSet::parse("5,1,1,2", set);
+        assert(parsed);                                  // Sorted, duplicates removed
+        assert(set.toString() == "1-2,5");
+
+        for (const char* invalid : {"", "a", "3-1", "1,,2", "-1", "1-", "0-", "2x"}) {
+            parsed = CpuSet::parse(invalid, set);
+            assert(!parsed);
+        }
+
+        ThreadRole role;
+        parsed = threadRoleFromString("logger", role);
+        assert(parsed && role == ThreadRole::LOGGER);
+        parsed = threadRoleFromString("gpu", role);
+        assert(!parsed);
+
+        std::cout << "✅ CPU set parse test passed" << std::endl;
+    }
+
+    static void test_register_and_pin() {
+        std::cout << "Testing threads are pinned before and after apply()..." << std::endl;
+
+        ThreadTopology& topology = ThreadTopology::getInstance();
+        std::atomic<bool> started{false};
+        std::atomic<bool> repinned{false};
+        std::atomic<bool> done{false};
+        std::vector<int> before_cpus;
+        std::vector<int> after_cpus;
+
+        // Registered before any configuration: keeps its inherited mask
+        std::thread early([&]() {
+            ScopedThreadRole role(ThreadRole::CAPTURE);
+            before_cpus = currentCpus();
+            started = true;
+            while (!repinned) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            after_cpus = currentCpus();
+            while (!done) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+        while (!started) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        assert(topology.getThreadCount(ThreadRole::CAPTURE) == 1);
+
+        ThreadTopologyConfig config;
+        config.cpus(ThreadRole::CAPTURE).cpus = {0};
+        config.cpus(ThreadRole::WEB).cpus = {0};
+        bool applied = topology.apply(config);
+        repinned = true;
+
+        // Registered after configuration: pinned on start
+        std::vector<int> late_cpus;
+        std::thread late([&]() {
+            ScopedThreadRole role(ThreadRole::WEB);
+            late_cpus = currentCpus();
+        });
+        late.join();
+        done = true;
+        early.join();
+
+        if (ThreadTopology::isPinningSupported()) {
+            assert(applied);
+            assert(before_cpus.size() >= 1);
+            assert(after_cpus == std::vector<int>({0}));
+            assert(late_cpus == std::vector<int>({0}));
+        } else {
+            assert(!applied);
+        }
+        assert(topology.getThreadCount(ThreadRole::CAPTURE) == 0);
+        assert(topology.getThreadCount(ThreadRole::WEB) == 0);
+
+        std::string json = topology.getInfoJson();
+        assert(json.find("\"capture\":{\"cpus\":\"0\",\"threads\":0}") != std::string::npos);
+        assert(json.find("\"inference\":{\"cpus\":\"all\"") != std::string::npos);
+
+        // The fields embed into a larger object exactly as getInfoJson() wraps them
+        std::ostringstream fields;
+        topology.writeInfoFields(fields);
+        assert(!fields.str().empty() && fields.str().front() == '"' && fields.str().back() != ',');
+        assert(json == "{" + fields.str() + "}");
+
+        std::cout << "✅ Register and pin test passed" << std::endl;
+    }
+
+    static void test_unpinned_role_restores_mask() {
+        std::cout << "Testing an emptied role releases its threads..." << std::endl;
+
+        if (!ThreadTopology::isPinningSupported()) {
+            std::cout << "⚠️  Pinning unsupported on this platform, skipped" << std::endl;
+            return;
+        }
+
+        ThreadTopology& topology = ThreadTopology::getInstance();
+        std::vector<int> original = currentCpus();
+        std::atomic<int> phase{0};
+        std::vector<int> pinned_cpus;
+        std::vector<int> released_cpus;
+
+        std::thread worker([&]() {
+            ScopedThreadRole role(ThreadRole::INFERENCE);
+            phase = 1;
+            while (phase < 2) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            pinned_cpus = currentCpus();
+            phase = 3;
+            while (phase < 4) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            released_cpus = currentCpus();
+        });
+        while (phase < 1) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        ThreadTopologyConfig config;
+        config.cpus(ThreadRole::INFERENCE).cpus = {0};
+        bool applied = topology.apply(config);
+        assert(applied);
+        phase = 2;
+        while (phase < 3) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        applied = topology.apply(ThreadTopologyConfig());
+        assert(applied);
+        phase = 4;
+        worker.join();
+
+        assert(pinned_cpus == std::vector<int>({0}));
+        assert(released_cpus == original);
+
+        std::cout << "✅ Release test passed (" << released_cpus.size() << " CPUs)" << std::endl;
+    }
+
+private:
+    static std::vector<int> currentCpus() {
+        std::vector<int> cpus;
+#ifdef __linux__
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        pthread_getaffinity_np(pthread_self(), sizeof(mask), &mask);
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) cpus.push_back(cpu);
+        }
+#endif
+        return cpus;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Thread Topology Unit Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    ThreadTopologyTest::test_cpu_set_parse();
+    ThreadTopologyTest::test_register_and_pin();
+    ThreadTopologyTest::test_unpinned_role_restores_mask();
+
+    std::cout << std::endl;
+    std::cout << "🎉 All thread topology unit tests passed!" << std::endl;
+    return 0;
+}
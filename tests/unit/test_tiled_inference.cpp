@@ -0,0 +1,194 @@
+/**
+ * @file test_tiled_inference.cpp
+ * @brief Unit tests for tiled high-resolution inference
+ */
+
+#include "tiled_inference.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief "Detector" that reports the bounding box of pure blue, green and red pixels in each image
+ *
+ * Output per image is a 3x4 float matrix, one x,y,w,h row per channel
+ * (w = 0 when the colour is absent), so detections depend on what the
+ * tile actually contains.
+ */
+class ColourBoxBackend : public ReferenceBackend {
+public:
+    bool runBatch(const std::vector<cv::Mat>& images, std::vector<cv::Mat>& outputs) override {
+        outputs.clear();
+        for (const auto& image : images) {
+            cv::Mat boxes(3, 4, CV_32F, cv::Scalar(0));
+            for (int channel = 0; channel < 3; ++channel) {
+                int left = image.cols, top = image.rows, right = -1, bottom = -1;
+                for (int y = 0; y < image.rows; ++y) {
+                    for (int x = 0; x < image.cols; ++x) {
+                        const cv::Vec3b& pixel = image.at<cv::Vec3b>(y, x);
+                        if (pixel[channel] == 255 && pixel[(channel + 1) % 3] == 0 && pixel[(channel + 2) % 3] == 0) {
+                            left = std::min(left, x);
+                            top = std::min(top, y);
+                            right = std::max(right, x);
+                            bottom = std::max(bottom, y);
+                        }
+                    }
+                }
+                if (right >= 0) {
+                    boxes.at<float>(channel, 0) = static_cast<float>(left);
+                    boxes.at<float>(channel, 1) = static_cast<float>(top);
+                    boxes.at<float>(channel, 2) = static_cast<float>(right - left + 1);
+                    boxes.at<float>(channel, 3) = static_cast<float>(bottom - top + 1);
+                }
+            }
+            outputs.push_back(boxes);
+        }
+        batches++;
+        return true;
+    }
+
+    int batches = 0;
+};
+
+class TiledInferenceTest {
+public:
+    static std::vector<PipelineRegion> colourBoxes(const std::vector<cv::Mat>& outputs, size_t index, const cv::Size&) {
+        std::vector<PipelineRegion> regions;
+        const cv::Mat& boxes = outputs[index];
+        for (int channel = 0; channel < 3; ++channel) {
+            if (boxes.at<float>(channel, 2) > 0) {
+                PipelineRegion region;
+                region.box = cv::Rect(static_cast<int>(boxes.at<float>(channel, 0)), static_cast<int>(boxes.at<float>(channel, 1)),
+                                      static_cast<int>(boxes.at<float>(channel, 2)), static_cast<int>(boxes.at<float>(channel, 3)));
+                region.class_id = channel;
+                region.score = 0.9f;
+                regions.push_back(region);
+            }
+        }
+        return regions;
+    }
+
+    static void test_tile_layout() {
+        std::cout << "Testing tiles cover the frame with the requested overlap..." << std::endl;
+
+        TilingConfig config;
+        std::vector<cv::Rect> tiles = TiledInference::computeTiles(cv::Size(1920, 1080), config);
+        assert(tiles.size() == 8);  // Columns at 0, 576, 1152, 1280; rows at 0, 440
+        assert(tiles[3] == cv::Rect(1280, 0, 640, 640));
+        assert(tiles[7] == cv::Rect(1280, 440, 640, 640));
+
+        cv::Mat covered(1080, 1920, CV_8U, cv::Scalar(0));
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            assert(tiles[i].size() == cv::Size(640, 640));
+            assert((tiles[i] & cv::Rect(0, 0, 1920, 1080)) == tiles[i]);
+            covered(tiles[i]).setTo(cv::Scalar(1));
+            if (i % 4 != 3) {
+                assert((tiles[i] & tiles[i + 1]).width >= config.overlap);  // Horizontal neighbour
+            }
+        }
+        assert((tiles[0] & tiles[4]).height >= config.overlap);            // Vertical neighbour
+        for (int y = 0; y < covered.rows; ++y) {
+            for (int x = 0; x < covered.cols; ++x) {
+                assert(covered.at<uchar>(y, x) == 1);
+            }
+        }
+
+        // Frames no larger than a tile are one tile of the frame's size
+        tiles = TiledInference::computeTiles(cv::Size(320, 240), config);
+        assert(tiles.size() == 1 && tiles[0] == cv::Rect(0, 0, 320, 240));
+        tiles = TiledInference::computeTiles(cv::Size(640, 640), config);
+        assert(tiles.size() == 1);
+
+        std::cout << "✅ Tile layout test passed" << std::endl;
+    }
+
+    static void test_merge_detections() {
+        std::cout << "Testing class-aware NMS and seam merging..." << std::endl;
+
+        auto region = [](cv::Rect box, int class_id, float score, int source) {
+            PipelineRegion r;
+            r.box = box;
+            r.class_id = class_id;
+            r.score = score;
+            r.source = source;
+            return r;
+        };
+
+        std::vector<PipelineRegion> regions = {
+            region(cv::Rect(0, 0, 100, 100), 0, 0.6f, 0),
+            region(cv::Rect(5, 5, 100, 100), 0, 0.9f, 1),     // Overlaps the first: keeps this one (higher score)
+            region(cv::Rect(5, 5, 100, 100), 1, 0.5f, 1),     // Other class: kept
+            region(cv::Rect(300, 0, 20, 100), 0, 0.8f, 2),    // Cut by a seam...
+            region(cv::Rect(300, 0, 80, 100), 0, 0.7f, 3),    // ...whole in the next tile: one detection, larger box
+            region(cv::Rect(500, 0, 20, 100), 0, 0.8f, 4),    // Small box inside a larger one of the same tile:
+            region(cv::Rect(500, 0, 80, 100), 0, 0.7f, 4),    // two objects, both kept
+        };
+        TiledInference::mergeDetections(regions, 0.5f, 0.8f);
+
+        assert(regions.size() == 5);
+        assert(regions[0].box == cv::Rect(5, 5, 100, 100) && regions[0].class_id == 0);
+        assert(regions[1].box == cv::Rect(300, 0, 80, 100) && regions[1].score == 0.8f);
+        assert(regions[2].box == cv::Rect(500, 0, 20, 100));
+        assert(regions[3].box == cv::Rect(500, 0, 80, 100));
+        assert(regions[4].class_id == 1);
+
+        std::cout << "✅ Merge test passed" << std::endl;
+    }
+
+    /**
+     * @brief Green square inside two tiles, red square cut by a seam, blue square in the corner tile
+     */
+    static void test_frame_coordinates(bool batch_tiles) {
+        std::cout << "Testing detections map back to frame coordinates (" << (batch_tiles ? "batch" : "parallel")
+                  << ")..." << std::endl;
+
+        cv::Mat frame(1080, 1920, CV_8UC3, cv::Scalar(0, 0, 0));
+        frame(cv::Rect(1800, 1000, 40, 40)).setTo(cv::Scalar(255, 0, 0));
+        frame(cv::Rect(600, 100, 40, 40)).setTo(cv::Scalar(0, 255, 0));
+        frame(cv::Rect(1200, 100, 60, 40)).setTo(cv::Scalar(0, 0, 255));
+
+        auto backend = std::make_shared<ColourBoxBackend>();
+        backend->load(ModelConfig());
+        TilingConfig config;
+        config.batch_tiles = batch_tiles;
+        config.max_batch = 3;
+        config.tile_threads = 4;
+        TiledInference tiler(backend, colourBoxes, config);
+
+        std::vector<PipelineRegion> detections;
+        TiledFrameStats stats;
+        bool ran = tiler.run(frame, detections, &stats);
+        assert(ran);
+        assert(stats.tiles == 8);
+        assert(stats.raw_detections == 5);  // Green twice, red whole and partial, blue once
+        assert(stats.detections == 3 && detections.size() == 3);
+        assert(backend->batches == (batch_tiles ? 3 : 8));
+
+        std::vector<cv::Rect> expected = {cv::Rect(1800, 1000, 40, 40), cv::Rect(600, 100, 40, 40), cv::Rect(1200, 100, 60, 40)};
+        for (const auto& detection : detections) {
+            assert(detection.class_id >= 0 && detection.class_id < 3);
+            assert(detection.box == expected[detection.class_id]);
+        }
+
+        std::string json = tiler.getStatsJson();
+        assert(json.find("\"frames\":1,") != std::string::npos);
+        assert(json.find("\"tiles_per_frame\":8.00") != std::string::npos);
+        assert(json.find("\"merge_latency\":{\"count\":1") != std::string::npos);
+
+        std::cout << "✅ Frame coordinate test passed (merge " << stats.merge_ms << " ms)" << std::endl;
+    }
+};
+
+int main() {
+    std::cout << "🧪 Running Tiled Inference Unit Tests" << std::endl;
+    std::cout << "======================================" << std::endl;
+
+    TiledInferenceTest::test_tile_layout();
+    TiledInferenceTest::test_merge_detections();
+    TiledInferenceTest::test_frame_coordinates(true);
+    TiledInferenceTest::test_frame_coordinates(false);
+
+    std::cout << std::endl;
+    std::cout << "🎉 All tiled inference unit tests passed!" << std::endl;
+    return 0;
+}